@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet
+
+import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFIBase58
+import org.junit.Assert.assertArrayEquals
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertFalse
+import org.junit.Assert.assertNull
+import org.junit.Test
+import kotlin.random.Random
+
+/**
+ * Native base58 codec against the Kotlin [Base58String] it replaces on the hot paths.
+ *
+ * @author The Tari Development Team
+ */
+class FFIBase58Tests {
+
+    @Test
+    fun encode_assertThatOutputMatchesKotlin() {
+        val random = Random(58)
+        repeat(1000) {
+            val bytes = random.nextBytes(random.nextInt(80)).also { if (it.size > 2 && random.nextBoolean()) it.fill(0, 0, 2) }
+            assertEquals(Base58String(bytes).base58, FFIBase58.encode(bytes))
+        }
+    }
+
+    @Test
+    fun decodeAll_assertThatInvalidStringsAreNull() {
+        val decoded = FFIBase58.decodeAll(arrayOf("11", "0OIl", Base58String(byteArrayOf(1, 2, 3)).base58))
+        assertArrayEquals(byteArrayOf(0, 0), decoded[0])
+        assertNull(decoded[1])
+        assertArrayEquals(byteArrayOf(1, 2, 3), decoded[2])
+    }
+
+    @Test
+    fun validateAddresses_assertThatGarbageIsRejected() {
+        FFIBase58.validateAddresses(arrayOf("", "not an address", "12")).forEach { assertFalse(it) }
+    }
+
+    @Test
+    fun encodeAddress_assertThatOutputMatchesKotlinAndDecodesBack() {
+        val random = Random(67)
+        val addresses = List(ADDRESS_COUNT) { random.nextBytes(ADDRESS_SIZE).apply { this[0] = NETWORK; this[1] = FEATURES } }
+        val encoded = addresses.map { FFIBase58.encodeAddress(it) }
+        addresses.forEachIndexed { index, bytes ->
+            assertEquals(Base58String(bytes[0]).base58 + Base58String(bytes[1]).base58 + Base58String(bytes.copyOfRange(2, bytes.size)).base58,
+                encoded[index])
+        }
+        val decoded = FFIBase58.decodeAddresses(encoded.toTypedArray())
+        addresses.forEachIndexed { index, bytes -> assertArrayEquals(bytes, decoded[index]) }
+    }
+
+    companion object {
+        const val ADDRESS_COUNT = 1_000
+        const val ADDRESS_SIZE = 67
+        const val NETWORK: Byte = 0x26
+        const val FEATURES: Byte = 3
+    }
+}
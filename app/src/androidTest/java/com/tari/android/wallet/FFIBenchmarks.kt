@@ -0,0 +1,136 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet
+
+import android.util.Log
+import androidx.test.core.app.ApplicationProvider.getApplicationContext
+import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFIBase58
+import com.tari.android.wallet.ffi.FFIByteVector
+import com.tari.android.wallet.ffi.FFIEmojiSet
+import com.tari.android.wallet.ffi.FFISeedWords
+import com.tari.android.wallet.ffi.FFITariTransportConfig
+import com.tari.android.wallet.ffi.FFIWallet
+import org.junit.After
+import org.junit.Test
+import kotlin.random.Random
+
+/**
+ * Timings of the native hot paths, logged under the FFIBenchmarks tag for comparison between builds. They
+ * depend too much on the device to assert on, so the functional tests don't time anything and this class
+ * is left out of [FFITestSuite]; run it on its own.
+ *
+ * @author The Tari Development Team
+ */
+class FFIBenchmarks {
+
+    private val testWallet = FFITestWallet(getApplicationContext())
+
+    // created by the benchmarks that need one
+    private var wallet: FFIWallet? = null
+
+    @After
+    fun teardown() {
+        wallet?.let {
+            it.destroy()
+            testWallet.clean()
+        }
+        wallet = null
+    }
+
+    @Test
+    fun firstCall_reportFirstAndSecondCallLatency() {
+        // natives are bound in JNI_OnLoad, so the first call should not be noticeably slower than the second
+        reportFirstCall("FFIByteVector") { FFIByteVector("Test".toByteArray()).apply { getLength() }.destroy() }
+        reportFirstCall("FFIEmojiSet") { FFIEmojiSet().apply { getLength() }.destroy() }
+        reportFirstCall("FFISeedWords") { FFISeedWords().apply { getLength() }.destroy() }
+        reportFirstCall("FFITariTransportConfig") { FFITariTransportConfig().destroy() }
+    }
+
+    @Test
+    fun getBalance_reportLatencyPerCall() {
+        val wallet = createWallet()
+        // goes through FFIBalance.jniGetAvailable and the other getters, each wrapped in ExecuteWithError
+        reportPerCall("getBalance") { wallet.getBalance() }
+    }
+
+    @Test
+    fun getCachedBalance_reportLatencyPerCall() {
+        val wallet = createWallet()
+        // compare with getBalance, which reads the database
+        reportPerCall("getCachedBalance") { wallet.getCachedBalance() }
+    }
+
+    @Test
+    fun base58_reportKotlinAndNativeTimesFor10kAddresses() {
+        val random = Random(67)
+        val addresses = List(ADDRESS_COUNT) {
+            random.nextBytes(FFIBase58Tests.ADDRESS_SIZE).apply { this[0] = FFIBase58Tests.NETWORK; this[1] = FFIBase58Tests.FEATURES }
+        }
+        val kotlinNanos = measure {
+            addresses.map { Base58String(it[0]).base58 + Base58String(it[1]).base58 + Base58String(it.copyOfRange(2, it.size)).base58 }
+        }
+        var encoded: List<String> = emptyList()
+        val nativeNanos = measure { encoded = addresses.map { FFIBase58.encodeAddress(it) } }
+        val decodeNanos = measure { FFIBase58.decodeAddresses(encoded.toTypedArray()) }
+        Log.i(TAG, "$ADDRESS_COUNT addresses: Kotlin encode ${kotlinNanos / 1000} us, native encode ${nativeNanos / 1000} us, " +
+                "native batch decode ${decodeNanos / 1000} us")
+    }
+
+    private fun createWallet(): FFIWallet = testWallet.create().also { wallet = it }
+
+    private fun reportPerCall(name: String, call: () -> Unit) {
+        repeat(WARM_UP_ITERATIONS) { call() }
+        val nanos = measure { repeat(ITERATIONS) { call() } }
+        Log.i(TAG, "$name: ${nanos / ITERATIONS} ns/call over $ITERATIONS calls")
+    }
+
+    private fun reportFirstCall(className: String, call: () -> Unit) {
+        val firstNanos = measure(call)
+        val secondNanos = measure(call)
+        Log.i(TAG, "$className first call ${firstNanos / 1000} us, second call ${secondNanos / 1000} us")
+    }
+
+    private fun measure(call: () -> Unit): Long {
+        val start = System.nanoTime()
+        call()
+        return System.nanoTime() - start
+    }
+
+    private companion object {
+        const val TAG = "FFIBenchmarks"
+        const val WARM_UP_ITERATIONS = 1_000
+        const val ITERATIONS = 10_000
+        const val ADDRESS_COUNT = 10_000
+    }
+}
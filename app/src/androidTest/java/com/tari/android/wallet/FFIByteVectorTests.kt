@@ -34,7 +34,9 @@ package com.tari.android.wallet
 
 import com.tari.android.wallet.ffi.FFIByteVector
 import org.junit.Assert.assertArrayEquals
+import org.junit.Assert.assertEquals
 import org.junit.Test
+import java.nio.ByteBuffer
 
 /**
  * FFI byte vector tests.
@@ -50,4 +52,23 @@ class FFIByteVectorTests {
         assertArrayEquals(byteArray, byteVector.byteArray())
         byteVector.destroy()
     }
+
+    @Test
+    fun directBuffer_assertThatOnlyTheRemainingBytesAreCopied() {
+        val buffer = ByteBuffer.allocateDirect(8)
+        buffer.put(byteArrayOf(0, 1, 2, 3, 4, 5, 6, 7))
+        buffer.position(2).limit(6)
+        val byteVector = FFIByteVector(buffer)
+        assertArrayEquals(byteArrayOf(2, 3, 4, 5), byteVector.byteArray())
+        assertEquals(2, buffer.position())
+        byteVector.destroy()
+    }
+
+    @Test
+    fun heapBuffer_assertThatTheBytesMatchTheDirectBufferPath() {
+        val bytes = ByteArray(67) { it.toByte() }
+        val byteVector = FFIByteVector(ByteBuffer.wrap(bytes))
+        assertArrayEquals(bytes, byteVector.byteArray())
+        byteVector.destroy()
+    }
 }
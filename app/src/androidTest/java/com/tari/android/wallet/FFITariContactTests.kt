@@ -59,6 +59,17 @@ class FFITariContactTests {
         ffiTariWalletAddress.destroy()
     }
 
+    @Test
+    fun getAlias_assertThatNonAsciiAliasSurvivesTheRoundTrip() {
+        val ffiTariWalletAddress = FFITariWalletAddress(Base58String(FFITestUtil.WALLET_ADDRESS_HEX_STRING))
+        // accented letters, a BMP symbol and an emoji outside the BMP, each a different UTF-8 length
+        val alias = "Zoë € \uD83D\uDC22 " + FFITestUtil.generateRandomAlphanumericString(32)
+        val contact = FFIContact(alias, ffiTariWalletAddress)
+        assertEquals(alias, contact.getAlias())
+        contact.destroy()
+        ffiTariWalletAddress.destroy()
+    }
+
     @Test
     fun getPublicKey_assertThatContactPublicKeyIsEqualToTheGivenPublicKeyHexString() {
         val ffiTariWalletAddress = FFITariWalletAddress(Base58String(FFITestUtil.WALLET_ADDRESS_HEX_STRING))
@@ -42,6 +42,7 @@ import org.junit.runners.Suite
  */
 @RunWith(Suite::class)
 @Suite.SuiteClasses(
+    FFIBase58Tests::class,
     FFIByteVectorTests::class,
     FFICommsConfigTests::class,
     FFITariContactTests::class,
@@ -49,6 +50,7 @@ import org.junit.runners.Suite
     FFITransportTypeTest::class,
     HexStringTests::class,
     NetAddressStringTests::class,
-    FFIWalletTests::class
+    FFIWalletTests::class,
+    FFINativeBindingTests::class
 )
 class FFITestSuite
@@ -55,6 +55,20 @@ class FFITestUtil {
             return (1..len).map { characters.random() }.joinToString("")
         }
 
+        /**
+         * Polls condition until it holds or the timeout passes, returns its last value.
+         */
+        fun waitFor(timeoutMillis: Long = 5_000, condition: () -> Boolean): Boolean {
+            val deadline = System.currentTimeMillis() + timeoutMillis
+            while (!condition()) {
+                if (System.currentTimeMillis() >= deadline) {
+                    return false
+                }
+                Thread.sleep(20)
+            }
+            return true
+        }
+
         fun clearTestFiles(path: String): Boolean {
             val fileDirectory = File(path)
             val del = fileDirectory.deleteRecursively()
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet
+
+import android.content.Context
+import com.tari.android.wallet.data.sharedPrefs.CorePrefRepository
+import com.tari.android.wallet.data.sharedPrefs.addressPoisoning.AddressPoisoningPrefRepository
+import com.tari.android.wallet.data.sharedPrefs.backup.BackupPrefRepository
+import com.tari.android.wallet.data.sharedPrefs.baseNode.BaseNodePrefRepository
+import com.tari.android.wallet.data.sharedPrefs.chat.ChatsPrefRepository
+import com.tari.android.wallet.data.sharedPrefs.network.NetworkPrefRepositoryImpl
+import com.tari.android.wallet.data.sharedPrefs.security.SecurityPrefRepository
+import com.tari.android.wallet.data.sharedPrefs.securityStages.SecurityStagesPrefRepository
+import com.tari.android.wallet.data.sharedPrefs.sentry.SentryPrefRepository
+import com.tari.android.wallet.data.sharedPrefs.tariSettings.TariSettingsPrefRepository
+import com.tari.android.wallet.data.sharedPrefs.tor.TorPrefRepository
+import com.tari.android.wallet.data.sharedPrefs.yat.YatPrefRepository
+import com.tari.android.wallet.di.ApplicationModule
+import com.tari.android.wallet.ffi.FFICommsConfig
+import com.tari.android.wallet.ffi.FFITariTransportConfig
+import com.tari.android.wallet.ffi.FFIWallet
+import com.tari.android.wallet.service.seedPhrase.SeedPhraseRepository
+import com.tari.android.wallet.util.Constants
+import java.io.File
+
+/**
+ * Test wallet on memory transport in the app's files directory, with the preference repositories it needs.
+ *
+ * @author The Tari Development Team
+ */
+class FFITestWallet(context: Context) {
+
+    private val prefs = context.getSharedPreferences(ApplicationModule.sharedPrefsFileName, Context.MODE_PRIVATE)
+    private val networkRepository = NetworkPrefRepositoryImpl(prefs)
+    private val baseNodeSharedPrefsRepository = BaseNodePrefRepository(prefs, networkRepository)
+    private val backupSettingsRepository = BackupPrefRepository(context, prefs, networkRepository)
+    private val yatSharedPrefsRepository = YatPrefRepository(prefs, networkRepository)
+    private val tariSettingsRepository = TariSettingsPrefRepository(prefs, networkRepository)
+    private val securityStagesRepository = SecurityStagesPrefRepository(prefs, networkRepository)
+    private val sentryPrefRepository: SentryPrefRepository = SentryPrefRepository(prefs, networkRepository)
+    private val torSharedRepository = TorPrefRepository(prefs, networkRepository)
+    private val securityPrefRepository = SecurityPrefRepository(context, prefs, networkRepository)
+    private val addressPoisoningSharedRepository = AddressPoisoningPrefRepository(prefs, networkRepository)
+    private val chatPrefRepository = ChatsPrefRepository(prefs, networkRepository)
+
+    private val sharedPrefsRepository = CorePrefRepository(
+        sharedPrefs = prefs,
+        networkRepository = networkRepository,
+        backupSettingsRepository = backupSettingsRepository,
+        baseNodeSharedRepository = baseNodeSharedPrefsRepository,
+        yatSharedRepository = yatSharedPrefsRepository,
+        torSharedRepository = torSharedRepository,
+        tariSettingsSharedRepository = tariSettingsRepository,
+        securityStagesRepository = securityStagesRepository,
+        sentryPrefRepository = sentryPrefRepository,
+        securityPrefRepository = securityPrefRepository,
+        addressPoisoningSharedRepository = addressPoisoningSharedRepository,
+        chatPrefRepository = chatPrefRepository,
+    )
+
+    private val walletDirPath = context.filesDir.absolutePath
+
+    /**
+     * Removes the wallet files and preferences.
+     */
+    fun clean() {
+        val clean = FFITestUtil.clearTestFiles(walletDirPath)
+        sharedPrefsRepository.clear()
+        if (!clean) {
+            throw RuntimeException("Test files could not cleared.")
+        }
+    }
+
+    /**
+     * Cleans up after any earlier wallet and creates a new one.
+     */
+    fun create(): FFIWallet {
+        // clean any existing wallet data
+        clean()
+        // create memory transport
+        val transport = FFITariTransportConfig()
+        // create comms config
+        val commsConfig = FFICommsConfig(
+            transport.getAddress(),
+            transport,
+            FFITestUtil.WALLET_DB_NAME,
+            walletDirPath,
+            Constants.Wallet.DISCOVERY_TIMEOUT_SEC,
+            Constants.Wallet.STORE_AND_FORWARD_MESSAGE_DURATION_SEC,
+        )
+        val logFile = File(walletDirPath, "test_log.log")
+        // create wallet instance
+        val wallet =
+            FFIWallet(sharedPrefsRepository, securityPrefRepository, SeedPhraseRepository(), networkRepository, commsConfig, logFile.absolutePath)
+        commsConfig.destroy()
+        transport.destroy()
+        return wallet
+    }
+}
@@ -33,10 +33,14 @@
 package com.tari.android.wallet
 
 import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFIEmojiIdCache
 import com.tari.android.wallet.ffi.FFITariWalletAddress
 import com.tari.android.wallet.ffi.nullptr
+import org.junit.Assert.assertArrayEquals
 import org.junit.Assert.assertEquals
 import org.junit.Assert.assertNotEquals
+import org.junit.Assert.assertNull
+import org.junit.Assert.assertTrue
 import org.junit.Test
 
 /**
@@ -71,4 +75,33 @@ class FFIWalletAddressTests {
         origin.destroy()
     }
 
+    @Test
+    fun decompose_assertThatThePartsMatchTheSingleGetters() {
+        val ffiTariWalletAddress = FFITariWalletAddress(FFITestUtil.WALLET_EMOJI_ID)
+        val parts = ffiTariWalletAddress.decompose()
+        assertEquals(ffiTariWalletAddress.getNetwork(), parts.network)
+        assertEquals(ffiTariWalletAddress.getFeatures(), parts.features)
+        assertEquals(ffiTariWalletAddress.getChecksum(), parts.checksum)
+        assertEquals(ffiTariWalletAddress.getEmojiId(), parts.emojiId)
+        assertArrayEquals(ffiTariWalletAddress.getByteVector().byteArray(), parts.bytes)
+        assertEquals(ffiTariWalletAddress.getSpendKey().getEmojiId(), parts.spendKeyEmojis)
+        ffiTariWalletAddress.destroy()
+    }
+
+    @Test
+    fun emojiIdCache_assertThatRepeatedLookupsAreHits() {
+        val ffiTariWalletAddress = FFITariWalletAddress(FFITestUtil.WALLET_EMOJI_ID)
+        val first = ffiTariWalletAddress.getEmojiId()
+        val before = FFIEmojiIdCache.getStats()
+        val second = ffiTariWalletAddress.getEmojiId()
+        val after = FFIEmojiIdCache.getStats()
+        assertEquals(first, second)
+        assertTrue(after.hits > before.hits)
+        assertEquals(before.misses, after.misses)
+
+        val emojiIds = FFIEmojiIdCache.getEmojiIds(listOf(ffiTariWalletAddress.getByteVector().byteArray(), byteArrayOf(1, 2, 3)))
+        assertEquals(first, emojiIds[0])
+        assertNull(emojiIds[1])
+        ffiTariWalletAddress.destroy()
+    }
 }
@@ -37,128 +37,67 @@
  */
 package com.tari.android.wallet
 
-import android.content.Context
 import androidx.test.core.app.ApplicationProvider.getApplicationContext
 import androidx.test.ext.junit.runners.AndroidJUnit4
-import com.tari.android.wallet.data.sharedPrefs.CorePrefRepository
-import com.tari.android.wallet.data.sharedPrefs.addressPoisoning.AddressPoisoningPrefRepository
-import com.tari.android.wallet.data.sharedPrefs.backup.BackupPrefRepository
-import com.tari.android.wallet.data.sharedPrefs.baseNode.BaseNodePrefRepository
-import com.tari.android.wallet.data.sharedPrefs.chat.ChatsPrefRepository
-import com.tari.android.wallet.data.sharedPrefs.network.NetworkPrefRepositoryImpl
-import com.tari.android.wallet.data.sharedPrefs.security.SecurityPrefRepository
-import com.tari.android.wallet.data.sharedPrefs.securityStages.SecurityStagesPrefRepository
-import com.tari.android.wallet.data.sharedPrefs.sentry.SentryPrefRepository
-import com.tari.android.wallet.data.sharedPrefs.tariSettings.TariSettingsPrefRepository
-import com.tari.android.wallet.data.sharedPrefs.tor.TorPrefRepository
-import com.tari.android.wallet.data.sharedPrefs.yat.YatPrefRepository
-import com.tari.android.wallet.di.ApplicationModule
-import com.tari.android.wallet.ffi.FFICommsConfig
 import com.tari.android.wallet.ffi.FFIContact
 import com.tari.android.wallet.ffi.FFIEmojiSet
 import com.tari.android.wallet.ffi.FFIException
 import com.tari.android.wallet.ffi.FFITariBaseNodeState
-import com.tari.android.wallet.ffi.FFITariTransportConfig
 import com.tari.android.wallet.ffi.FFIWallet
 import com.tari.android.wallet.ffi.FFIWalletListener
+import com.tari.android.wallet.ffi.FFIWalletTestHooks
 import com.tari.android.wallet.ffi.TransactionValidationStatus
+import com.tari.android.wallet.ffi.WalletEventQueueStats
+import com.tari.android.wallet.ffi.WalletEventType
+import com.tari.android.wallet.ffi.nativeErrorExceptions
 import com.tari.android.wallet.ffi.nullptr
+import com.tari.android.wallet.ffi.runWithDestroy
+import com.tari.android.wallet.ffi.walletEventCoalescingWindowMillis
 import com.tari.android.wallet.model.BalanceInfo
 import com.tari.android.wallet.model.CancelledTx
 import com.tari.android.wallet.model.CompletedTx
 import com.tari.android.wallet.model.PendingInboundTx
 import com.tari.android.wallet.model.PendingOutboundTx
+import com.tari.android.wallet.model.TariWalletAddress
 import com.tari.android.wallet.model.TransactionSendStatus
+import com.tari.android.wallet.model.WalletError
 import com.tari.android.wallet.model.recovery.WalletRestorationResult
-import com.tari.android.wallet.service.seedPhrase.SeedPhraseRepository
-import com.tari.android.wallet.util.Constants
 import org.junit.After
 import org.junit.Assert.assertEquals
 import org.junit.Assert.assertNotEquals
+import org.junit.Assert.assertNull
 import org.junit.Assert.assertTrue
 import org.junit.Before
 import org.junit.Test
 import org.junit.runner.RunWith
-import java.io.File
 import java.math.BigInteger
+import java.util.concurrent.CopyOnWriteArrayList
 
 @RunWith(AndroidJUnit4::class)
 class FFIWalletTests {
 
     private lateinit var wallet: FFIWallet
     private lateinit var listener: TestAddRecipientAddNodeListener
-    private val context = getApplicationContext<Context>()
-    private val prefs = context.getSharedPreferences(ApplicationModule.sharedPrefsFileName, Context.MODE_PRIVATE)
-    private val networkRepository = NetworkPrefRepositoryImpl(prefs)
-    private val baseNodeSharedPrefsRepository = BaseNodePrefRepository(prefs, networkRepository)
-    private val backupSettingsRepository = BackupPrefRepository(context, prefs, networkRepository)
-    private val yatSharedPrefsRepository = YatPrefRepository(prefs, networkRepository)
-    private val tariSettingsRepository = TariSettingsPrefRepository(prefs, networkRepository)
-    private val securityStagesRepository = SecurityStagesPrefRepository(prefs, networkRepository)
-    private val sentryPrefRepository: SentryPrefRepository = SentryPrefRepository(prefs, networkRepository)
-    private val torSharedRepository = TorPrefRepository(prefs, networkRepository)
-    private val securityPrefRepository = SecurityPrefRepository(context, prefs, networkRepository)
-    private val addressPoisoningSharedRepository = AddressPoisoningPrefRepository(prefs, networkRepository)
-    private val chatPrefRepository = ChatsPrefRepository(prefs, networkRepository)
-
-    private val sharedPrefsRepository = CorePrefRepository(
-        sharedPrefs = prefs,
-        networkRepository = networkRepository,
-        backupSettingsRepository = backupSettingsRepository,
-        baseNodeSharedRepository = baseNodeSharedPrefsRepository,
-        yatSharedRepository = yatSharedPrefsRepository,
-        torSharedRepository = torSharedRepository,
-        tariSettingsSharedRepository = tariSettingsRepository,
-        securityStagesRepository = securityStagesRepository,
-        sentryPrefRepository = sentryPrefRepository,
-        securityPrefRepository = securityPrefRepository,
-        addressPoisoningSharedRepository = addressPoisoningSharedRepository,
-        chatPrefRepository = chatPrefRepository,
-    )
-
-    private val walletDirPath = context.filesDir.absolutePath
-
-    private fun clean() {
-        val clean = FFITestUtil.clearTestFiles(walletDirPath)
-        sharedPrefsRepository.clear()
-        if (!clean) {
-            throw RuntimeException("Test files could not cleared.")
-        }
-    }
+    private val testWallet = FFITestWallet(getApplicationContext())
 
     @Before
     fun setup() {
-        // clean any existing wallet data
-        clean()
-        // create memory transport
-        val transport = FFITariTransportConfig()
-        // create comms config
-        val commsConfig = FFICommsConfig(
-            transport.getAddress(),
-            transport,
-            FFITestUtil.WALLET_DB_NAME,
-            walletDirPath,
-            Constants.Wallet.DISCOVERY_TIMEOUT_SEC,
-            Constants.Wallet.STORE_AND_FORWARD_MESSAGE_DURATION_SEC,
-        )
-        val logFile = File(walletDirPath, "test_log.log")
-        // create wallet instance
-        wallet =
-            FFIWallet(sharedPrefsRepository, securityPrefRepository, SeedPhraseRepository(), networkRepository, commsConfig, logFile.absolutePath)
+        wallet = testWallet.create()
         // create listener
         listener = TestAddRecipientAddNodeListener()
         wallet.listener = listener
-        commsConfig.destroy()
-        transport.destroy()
     }
 
     @After
     fun teardown() {
         // destroy wallet
         wallet.listener = null
-        wallet.destroy()
+        // some tests destroy the wallet themselves
+        if (wallet.pointer != nullptr) {
+            wallet.destroy()
+        }
         // clean wallet folder
-        clean()
+        testWallet.clean()
     }
 
     @Test
@@ -214,6 +153,30 @@ class FFIWalletTests {
         contacts.destroy()
     }
 
+    @Test
+    fun testContactIndex() {
+        val contacts = wallet.getContacts()
+        val contactCount = contacts.getLength()
+        val firstContact = contacts.getAt(0)
+        val ffiWalletAddress = firstContact.getWalletAddress()
+        val address = TariWalletAddress(ffiWalletAddress)
+        assertEquals(firstContact.getAlias(), wallet.findContact(address)?.alias)
+        // the index follows upserts
+        val newAlias = FFITestUtil.generateRandomAlphanumericString(7)
+        val updatedContact = FFIContact(newAlias, ffiWalletAddress, isFavorite = true)
+        wallet.addUpdateContact(updatedContact)
+        assertEquals(newAlias, wallet.findContact(address)?.alias)
+        assertEquals(true, wallet.findContact(address)?.isFavorite)
+        // and removals
+        assertTrue(wallet.removeContact(address))
+        assertEquals(null, wallet.findContact(address))
+        wallet.getContacts().runWithDestroy { assertEquals(contactCount - 1, it.getLength()) }
+        updatedContact.destroy()
+        ffiWalletAddress.destroy()
+        firstContact.destroy()
+        contacts.destroy()
+    }
+
     @Test
     fun testSeedWords() {
         val seedWords = wallet.getSeedWords()
@@ -254,6 +217,89 @@ class FFIWalletTests {
         assertTrue(wallet.removeKeyValue(key))
     }
 
+    @Test
+    fun setKeyValues_assertThatReadsSeeTheWritesBeforeAndAfterTheCommit() {
+        val values = mapOf("test_batch_1" to "one", "test_batch_2" to "⛵️🚿")
+        wallet.setKeyValues(values)
+        assertEquals(values + ("test_batch_missing" to null), wallet.getKeyValues(values.keys.toList() + "test_batch_missing"))
+        wallet.commitKeyValues()
+        assertEquals("one", wallet.getKeyValue("test_batch_1"))
+        values.keys.forEach { assertTrue(wallet.removeKeyValue(it)) }
+        assertEquals(mapOf("test_batch_1" to null), wallet.getKeyValues(listOf("test_batch_1")))
+    }
+
+    @Test
+    fun coalescedEvents_assertThatOnlyTheNewestOfEachTypeIsDeliveredAfterTheWindow() {
+        assertTrue(walletEventCoalescingWindowMillis > 0)
+        val before = settledEventQueueStats()
+        (1..5).forEach { FFIWalletTestHooks.runCallback(wallet, WalletEventType.WALLET_SCANNED_HEIGHT, it.toLong()) }
+        // each carries a balance object, the superseded ones are freed natively
+        repeat(3) { FFIWalletTestHooks.runCallback(wallet, WalletEventType.BALANCE_UPDATED) }
+        assertTrue(FFITestUtil.waitFor { listener.scannedHeights.isNotEmpty() && listener.balanceUpdates.isNotEmpty() })
+        val after = settledEventQueueStats()
+        assertEquals(listOf(5), listener.scannedHeights)
+        assertEquals(listOf(wallet.getBalance()), listener.balanceUpdates)
+        assertEquals(8, after.enqueued - before.enqueued)
+        assertEquals(6, after.coalesced - before.coalesced)
+        assertEquals(2, after.delivered - before.delivered)
+    }
+
+    @Test
+    fun coalescedEvents_assertThatHeldBackEventsAreFlushedOnDestroyWithoutReachingTheListener() {
+        assertTrue(walletEventCoalescingWindowMillis > 0)
+        val before = settledEventQueueStats()
+        (1..3).forEach { FFIWalletTestHooks.runCallback(wallet, WalletEventType.WALLET_SCANNED_HEIGHT, it.toLong()) }
+        // well within the window, stopping the dispatcher has to flush the newest one instead of leaking it
+        wallet.destroy()
+        val after = wallet.getEventQueueStats()
+        assertEquals(3, after.enqueued - before.enqueued)
+        assertEquals(2, after.coalesced - before.coalesced)
+        assertEquals(1, after.delivered - before.delivered)
+        // destroy detaches the listener before the dispatcher stops, so the flushed event is dropped in Kotlin
+        assertTrue(listener.scannedHeights.isEmpty())
+    }
+
+    @Test
+    fun getCachedBalance_assertThatItMatchesTheDatabase() {
+        assertEquals(wallet.getBalance(), wallet.getCachedBalance())
+    }
+
+    @Test
+    fun getCachedBalance_assertThatItFollowsTheBalanceCallback() {
+        FFIWalletTestHooks.runCallback(wallet, WalletEventType.BALANCE_UPDATED)
+        assertTrue(FFITestUtil.waitFor { listener.balanceUpdates.isNotEmpty() })
+        assertEquals(listener.balanceUpdates.last(), wallet.getCachedBalance())
+        assertEquals(wallet.getBalance(), wallet.getCachedBalance())
+    }
+
+    @Test
+    fun estimateTxFee_assertThatARepeatedEstimateIsMemoisedUntilTheBalanceIsUpdated() {
+        // an empty wallet still gets an estimate, priced for one input and change
+        val estimate = { wallet.estimateTxFee(BigInteger.valueOf(1_000_000), BigInteger.valueOf(5), BigInteger.ONE, BigInteger.ONE) }
+        settledEventQueueStats()
+        val before = wallet.getFeeEstimateCacheStats()
+        val fee = estimate()
+        assertEquals(fee, estimate())
+        val memoised = wallet.getFeeEstimateCacheStats()
+        assertEquals(1, memoised.misses - before.misses)
+        assertEquals(1, memoised.hits - before.hits)
+
+        FFIWalletTestHooks.runCallback(wallet, WalletEventType.BALANCE_UPDATED)
+        val invalidated = wallet.getFeeEstimateCacheStats()
+        assertEquals(1, invalidated.invalidations - memoised.invalidations)
+        assertEquals(0, invalidated.size)
+        assertEquals(fee, estimate())
+        val after = wallet.getFeeEstimateCacheStats()
+        assertEquals(1, after.misses - invalidated.misses)
+        assertEquals(0, after.hits - invalidated.hits)
+    }
+
+    @Test
+    fun getIndexedTx_assertThatTheIndexMatchesTheDatabase() {
+        assertNull(wallet.getIndexedTx(BigInteger.valueOf(Long.MAX_VALUE)))
+        assertEquals(0, wallet.checkTxIndex())
+    }
+
     @Test(expected = FFIException::class)
     fun testKeyValueStorageBadAccess() {
         val key = "test_key"
@@ -263,6 +309,36 @@ class FFIWalletTests {
         wallet.getKeyValue(key)
     }
 
+    @Test
+    fun testErrorCodeIsTheSameInBothErrorModes() {
+        val key = "test_key"
+        val codes = listOf(true, false).map { nativeExceptions ->
+            nativeErrorExceptions = nativeExceptions
+            try {
+                wallet.getKeyValue(key)
+                WalletError.NoError.code
+            } catch (e: FFIException) {
+                e.error?.code ?: WalletError.UnknownError.code
+            } finally {
+                nativeErrorExceptions = true
+            }
+        }
+        assertNotEquals(WalletError.NoError.code, codes[0])
+        assertEquals(codes[0], codes[1])
+    }
+
+    // queue stats once nothing is queued or held back anymore
+    private fun settledEventQueueStats(): WalletEventQueueStats {
+        var stats = wallet.getEventQueueStats()
+        assertTrue(FFITestUtil.waitFor {
+            Thread.sleep(walletEventCoalescingWindowMillis + 50L)
+            val previous = stats
+            stats = wallet.getEventQueueStats()
+            stats == previous
+        })
+        return stats
+    }
+
     private class TestAddRecipientAddNodeListener : FFIWalletListener {
 
         val receivedTxs = mutableListOf<PendingInboundTx>()
@@ -272,6 +348,8 @@ class FFIWalletTests {
         val cancelledTxs = mutableListOf<CancelledTx>()
         val inboundBroadcastTxs = mutableListOf<PendingInboundTx>()
         val outboundBroadcastTxs = mutableListOf<PendingOutboundTx>()
+        val scannedHeights = CopyOnWriteArrayList<Int>()
+        val balanceUpdates = CopyOnWriteArrayList<BalanceInfo>()
 
         override fun onTxReceived(pendingInboundTx: PendingInboundTx) {
             receivedTxs.add(pendingInboundTx)
@@ -323,7 +401,13 @@ class FFIWalletTests {
 
         override fun onConnectivityStatus(status: Int) = Unit
 
-        override fun onBalanceUpdated(balanceInfo: BalanceInfo) = Unit
+        override fun onBalanceUpdated(balanceInfo: BalanceInfo) {
+            balanceUpdates.add(balanceInfo)
+        }
+
+        override fun onWalletScannedHeight(height: Int) {
+            scannedHeights.add(height)
+        }
 
         override fun onTxValidationComplete(responseId: BigInteger, status: TransactionValidationStatus) = Unit
     }
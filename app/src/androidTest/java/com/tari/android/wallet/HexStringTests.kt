@@ -1,7 +1,12 @@
 package com.tari.android.wallet
 
+import com.tari.android.wallet.ffi.FFIByteVector
+import com.tari.android.wallet.ffi.FFIHex
 import com.tari.android.wallet.ffi.HexString
+import com.tari.android.wallet.ffi.runWithDestroy
+import org.junit.Assert.assertArrayEquals
 import org.junit.Assert.assertEquals
+import org.junit.Assert.assertNull
 import org.junit.Test
 
 class HexStringTests {
@@ -13,4 +18,34 @@ class HexStringTests {
             HexString(FFITestUtil.WALLET_ADDRESS_HEX_STRING).hex
         )
     }
+
+    @Test
+    fun byteVector_assertThatHexIsUppercase() {
+        val hex = FFIByteVector(byteArrayOf(0x00, 0x1F, 0xAB.toByte())).runWithDestroy { HexString(it).hex }
+        assertEquals("001FAB", hex)
+    }
+
+    @Test
+    fun encodeAll_assertThatEveryRecordIsEncoded() {
+        // 40 bytes per record, so both the vector loop and the scalar tail run
+        val bytes = ByteArray(80) { it.toByte() }
+        val hex = FFIHex.encodeAll(bytes, 40)
+        assertEquals(2, hex.size)
+        assertEquals((0 until 40).joinToString("") { "%02x".format(it) }, hex[0])
+        assertArrayEquals(bytes, FFIHex.decodeAll(hex, 40))
+    }
+
+    @Test
+    fun decodeAll_assertThatEitherCaseIsAccepted() {
+        val decoded = FFIHex.decodeAll(arrayOf("AB".repeat(32), "cd".repeat(32)), 32)!!
+        assertEquals(0xAB.toByte(), decoded[0])
+        assertEquals(0xCD.toByte(), decoded[63])
+    }
+
+    @Test
+    fun decodeAll_assertThatMalformedHexIsRejected() {
+        assertNull(FFIHex.decodeAll(arrayOf("abcd"), 32))
+        assertNull(FFIHex.decodeAll(arrayOf("zz".repeat(32)), 32))
+        assertNull(FFIHex.decode("abc"))
+    }
 }
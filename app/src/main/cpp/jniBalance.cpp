@@ -41,7 +41,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIBalance_jniGetAvailable(
         JNIEnv *jEnv,
         jobject jThis,
@@ -53,7 +53,19 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetAvailable(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIBalance_jniGetAvailableU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pBalance = GetPointerField<TariBalance *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(balance_get_available(pBalance, errorPointer));
+    });
+}
+
+extern "C"
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIBalance_jniGetIncoming(
         JNIEnv *jEnv,
         jobject jThis,
@@ -65,7 +77,19 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetIncoming(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIBalance_jniGetIncomingU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pBalance = GetPointerField<TariBalance *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(balance_get_pending_incoming(pBalance, errorPointer));
+    });
+}
+
+extern "C"
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIBalance_jniGetOutgoing(
         JNIEnv *jEnv,
         jobject jThis,
@@ -77,7 +101,19 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetOutgoing(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIBalance_jniGetOutgoingU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pBalance = GetPointerField<TariBalance *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(balance_get_pending_outgoing(pBalance, errorPointer));
+    });
+}
+
+extern "C"
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIBalance_jniGetTimeLocked(
         JNIEnv *jEnv,
         jobject jThis,
@@ -89,8 +125,36 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetTimeLocked(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIBalance_jniGetTimeLockedU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pBalance = GetPointerField<TariBalance *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(balance_get_time_locked(pBalance, errorPointer));
+    });
+}
+
+extern "C"
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIBalance_jniDestroy(JNIEnv *jEnv, jobject jThis) {
     balance_destroy(GetPointerField<TariBalance *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
 }
+
+static const JNINativeMethod ffiBalanceMethods[] = {
+        NATIVE_METHOD(FFIBalance, jniGetAvailable, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIBalance, jniGetAvailableU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIBalance, jniGetIncoming, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIBalance, jniGetIncomingU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIBalance, jniGetOutgoing, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIBalance, jniGetOutgoingU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIBalance, jniGetTimeLocked, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIBalance, jniGetTimeLockedU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIBalance, jniDestroy, "()V"),
+};
+
+jint RegisterBalanceNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIBalance"), ffiBalanceMethods, NELEM(ffiBalanceMethods));
+}
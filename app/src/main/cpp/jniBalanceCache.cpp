@@ -0,0 +1,132 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <wallet.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include "jniCommon.cpp"
+#include "jniBalanceCache.h"
+
+// Writers serialise on the mutex and make the sequence odd for the duration of a write. A reader
+// that saw the same even sequence before and after copying the values has a consistent copy. The
+// values are relaxed atomics so the copy that gets thrown away is not a data race.
+static std::mutex balanceWriteMutex;
+static std::atomic<uint32_t> balanceSequence(0);
+static std::atomic<uint64_t> balanceValues[CachedBalanceValueCount];
+static std::atomic<bool> balanceCached(false);
+
+// call with balanceWriteMutex held
+static void WriteBalance(const unsigned long long *values, bool cached) {
+    uint32_t sequence = balanceSequence.load(std::memory_order_relaxed);
+    balanceSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < CachedBalanceValueCount; i++) {
+        balanceValues[i].store(values[i], std::memory_order_relaxed);
+    }
+    balanceCached.store(cached, std::memory_order_relaxed);
+    balanceSequence.store(sequence + 2, std::memory_order_release);
+}
+
+// returns whether a balance is cached, and the sequence the copy was taken at
+static bool ReadBalance(unsigned long long *values, uint32_t *pSequence) {
+    for (;;) {
+        uint32_t before = balanceSequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0) {
+            continue;
+        }
+        for (int i = 0; i < CachedBalanceValueCount; i++) {
+            values[i] = balanceValues[i].load(std::memory_order_relaxed);
+        }
+        bool cached = balanceCached.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (balanceSequence.load(std::memory_order_relaxed) == before) {
+            *pSequence = before;
+            return cached;
+        }
+    }
+}
+
+static bool ReadBalanceValues(TariBalance *pBalance, unsigned long long *values, int *errorPointer) {
+    values[0] = balance_get_available(pBalance, errorPointer);
+    if (*errorPointer == 0) {
+        values[1] = balance_get_pending_incoming(pBalance, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        values[2] = balance_get_pending_outgoing(pBalance, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        values[3] = balance_get_time_locked(pBalance, errorPointer);
+    }
+    return *errorPointer == 0;
+}
+
+void UpdateCachedBalance(TariBalance *pBalance) {
+    int error = 0;
+    unsigned long long values[CachedBalanceValueCount];
+    if (pBalance == nullptr || !ReadBalanceValues(pBalance, values, &error)) {
+        LOGE("Balance update could not be read (%d), cached balance dropped.", error);
+        ClearCachedBalance();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(balanceWriteMutex);
+    WriteBalance(values, true);
+}
+
+bool GetCachedBalance(TariWallet *pWallet, unsigned long long *values, int *errorPointer) {
+    uint32_t sequence;
+    if (ReadBalance(values, &sequence)) {
+        return true;
+    }
+    TariBalance *pBalance = wallet_get_balance(pWallet, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    bool read = ReadBalanceValues(pBalance, values, errorPointer);
+    balance_destroy(pBalance);
+    if (!read) {
+        return false;
+    }
+    // a callback that came in while the database was read has the newer balance
+    std::lock_guard<std::mutex> lock(balanceWriteMutex);
+    if (balanceSequence.load(std::memory_order_relaxed) == sequence) {
+        WriteBalance(values, true);
+    }
+    return true;
+}
+
+void ClearCachedBalance() {
+    const unsigned long long zeros[CachedBalanceValueCount] = {};
+    std::lock_guard<std::mutex> lock(balanceWriteMutex);
+    WriteBalance(zeros, false);
+}
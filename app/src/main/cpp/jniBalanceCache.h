@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+// uses the wallet.h types, include after wallet.h
+
+/**
+ * Latest wallet balance as pushed by balanceUpdatedCallback, so balance reads don't have to go to the
+ * wallet database. The values are {available, pending incoming, pending outgoing, time locked}.
+ * Guarded by a seqlock: the callback writes, readers on any thread copy the values without a lock
+ * and retry in the rare case a write overlapped.
+ */
+static const int CachedBalanceValueCount = 4;
+
+/**
+ * Call from balanceUpdatedCallback, before the balance is handed on to its receiver.
+ */
+void UpdateCachedBalance(TariBalance *pBalance);
+
+/**
+ * Copies the cached balance into values. Until the first update arrives this reads the balance from
+ * the database, caching it unless an update came in meanwhile. Returns false if that read failed
+ * (errorPointer is set).
+ */
+bool GetCachedBalance(TariWallet *pWallet, unsigned long long *values, int *errorPointer);
+
+/**
+ * Drops the cached balance, e.g. when the wallet is destroyed.
+ */
+void ClearCachedBalance();
@@ -0,0 +1,306 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <wallet.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "jniCommon.cpp"
+#include "jniBase58.h"
+
+static const char base58Alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+static const uint32_t Base58Power5 = 58 * 58 * 58 * 58 * 58;
+static const int Base58DigitsPerLimbStep = 5;
+
+struct Base58Indices {
+    int8_t values[256];
+
+    Base58Indices() {
+        std::fill(values, values + 256, -1);
+        for (int i = 0; i < 58; i++) {
+            values[static_cast<unsigned char>(base58Alphabet[i])] = static_cast<int8_t>(i);
+        }
+    }
+};
+
+static const Base58Indices &GetBase58Indices() {
+    static const Base58Indices indices;
+    return indices;
+}
+
+std::string Base58Encode(const unsigned char *bytes, size_t size) {
+    size_t zeros = 0;
+    while (zeros < size && bytes[zeros] == 0) {
+        zeros++;
+    }
+    // big endian limbs, the first one takes what is left over from a multiple of 4 bytes
+    size_t rest = size - zeros;
+    std::vector<uint32_t> limbs((rest + 3) / 4);
+    for (size_t i = 0; i < rest; i++) {
+        size_t fromEnd = rest - 1 - i;
+        limbs[limbs.size() - 1 - fromEnd / 4] |= static_cast<uint32_t>(bytes[zeros + i]) << (8 * (fromEnd % 4));
+    }
+    // log(256) / log(58) is about 1.37 digits per byte
+    std::string reversed;
+    reversed.reserve(rest * 138 / 100 + Base58DigitsPerLimbStep + zeros);
+    size_t first = 0;
+    while (first < limbs.size()) {
+        uint64_t remainder = 0;
+        for (size_t i = first; i < limbs.size(); i++) {
+            uint64_t current = (remainder << 32) | limbs[i];
+            limbs[i] = static_cast<uint32_t>(current / Base58Power5);
+            remainder = current % Base58Power5;
+        }
+        while (first < limbs.size() && limbs[first] == 0) {
+            first++;
+        }
+        for (int i = 0; i < Base58DigitsPerLimbStep; i++) {
+            reversed.push_back(base58Alphabet[remainder % 58]);
+            remainder /= 58;
+        }
+    }
+    // the last step pads with zero digits, which are not part of the number
+    while (!reversed.empty() && reversed.back() == base58Alphabet[0]) {
+        reversed.pop_back();
+    }
+    reversed.append(zeros, base58Alphabet[0]);
+    return std::string(reversed.rbegin(), reversed.rend());
+}
+
+bool Base58Decode(const char *base58, size_t length, std::vector<unsigned char> *out) {
+    const Base58Indices &indices = GetBase58Indices();
+    size_t zeros = 0;
+    while (zeros < length && base58[zeros] == base58Alphabet[0]) {
+        zeros++;
+    }
+    // little endian limbs; the first group is short so that the others are exactly 5 digits
+    std::vector<uint32_t> limbs;
+    limbs.reserve((length - zeros) * 733 / 4000 + 1);
+    size_t position = zeros;
+    size_t groupSize = (length - zeros) % Base58DigitsPerLimbStep;
+    if (groupSize == 0) {
+        groupSize = Base58DigitsPerLimbStep;
+    }
+    while (position < length) {
+        uint32_t group = 0;
+        uint32_t multiplier = 1;
+        for (size_t i = 0; i < groupSize; i++) {
+            int digit = indices.values[static_cast<unsigned char>(base58[position + i])];
+            if (digit < 0) {
+                return false;
+            }
+            group = group * 58 + static_cast<uint32_t>(digit);
+            multiplier *= 58;
+        }
+        uint64_t carry = group;
+        for (uint32_t &limb : limbs) {
+            uint64_t current = static_cast<uint64_t>(limb) * multiplier + carry;
+            limb = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        if (carry != 0) {
+            limbs.push_back(static_cast<uint32_t>(carry));
+        }
+        position += groupSize;
+        groupSize = Base58DigitsPerLimbStep;
+    }
+    out->insert(out->end(), zeros, 0);
+    bool leading = true;
+    for (auto limb = limbs.rbegin(); limb != limbs.rend(); ++limb) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            auto byte = static_cast<unsigned char>(*limb >> shift);
+            if (leading && byte == 0) {
+                continue;
+            }
+            leading = false;
+            out->push_back(byte);
+        }
+    }
+    return true;
+}
+
+std::string Base58EncodeAddress(const unsigned char *bytes, size_t size) {
+    if (size < 2) {
+        return Base58Encode(bytes, size);
+    }
+    return Base58Encode(bytes, 1) + Base58Encode(bytes + 1, 1) + Base58Encode(bytes + 2, size - 2);
+}
+
+bool Base58DecodeAddress(const char *base58, size_t length, std::vector<unsigned char> *out) {
+    if (length < 2) {
+        return false;
+    }
+    std::vector<unsigned char> bytes;
+    bool decoded = Base58Decode(base58, 1, &bytes) && Base58Decode(base58 + 1, 1, &bytes) && Base58Decode(base58 + 2, length - 2, &bytes);
+    if (decoded) {
+        out->insert(out->end(), bytes.begin(), bytes.end());
+    }
+    return decoded;
+}
+
+// copies a string made of ASCII chars only; anything else can't be base58 anyway
+static bool GetAsciiString(JNIEnv *jEnv, jstring jValue, std::string *value) {
+    if (jValue == nullptr) {
+        return false;
+    }
+    jsize length = jEnv->GetStringLength(jValue);
+    std::vector<jchar> chars(static_cast<size_t>(length));
+    jEnv->GetStringRegion(jValue, 0, length, chars.data());
+    value->resize(static_cast<size_t>(length));
+    for (jsize i = 0; i < length; i++) {
+        if (chars[i] >= 0x80) {
+            return false;
+        }
+        (*value)[i] = static_cast<char>(chars[i]);
+    }
+    return true;
+}
+
+// decodes every string with decode, null elements for the ones that are not valid
+template <typename F>
+static jobjectArray DecodeAll(JNIEnv *jEnv, jobjectArray jValues, int *errorPointer, F &&decode) {
+    jsize count = jEnv->GetArrayLength(jValues);
+    jclass byteArrayClass = jEnv->FindClass("[B");
+    jobjectArray result = byteArrayClass == nullptr ? nullptr : jEnv->NewObjectArray(count, byteArrayClass, nullptr);
+    jEnv->DeleteLocalRef(byteArrayClass);
+    if (result == nullptr) {
+        jEnv->ExceptionClear();
+        *errorPointer = OutOfMemoryErrorCode;
+        return nullptr;
+    }
+    std::string value;
+    std::vector<unsigned char> bytes;
+    for (jsize i = 0; i < count; i++) {
+        auto jValue = static_cast<jstring>(jEnv->GetObjectArrayElement(jValues, i));
+        bytes.clear();
+        bool decoded = GetAsciiString(jEnv, jValue, &value) && decode(value.data(), value.size(), &bytes);
+        jEnv->DeleteLocalRef(jValue);
+        if (!decoded) {
+            continue;
+        }
+        jbyteArray jBytes = jEnv->NewByteArray(static_cast<jsize>(bytes.size()));
+        if (jBytes == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        jEnv->SetByteArrayRegion(jBytes, 0, static_cast<jsize>(bytes.size()), reinterpret_cast<const jbyte *>(bytes.data()));
+        jEnv->SetObjectArrayElement(result, i, jBytes);
+        jEnv->DeleteLocalRef(jBytes);
+    }
+    return result;
+}
+
+extern "C"
+jstring JNICALL
+Java_com_tari_android_wallet_ffi_FFIBase58_jniEncode(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jbyteArray jBytes,
+        jboolean isAddress) {
+    jsize size = jEnv->GetArrayLength(jBytes);
+    std::vector<unsigned char> bytes(static_cast<size_t>(size));
+    jEnv->GetByteArrayRegion(jBytes, 0, size, reinterpret_cast<jbyte *>(bytes.data()));
+    std::string base58 = isAddress ? Base58EncodeAddress(bytes.data(), bytes.size()) : Base58Encode(bytes.data(), bytes.size());
+    return NewJavaString(jEnv, base58);
+}
+
+extern "C"
+jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIBase58_jniDecodeAll(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jValues,
+        jboolean areAddresses,
+        jobject error) {
+    return ExecuteWithError<jobjectArray>(jEnv, error, [&](int *errorPointer) -> jobjectArray {
+        if (areAddresses) {
+            return DecodeAll(jEnv, jValues, errorPointer, Base58DecodeAddress);
+        }
+        return DecodeAll(jEnv, jValues, errorPointer, Base58Decode);
+    });
+}
+
+extern "C"
+jbooleanArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIBase58_jniValidateAddresses(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jValues,
+        jobject error) {
+    return ExecuteWithError<jbooleanArray>(jEnv, error, [&](int *errorPointer) -> jbooleanArray {
+        jsize count = jEnv->GetArrayLength(jValues);
+        std::vector<jboolean> valid(static_cast<size_t>(count), JNI_FALSE);
+        std::string value;
+        std::vector<unsigned char> bytes;
+        for (jsize i = 0; i < count; i++) {
+            auto jValue = static_cast<jstring>(jEnv->GetObjectArrayElement(jValues, i));
+            bytes.clear();
+            bool decoded = GetAsciiString(jEnv, jValue, &value) && Base58DecodeAddress(value.data(), value.size(), &bytes);
+            jEnv->DeleteLocalRef(jValue);
+            if (!decoded || bytes.empty()) {
+                continue;
+            }
+            // the library checks the checksum and the keys; its error only marks this address invalid
+            int libraryError = 0;
+            ByteVector *pBytes = byte_vector_create(bytes.data(), static_cast<unsigned int>(bytes.size()), &libraryError);
+            if (libraryError == 0) {
+                TariWalletAddress *pAddress = tari_address_create(pBytes, &libraryError);
+                if (pAddress != nullptr) {
+                    valid[i] = libraryError == 0 ? JNI_TRUE : JNI_FALSE;
+                    tari_address_destroy(pAddress);
+                }
+            }
+            byte_vector_destroy(pBytes);
+        }
+        jbooleanArray result = jEnv->NewBooleanArray(count);
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        jEnv->SetBooleanArrayRegion(result, 0, count, valid.data());
+        return result;
+    });
+}
+
+static const JNINativeMethod ffiBase58Methods[] = {
+        NATIVE_METHOD(FFIBase58, jniEncode, "([BZ)" JAVA_STRING),
+        NATIVE_METHOD(FFIBase58, jniDecodeAll, "([" JAVA_STRING "Z" FFI_ERROR ")[[B"),
+        NATIVE_METHOD(FFIBase58, jniValidateAddresses, "([" JAVA_STRING FFI_ERROR ")[Z"),
+};
+
+jint RegisterBase58Natives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIBase58"), ffiBase58Methods, NELEM(ffiBase58Methods));
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Base58 (bitcoin alphabet, no checksum) on 32 bit limbs: encoding divides by 58^5 and decoding
+ * multiplies by it, so every pass over the number handles five digits at once.
+ */
+std::string Base58Encode(const unsigned char *bytes, size_t size);
+
+/**
+ * Appends the decoded bytes to out. Returns false, leaving out unchanged, if a char is not base58.
+ */
+bool Base58Decode(const char *base58, size_t length, std::vector<unsigned char> *out);
+
+/**
+ * Tari address layout: network and features byte each encoded on their own, then the rest of
+ * the address bytes, the same as FFITariWalletAddress.fullBase58 in Kotlin.
+ */
+std::string Base58EncodeAddress(const unsigned char *bytes, size_t size);
+
+/**
+ * Reverse of Base58EncodeAddress, for addresses whose network and features are a single char.
+ */
+bool Base58DecodeAddress(const char *base58, size_t length, std::vector<unsigned char> *out);
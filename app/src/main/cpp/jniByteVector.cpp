@@ -36,30 +36,56 @@
 #include <wallet.h>
 #include <string>
 #include <cmath>
+#include <vector>
 #include <android/log.h>
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIByteVector_jniCreate(
         JNIEnv *jEnv,
         jobject jThis,
         jbyteArray array,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        auto *buffer = reinterpret_cast<unsigned char *>(jEnv->GetByteArrayElements(array, JNI_FALSE));
         jsize size = jEnv->GetArrayLength(array);
-        for (int i = 0; i < size; i++) {
-            printf("%hhx", buffer[i]);
+        // byte_vector_create copies the bytes and makes no JNI call, so the array can stay pinned meanwhile
+        auto *buffer = reinterpret_cast<unsigned char *>(jEnv->GetPrimitiveArrayCritical(array, nullptr));
+        if (buffer == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return;
         }
         ByteVector *pByteVector = byte_vector_create(buffer, static_cast<unsigned int>(size), errorPointer);
-        jEnv->ReleaseByteArrayElements(array, reinterpret_cast<jbyte *>(buffer), JNI_ABORT);
+        jEnv->ReleasePrimitiveArrayCritical(array, buffer, JNI_ABORT);
         SetNullPointerField(jEnv, jThis, pByteVector);
     });
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFIByteVector_jniCreateFromDirectBuffer(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject buffer,
+        jint offset,
+        jint length,
+        jobject error) {
+    ExecuteWithError(jEnv, error, [&](int *errorPointer) {
+        auto *address = static_cast<unsigned char *>(jEnv->GetDirectBufferAddress(buffer));
+        jlong capacity = jEnv->GetDirectBufferCapacity(buffer);
+        // offset and length come from the buffer's position and remaining, anything outside it is a bad argument
+        if (address == nullptr || offset < 0 || length < 0 || static_cast<jlong>(offset) + length > capacity) {
+            *errorPointer = InvalidArgumentErrorCode;
+            return;
+        }
+        ByteVector *pByteVector = byte_vector_create(address + offset, static_cast<unsigned int>(length), errorPointer);
+        SetNullPointerField(jEnv, jThis, pByteVector);
+    });
+}
+
+extern "C"
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -71,7 +97,7 @@ Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -84,10 +110,46 @@ Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetAt(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetBytes(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) -> jbyteArray {
+        auto pByteVector = GetPointerField<ByteVector *>(jEnv, jThis);
+        std::vector<unsigned char> bytes;
+        if (!AppendByteVector(pByteVector, bytes, errorPointer)) {
+            return nullptr;
+        }
+        jbyteArray result = jEnv->NewByteArray(static_cast<jsize>(bytes.size()));
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        jEnv->SetByteArrayRegion(result, 0, static_cast<jsize>(bytes.size()), reinterpret_cast<const jbyte *>(bytes.data()));
+        return result;
+    });
+}
+
+extern "C"
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIByteVector_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     byte_vector_destroy(GetPointerField<ByteVector *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
 }
+
+static const JNINativeMethod ffiByteVectorMethods[] = {
+        NATIVE_METHOD(FFIByteVector, jniCreate, "([B" FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIByteVector, jniCreateFromDirectBuffer, "(" JAVA_BYTE_BUFFER "II" FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIByteVector, jniGetBytes, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIByteVector, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIByteVector, jniGetAt, "(I" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIByteVector, jniDestroy, "()V"),
+};
+
+jint RegisterByteVectorNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIByteVector"), ffiByteVectorMethods, NELEM(ffiByteVectorMethods));
+}
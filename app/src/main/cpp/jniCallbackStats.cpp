@@ -0,0 +1,173 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <atomic>
+#include "jniCallbackStats.h"
+#include "jniWalletEvents.h"
+
+/**
+ * Log-linear histogram: values below 4 have their own bucket, above that every power of two is
+ * split into 4 linear buckets, so a bucket is at most 25% wide. Values are clamped at 2^40 ns
+ * (about 18 minutes). Recording is a few relaxed atomic increments, safe from any thread.
+ */
+class LatencyHistogram {
+public:
+    static const int SubBucketBits = 2;
+    static const int SubBucketCount = 1 << SubBucketBits;
+    static const int MaxExponent = 40;
+    static const int BucketCount = (MaxExponent - SubBucketBits + 2) * SubBucketCount;
+
+    LatencyHistogram() : count(0), max(0) {
+        for (std::atomic<uint64_t> &bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Record(long long nanos) {
+        uint64_t value = nanos > 0 ? static_cast<uint64_t>(nanos) : 0;
+        buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        uint64_t currentMax = max.load(std::memory_order_relaxed);
+        while (value > currentMax && !max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t Count() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t Max() const {
+        return max.load(std::memory_order_relaxed);
+    }
+
+    // upper bound of the bucket holding the given percentile, never above the recorded max
+    uint64_t Percentile(double percentile) const {
+        uint64_t total = Count();
+        if (total == 0) {
+            return 0;
+        }
+        auto rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5);
+        if (rank == 0) {
+            rank = 1;
+        }
+        uint64_t seen = 0;
+        for (int i = 0; i < BucketCount; i++) {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                uint64_t upper = BucketLowerBound(i + 1) - 1;
+                return upper < Max() ? upper : Max();
+            }
+        }
+        return Max();
+    }
+
+    static int BucketIndex(uint64_t value) {
+        if (value < SubBucketCount) {
+            return static_cast<int>(value);
+        }
+        int exponent = 63 - __builtin_clzll(value);
+        if (exponent > MaxExponent) {
+            return BucketCount - 1;
+        }
+        int subBucket = static_cast<int>((value >> (exponent - SubBucketBits)) & (SubBucketCount - 1));
+        return (exponent - SubBucketBits + 1) * SubBucketCount + subBucket;
+    }
+
+    static uint64_t BucketLowerBound(int index) {
+        if (index < SubBucketCount) {
+            return static_cast<uint64_t>(index);
+        }
+        int exponent = index / SubBucketCount + SubBucketBits - 1;
+        auto subBucket = static_cast<uint64_t>(index % SubBucketCount);
+        return (SubBucketCount + subBucket) << (exponent - SubBucketBits);
+    }
+
+private:
+    std::atomic<uint64_t> buckets[BucketCount];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> max;
+};
+
+struct CallbackHistograms {
+    LatencyHistogram callback;
+    LatencyHistogram delivery;
+};
+
+// index 0 holds the thread attaches, event types start at 1
+static CallbackHistograms callbackHistograms[WalletEventTypeCount + 1];
+
+static CallbackHistograms *HistogramsOf(int32_t type) {
+    return type > 0 && type <= WalletEventTypeCount ? &callbackHistograms[type] : nullptr;
+}
+
+void RecordCallbackNanos(int32_t type, long long nanos) {
+    CallbackHistograms *histograms = HistogramsOf(type);
+    if (histograms != nullptr) {
+        histograms->callback.Record(nanos);
+    }
+}
+
+void RecordDeliveryNanos(int32_t type, long long nanos) {
+    CallbackHistograms *histograms = HistogramsOf(type);
+    if (histograms != nullptr) {
+        histograms->delivery.Record(nanos);
+    }
+}
+
+void RecordThreadAttachNanos(long long nanos) {
+    callbackHistograms[0].callback.Record(nanos);
+}
+
+static void PackHistogram(const LatencyHistogram &histogram, std::vector<jlong> &packed) {
+    packed.push_back(static_cast<jlong>(histogram.Count()));
+    packed.push_back(static_cast<jlong>(histogram.Percentile(50)));
+    packed.push_back(static_cast<jlong>(histogram.Percentile(99)));
+    packed.push_back(static_cast<jlong>(histogram.Max()));
+}
+
+std::vector<jlong> PackCallbackStats() {
+    const int recordCount = WalletEventTypeCount + 1;
+    const int fieldsPerRecord = 9;
+    std::vector<jlong> packed;
+    packed.reserve(3 + recordCount * fieldsPerRecord);
+    packed.push_back(1);
+    packed.push_back(recordCount);
+    packed.push_back(fieldsPerRecord);
+    for (int type = 0; type < recordCount; type++) {
+        packed.push_back(type);
+        PackHistogram(callbackHistograms[type].callback, packed);
+        PackHistogram(callbackHistograms[type].delivery, packed);
+    }
+    return packed;
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <jni.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Latency of the wallet callbacks, one pair of histograms per WalletEventType:
+ * - callback: time the library's thread spends in the callback (queueing the event, or the whole
+ *   call into Kotlin when the event queue is disabled)
+ * - delivery: time from queueing an event to the end of the onEvents call that handled it
+ * plus one histogram of the time spent attaching callback threads to the VM.
+ */
+void RecordCallbackNanos(int32_t type, long long nanos);
+
+void RecordDeliveryNanos(int32_t type, long long nanos);
+
+void RecordThreadAttachNanos(long long nanos);
+
+/**
+ * Packs all histograms for FFIWallet.jniGetCallbackStats, decoded by CallbackLatencyStats.kt:
+ * {layout version, record count, fields per record} followed by one record per event type and
+ * one for thread attaches (type 0), each
+ * {type, count, p50, p99, max, delivered count, delivered p50, delivered p99, delivered max}.
+ * Times are in nanoseconds, percentiles are the upper bound of their histogram bucket.
+ */
+std::vector<jlong> PackCallbackStats();
@@ -36,11 +36,14 @@
 #include <wallet.h>
 #include <string>
 #include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
 #include <android/log.h>
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIContacts_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -52,7 +55,7 @@ Java_com_tari_android_wallet_ffi_FFIContacts_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIContacts_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -65,7 +68,7 @@ Java_com_tari_android_wallet_ffi_FFIContacts_jniGetAt(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIContacts_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -74,7 +77,7 @@ Java_com_tari_android_wallet_ffi_FFIContacts_jniDestroy(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -86,7 +89,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -98,8 +101,249 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniGetAt(
     });
 }
 
+/**
+ * Column layout of FFICompletedTxs.jniExportAll, decoded by CompletedTxsExport.kt. Keep both in sync.
+ * All values are in native byte order. After the header come, each starting on an 8 byte boundary:
+ * the u64 columns (id, amount, fee, timestamp, confirmations), the int columns (status, flags,
+ * cancellation reason, address index), the string refs (start and length in the string table for
+ * message, payment id, kernel excess, nonce and signature, length -1 if absent), the address offsets
+ * (address count + 1), the UTF-16 string table and the address bytes.
+ */
+const int32_t CompletedTxsExportVersion = 1;
+const int CompletedTxsExportHeaderInts = 8; // version, tx count, address count, string chars, address bytes, reserved
+const int CompletedTxsExportStringsPerTx = 5;
+const int32_t CompletedTxOutboundFlag = 1;
+const int32_t CompletedTxKernelFlag = 2;
+
+static size_t AlignTo8(size_t size) {
+    return (size + 7) & ~static_cast<size_t>(7);
+}
+
+struct CompletedTxsExport {
+    std::vector<uint64_t> ids, amounts, fees, timestamps, confirmations;
+    std::vector<int32_t> statuses, flags, cancellationReasons, addressIndices;
+    std::vector<int32_t> stringRefs;
+    std::vector<jchar> strings;
+    std::vector<int32_t> addressOffsets{0};
+    std::vector<unsigned char> addressBytes;
+    // counterparties repeat a lot, each distinct address is stored once
+    std::unordered_map<std::string, int32_t> addressIndexByBytes;
+
+    void AddString(const char *pString) {
+        if (pString == nullptr) {
+            stringRefs.push_back(0);
+            stringRefs.push_back(-1);
+            return;
+        }
+        stringRefs.push_back(static_cast<int32_t>(strings.size()));
+        stringRefs.push_back(static_cast<int32_t>(AppendUtf16(strings, pString)));
+    }
+
+    int32_t AddAddress(TariWalletAddress *pAddress, int *errorPointer) {
+        ByteVector *pBytes = tari_address_get_bytes(pAddress, errorPointer);
+        if (*errorPointer != 0) {
+            return -1;
+        }
+        std::vector<unsigned char> bytes;
+        bool copied = AppendByteVector(pBytes, bytes, errorPointer);
+        byte_vector_destroy(pBytes);
+        if (!copied) {
+            return -1;
+        }
+        std::string key(bytes.begin(), bytes.end());
+        auto found = addressIndexByBytes.find(key);
+        if (found != addressIndexByBytes.end()) {
+            return found->second;
+        }
+        auto index = static_cast<int32_t>(addressOffsets.size() - 1);
+        addressIndexByBytes.emplace(std::move(key), index);
+        addressBytes.insert(addressBytes.end(), bytes.begin(), bytes.end());
+        addressOffsets.push_back(static_cast<int32_t>(addressBytes.size()));
+        return index;
+    }
+
+    bool AddTx(TariCompletedTransaction *pTx, int *errorPointer) {
+        // every getter resets the error, so each one is checked before the next runs
+        uint64_t id = completed_transaction_get_transaction_id(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+        uint64_t amount = completed_transaction_get_amount(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+        uint64_t fee = completed_transaction_get_fee(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+        uint64_t timestamp = completed_transaction_get_timestamp(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+        uint64_t confirmationCount = completed_transaction_get_confirmations(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+        int status = completed_transaction_get_status(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+        int cancellationReason = completed_transaction_get_cancellation_reason(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+        bool outbound = completed_transaction_is_outbound(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+
+        TariWalletAddress *pAddress = outbound
+                ? completed_transaction_get_destination_tari_address(pTx, errorPointer)
+                : completed_transaction_get_source_tari_address(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            return false;
+        }
+        int32_t addressIndex = AddAddress(pAddress, errorPointer);
+        tari_address_destroy(pAddress);
+        if (*errorPointer != 0) {
+            return false;
+        }
+
+        const char *pMessage = completed_transaction_get_message(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            string_destroy(const_cast<char *>(pMessage));
+            return false;
+        }
+        const char *pPaymentId = completed_transaction_get_payment_id(pTx, errorPointer);
+        if (*errorPointer != 0) {
+            string_destroy(const_cast<char *>(pMessage));
+            string_destroy(const_cast<char *>(pPaymentId));
+            return false;
+        }
+        ids.push_back(id);
+        amounts.push_back(amount);
+        fees.push_back(fee);
+        timestamps.push_back(timestamp);
+        confirmations.push_back(confirmationCount);
+        statuses.push_back(status);
+        cancellationReasons.push_back(cancellationReason);
+        addressIndices.push_back(addressIndex);
+        AddString(pMessage);
+        AddString(pPaymentId);
+        string_destroy(const_cast<char *>(pMessage));
+        string_destroy(const_cast<char *>(pPaymentId));
+
+        // same rule as CompletedTx: imported (3) and pending (4) txs have no kernel yet, and a
+        // kernel that can't be read is left out rather than failing the whole export
+        TariTransactionKernel *pKernel = nullptr;
+        if (status != 3 && status != 4) {
+            int kernelError = 0;
+            pKernel = completed_transaction_get_transaction_kernel(pTx, &kernelError);
+            if (kernelError != 0) {
+                transaction_kernel_destroy(pKernel);
+                pKernel = nullptr;
+            }
+        }
+        if (pKernel != nullptr) {
+            int kernelError = 0;
+            char *pExcess = transaction_kernel_get_excess_hex(pKernel, &kernelError);
+            char *pNonce = kernelError == 0 ? transaction_kernel_get_excess_public_nonce_hex(pKernel, &kernelError) : nullptr;
+            char *pSignature = kernelError == 0 ? transaction_kernel_get_excess_signature_hex(pKernel, &kernelError) : nullptr;
+            bool complete = kernelError == 0 && pExcess != nullptr && pNonce != nullptr && pSignature != nullptr;
+            AddString(complete ? pExcess : nullptr);
+            AddString(complete ? pNonce : nullptr);
+            AddString(complete ? pSignature : nullptr);
+            string_destroy(pExcess);
+            string_destroy(pNonce);
+            string_destroy(pSignature);
+            transaction_kernel_destroy(pKernel);
+            flags.push_back((outbound ? CompletedTxOutboundFlag : 0) | (complete ? CompletedTxKernelFlag : 0));
+        } else {
+            for (int i = 0; i < 3; i++) {
+                AddString(nullptr);
+            }
+            flags.push_back(outbound ? CompletedTxOutboundFlag : 0);
+        }
+        return true;
+    }
+
+    std::vector<unsigned char> Pack() const {
+        size_t count = ids.size();
+        size_t addressCount = addressOffsets.size() - 1;
+        size_t size = AlignTo8(CompletedTxsExportHeaderInts * sizeof(int32_t))
+                + 5 * AlignTo8(count * sizeof(uint64_t))
+                + 4 * AlignTo8(count * sizeof(int32_t))
+                + AlignTo8(stringRefs.size() * sizeof(int32_t))
+                + AlignTo8(addressOffsets.size() * sizeof(int32_t))
+                + AlignTo8(strings.size() * sizeof(jchar))
+                + addressBytes.size();
+        std::vector<unsigned char> buffer(size, 0);
+        size_t offset = 0;
+        auto put = [&](const void *data, size_t length) {
+            if (length > 0) {
+                memcpy(buffer.data() + offset, data, length);
+            }
+            offset += AlignTo8(length);
+        };
+        int32_t header[CompletedTxsExportHeaderInts] = {
+                CompletedTxsExportVersion,
+                static_cast<int32_t>(count),
+                static_cast<int32_t>(addressCount),
+                static_cast<int32_t>(strings.size()),
+                static_cast<int32_t>(addressBytes.size()),
+        };
+        put(header, sizeof(header));
+        for (auto column : {&ids, &amounts, &fees, &timestamps, &confirmations}) {
+            put(column->data(), column->size() * sizeof(uint64_t));
+        }
+        for (auto column : {&statuses, &flags, &cancellationReasons, &addressIndices}) {
+            put(column->data(), column->size() * sizeof(int32_t));
+        }
+        put(stringRefs.data(), stringRefs.size() * sizeof(int32_t));
+        put(addressOffsets.data(), addressOffsets.size() * sizeof(int32_t));
+        put(strings.data(), strings.size() * sizeof(jchar));
+        put(addressBytes.data(), addressBytes.size());
+        return buffer;
+    }
+};
+
 extern "C"
-JNIEXPORT void JNICALL
+jobject JNICALL
+Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniExportAll(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jobject>(jEnv, error, [&](int *errorPointer) -> jobject {
+        auto pCompletedTransactions = GetPointerField<TariCompletedTransactions *>(jEnv, jThis);
+        unsigned int length = completed_transactions_get_length(pCompletedTransactions, errorPointer);
+        if (*errorPointer != 0) {
+            return nullptr;
+        }
+        CompletedTxsExport txs;
+        txs.stringRefs.reserve(length * CompletedTxsExportStringsPerTx * 2);
+        for (unsigned int i = 0; i < length; i++) {
+            TariCompletedTransaction *pTx = completed_transactions_get_at(pCompletedTransactions, i, errorPointer);
+            if (*errorPointer != 0) {
+                return nullptr;
+            }
+            bool added = txs.AddTx(pTx, errorPointer);
+            completed_transaction_destroy(pTx);
+            if (!added) {
+                return nullptr;
+            }
+        }
+        std::vector<unsigned char> packed = txs.Pack();
+        jobject buffer = NewDirectByteBufferCopy(jEnv, packed.data(), packed.size());
+        if (buffer == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+        }
+        return buffer;
+    });
+}
+
+extern "C"
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -108,7 +352,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniDestroy(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -120,7 +364,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -133,7 +377,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniGetAt(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -143,7 +387,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniDestroy(
 
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -155,7 +399,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -168,7 +412,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniGetAt(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -177,7 +421,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniDestroy(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUnblindedOutputs_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -189,7 +433,7 @@ Java_com_tari_android_wallet_ffi_FFITariUnblindedOutputs_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUnblindedOutputs_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -202,10 +446,50 @@ Java_com_tari_android_wallet_ffi_FFITariUnblindedOutputs_jniGetAt(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUnblindedOutputs_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     unblinded_outputs_destroy(GetPointerField<TariUnblindedOutputs *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiContactsMethods[] = {
+        NATIVE_METHOD(FFIContacts, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIContacts, jniGetAt, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIContacts, jniDestroy, "()V"),
+};
+
+static const JNINativeMethod ffiCompletedTxsMethods[] = {
+        NATIVE_METHOD(FFICompletedTxs, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFICompletedTxs, jniGetAt, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTxs, jniExportAll, "(" FFI_ERROR ")" JAVA_BYTE_BUFFER),
+        NATIVE_METHOD(FFICompletedTxs, jniDestroy, "()V"),
+};
+
+static const JNINativeMethod ffiPendingInboundTxsMethods[] = {
+        NATIVE_METHOD(FFIPendingInboundTxs, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIPendingInboundTxs, jniGetAt, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingInboundTxs, jniDestroy, "()V"),
+};
+
+static const JNINativeMethod ffiPendingOutboundTxsMethods[] = {
+        NATIVE_METHOD(FFIPendingOutboundTxs, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIPendingOutboundTxs, jniGetAt, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingOutboundTxs, jniDestroy, "()V"),
+};
+
+static const JNINativeMethod ffiTariUnblindedOutputsMethods[] = {
+        NATIVE_METHOD(FFITariUnblindedOutputs, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFITariUnblindedOutputs, jniGetAt, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFITariUnblindedOutputs, jniDestroy, "()V"),
+};
+
+jint RegisterCollectionsNatives(JNIEnv *jEnv) {
+    bool registered = RegisterNativeMethods(jEnv, FFI_CLASS("FFIContacts"), ffiContactsMethods, NELEM(ffiContactsMethods)) == JNI_OK
+            && RegisterNativeMethods(jEnv, FFI_CLASS("FFICompletedTxs"), ffiCompletedTxsMethods, NELEM(ffiCompletedTxsMethods)) == JNI_OK
+            && RegisterNativeMethods(jEnv, FFI_CLASS("FFIPendingInboundTxs"), ffiPendingInboundTxsMethods, NELEM(ffiPendingInboundTxsMethods)) == JNI_OK
+            && RegisterNativeMethods(jEnv, FFI_CLASS("FFIPendingOutboundTxs"), ffiPendingOutboundTxsMethods, NELEM(ffiPendingOutboundTxsMethods)) == JNI_OK
+            && RegisterNativeMethods(jEnv, FFI_CLASS("FFITariUnblindedOutputs"), ffiTariUnblindedOutputsMethods, NELEM(ffiTariUnblindedOutputsMethods)) == JNI_OK;
+    return registered ? JNI_OK : JNI_ERR;
+}
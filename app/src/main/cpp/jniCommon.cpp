@@ -30,11 +30,30 @@
  * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
+#ifndef TARI_JNI_COMMON
+#define TARI_JNI_COMMON
+
 #include <jni.h>
 #include <android/log.h>
 #include <string>
+#include <cstring>
 #include <cmath>
+#include <utility>
+#include <ctime>
+#include <cstdio>
+#include <climits>
+#include <vector>
 #include <android/log.h>
+#include "jniHex.h"
+#include "jniUtf.h"
+
+// wallet.h has no include guard and every source file includes it on its own, so the two
+// ByteVector accessors used by the helpers below are declared here rather than including it
+extern "C" {
+struct ByteVector;
+unsigned char byte_vector_get_at(struct ByteVector *ptr, unsigned int position, int *error_out);
+unsigned int byte_vector_get_length(const struct ByteVector *vec, int *error_out);
+}
 
 #define LOG_TAG "Tari Wallet"
 
@@ -51,11 +70,268 @@
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO,     LOG_TAG, __VA_ARGS__)
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG,    LOG_TAG, __VA_ARGS__)
 
+#define NELEM(x) ((jint) (sizeof(x) / sizeof((x)[0])))
+
+/**
+ * Helpers for the RegisterNatives binding tables at the bottom of every jni*.cpp file.
+ * Signatures are built by string literal concatenation, e.g. "(" JAVA_STRING FFI_ERROR ")J".
+ */
+#define FFI_CLASS(name) "com/tari/android/wallet/ffi/" name
+#define FFI_TYPE(name) "L" FFI_CLASS(name) ";"
+#define FFI_ERROR FFI_TYPE("FFIError")
+#define JAVA_STRING "Ljava/lang/String;"
+#define JAVA_BYTE_BUFFER "Ljava/nio/ByteBuffer;"
+#define NATIVE_METHOD(className, methodName, signature) \
+    { #methodName, signature, reinterpret_cast<void *>(Java_com_tari_android_wallet_ffi_##className##_##methodName) }
+
+inline long long MonotonicNanos() {
+    timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<long long>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+}
+
+/**
+ * Binds a table of native methods to the given class. Logs how long the registration took so the
+ * startup cost of each class shows up in logcat.
+ */
+inline jint RegisterNativeMethods(JNIEnv *jEnv, const char *className, const JNINativeMethod *methods, jint count) {
+    long long start = MonotonicNanos();
+    jclass cls = jEnv->FindClass(className);
+    if (cls == nullptr) {
+        LOGE("Class %s not found, natives not registered.", className);
+        return JNI_ERR;
+    }
+    jint result = jEnv->RegisterNatives(cls, methods, count);
+    jEnv->DeleteLocalRef(cls);
+    if (result != JNI_OK) {
+        LOGE("Failed to register natives for %s.", className);
+        return result;
+    }
+    LOGI("Registered %d natives for %s in %lld us.", count, className, (MonotonicNanos() - start) / 1000);
+    return JNI_OK;
+}
+
+/**
+ * Classes, field IDs and method IDs used by the bridge. Resolved once in JNI_OnLoad (see
+ * LoadJniIds) so the per-call helpers below never do a reflective lookup.
+ */
+struct JniIds {
+    jclass ffiBaseClass;
+    jfieldID ffiBasePointerField;
+
+    jclass ffiErrorClass;
+    jfieldID ffiErrorCodeField;
+
+    jclass ffiExceptionClass;
+    jmethodID ffiExceptionCodeConstructor;
+
+    jclass ffiTariVectorClass;
+    jfieldID ffiTariVectorLenField;
+    jfieldID ffiTariVectorCapField;
+    jfieldID ffiTariVectorTagField;
+
+    jclass ffiTariUtxoClass;
+    jfieldID ffiTariUtxoValueField;
+    jfieldID ffiTariUtxoMinedHeightField;
+    jfieldID ffiTariUtxoMinedTimestampField;
+    jfieldID ffiTariUtxoLockHeightField;
+    jfieldID ffiTariUtxoStatusField;
+    jfieldID ffiTariUtxoCommitmentField;
+
+    jclass ffiTariCoinPreviewClass;
+    jfieldID ffiTariCoinPreviewVectorPointerField;
+    jfieldID ffiTariCoinPreviewFeeValueField;
+
+    jclass ffiTariWalletAddressPartsClass;
+    jfieldID ffiTariWalletAddressPartsNetworkField;
+    jfieldID ffiTariWalletAddressPartsFeaturesField;
+    jfieldID ffiTariWalletAddressPartsChecksumField;
+    jfieldID ffiTariWalletAddressPartsEmojiIdField;
+    jfieldID ffiTariWalletAddressPartsViewKeyEmojisField;
+    jfieldID ffiTariWalletAddressPartsSpendKeyEmojisField;
+    jfieldID ffiTariWalletAddressPartsSpendKeyIsZeroField;
+    jfieldID ffiTariWalletAddressPartsBytesField;
+    jfieldID ffiTariWalletAddressPartsBase58Field;
+
+    jclass ffiContactIndexEntryClass;
+    jfieldID ffiContactIndexEntryAliasField;
+    jfieldID ffiContactIndexEntryIsFavoriteField;
+    jfieldID ffiContactIndexEntryEmojiIdField;
+
+    jclass byteBufferClass;
+    jmethodID byteBufferAllocateDirectMethod;
+
+    jclass stringClass;
+    jclass outOfMemoryErrorClass;
+
+    jclass ffiWalletClass;
+    jmethodID txReceivedCallbackMethodId;
+    jmethodID txReplyReceivedCallbackMethodId;
+    jmethodID txFinalizedCallbackMethodId;
+    jmethodID txBroadcastCallbackMethodId;
+    jmethodID txMinedCallbackMethodId;
+    jmethodID txMinedUnconfirmedCallbackMethodId;
+    jmethodID txFauxConfirmedCallbackMethodId;
+    jmethodID txFauxUnconfirmedCallbackMethodId;
+    jmethodID directSendResultCallbackMethodId;
+    jmethodID txCancellationCallbackMethodId;
+    jmethodID contactsLivenessDataUpdatedCallbackMethodId;
+    jmethodID connectivityStatusCallbackId;
+    jmethodID txoValidationCompleteCallbackMethodId;
+    jmethodID transactionValidationCompleteCallbackMethodId;
+    jmethodID recoveringProcessCompleteCallbackMethodId;
+    jmethodID balanceUpdatedCallbackMethodId;
+    jmethodID walletScannedHeightCallbackMethodId;
+    jmethodID baseNodeStatusCallbackMethodId;
+
+    // overloads of the callbacks above taking u64 arguments as jlong
+    jmethodID txMinedUnconfirmedU64CallbackMethodId;
+    jmethodID txFauxUnconfirmedU64CallbackMethodId;
+    jmethodID directSendResultU64CallbackMethodId;
+    jmethodID txCancellationU64CallbackMethodId;
+    jmethodID txoValidationCompleteU64CallbackMethodId;
+    jmethodID transactionValidationCompleteU64CallbackMethodId;
+    jmethodID connectivityStatusU64CallbackId;
+    jmethodID walletScannedHeightU64CallbackMethodId;
+    jmethodID recoveringProcessCompleteU64CallbackMethodId;
+
+    // batched delivery of the callbacks above, see jniWalletEvents.cpp
+    jmethodID onEventsMethodId;
+};
+
+// function-local static of an inline function, so every source file shares the same instance
+inline JniIds &GetJniIds() {
+    static JniIds ids = {};
+    return ids;
+}
+
+inline jclass FindGlobalClass(JNIEnv *jEnv, const char *name) {
+    jclass localClass = jEnv->FindClass(name);
+    if (localClass == nullptr) {
+        LOGE("Class %s not found.", name);
+        return nullptr;
+    }
+    auto globalClass = static_cast<jclass>(jEnv->NewGlobalRef(localClass));
+    jEnv->DeleteLocalRef(localClass);
+    return globalClass;
+}
+
+inline bool FindField(JNIEnv *jEnv, jclass cls, const char *name, const char *signature, jfieldID *field) {
+    *field = jEnv->GetFieldID(cls, name, signature);
+    if (*field == nullptr) {
+        LOGE("Field %s %s not found.", name, signature);
+        return false;
+    }
+    return true;
+}
+
+inline bool FindMethod(JNIEnv *jEnv, jclass cls, const char *name, const char *signature, jmethodID *method) {
+    *method = jEnv->GetMethodID(cls, name, signature);
+    if (*method == nullptr) {
+        LOGE("Method %s %s not found.", name, signature);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Resolves every class, field and method ID of the bridge. Must be called from JNI_OnLoad,
+ * returns false (with a pending Java exception) if any of them is missing.
+ */
+inline bool LoadJniIds(JNIEnv *jEnv) {
+    JniIds &ids = GetJniIds();
+
+    ids.ffiBaseClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFIBase");
+    ids.ffiErrorClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFIError");
+    ids.ffiExceptionClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFIException");
+    ids.ffiTariVectorClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFITariVector");
+    ids.ffiTariUtxoClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFITariUtxo");
+    ids.ffiTariCoinPreviewClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFITariCoinPreview");
+    ids.ffiWalletClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFIWallet");
+    ids.ffiTariWalletAddressPartsClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFITariWalletAddressParts");
+    ids.ffiContactIndexEntryClass = FindGlobalClass(jEnv, "com/tari/android/wallet/ffi/FFIContactIndexEntry");
+    ids.byteBufferClass = FindGlobalClass(jEnv, "java/nio/ByteBuffer");
+    ids.stringClass = FindGlobalClass(jEnv, "java/lang/String");
+    ids.outOfMemoryErrorClass = FindGlobalClass(jEnv, "java/lang/OutOfMemoryError");
+    if (ids.ffiBaseClass == nullptr || ids.ffiErrorClass == nullptr || ids.ffiExceptionClass == nullptr || ids.ffiTariVectorClass == nullptr ||
+        ids.ffiTariUtxoClass == nullptr || ids.ffiTariCoinPreviewClass == nullptr || ids.ffiWalletClass == nullptr ||
+        ids.ffiTariWalletAddressPartsClass == nullptr || ids.ffiContactIndexEntryClass == nullptr || ids.byteBufferClass == nullptr ||
+        ids.stringClass == nullptr || ids.outOfMemoryErrorClass == nullptr) {
+        return false;
+    }
+
+    ids.byteBufferAllocateDirectMethod = jEnv->GetStaticMethodID(ids.byteBufferClass, "allocateDirect", "(I)" JAVA_BYTE_BUFFER);
+    if (ids.byteBufferAllocateDirectMethod == nullptr) {
+        LOGE("Method ByteBuffer.allocateDirect not found.");
+        return false;
+    }
+
+    return FindField(jEnv, ids.ffiBaseClass, "pointer", "J", &ids.ffiBasePointerField)
+           && FindField(jEnv, ids.ffiErrorClass, "code", "I", &ids.ffiErrorCodeField)
+           && FindMethod(jEnv, ids.ffiExceptionClass, "<init>", "(I)V", &ids.ffiExceptionCodeConstructor)
+
+           && FindField(jEnv, ids.ffiTariVectorClass, "len", "J", &ids.ffiTariVectorLenField)
+           && FindField(jEnv, ids.ffiTariVectorClass, "cap", "J", &ids.ffiTariVectorCapField)
+           && FindField(jEnv, ids.ffiTariVectorClass, "tag", "I", &ids.ffiTariVectorTagField)
+
+           && FindField(jEnv, ids.ffiTariUtxoClass, "value", "J", &ids.ffiTariUtxoValueField)
+           && FindField(jEnv, ids.ffiTariUtxoClass, "minedHeight", "J", &ids.ffiTariUtxoMinedHeightField)
+           && FindField(jEnv, ids.ffiTariUtxoClass, "minedTimestamp", "J", &ids.ffiTariUtxoMinedTimestampField)
+           && FindField(jEnv, ids.ffiTariUtxoClass, "lockHeight", "J", &ids.ffiTariUtxoLockHeightField)
+           && FindField(jEnv, ids.ffiTariUtxoClass, "status", "B", &ids.ffiTariUtxoStatusField)
+           && FindField(jEnv, ids.ffiTariUtxoClass, "commitment", "Ljava/lang/String;", &ids.ffiTariUtxoCommitmentField)
+
+           && FindField(jEnv, ids.ffiTariCoinPreviewClass, "vectorPointer", "J", &ids.ffiTariCoinPreviewVectorPointerField)
+           && FindField(jEnv, ids.ffiTariCoinPreviewClass, "feeValue", "J", &ids.ffiTariCoinPreviewFeeValueField)
+
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "network", "I", &ids.ffiTariWalletAddressPartsNetworkField)
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "features", "I", &ids.ffiTariWalletAddressPartsFeaturesField)
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "checksum", "I", &ids.ffiTariWalletAddressPartsChecksumField)
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "emojiId", JAVA_STRING, &ids.ffiTariWalletAddressPartsEmojiIdField)
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "viewKeyEmojis", JAVA_STRING, &ids.ffiTariWalletAddressPartsViewKeyEmojisField)
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "spendKeyEmojis", JAVA_STRING, &ids.ffiTariWalletAddressPartsSpendKeyEmojisField)
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "spendKeyIsZero", "Z", &ids.ffiTariWalletAddressPartsSpendKeyIsZeroField)
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "bytes", "[B", &ids.ffiTariWalletAddressPartsBytesField)
+           && FindField(jEnv, ids.ffiTariWalletAddressPartsClass, "base58", JAVA_STRING, &ids.ffiTariWalletAddressPartsBase58Field)
+
+           && FindField(jEnv, ids.ffiContactIndexEntryClass, "alias", JAVA_STRING, &ids.ffiContactIndexEntryAliasField)
+           && FindField(jEnv, ids.ffiContactIndexEntryClass, "isFavorite", "Z", &ids.ffiContactIndexEntryIsFavoriteField)
+           && FindField(jEnv, ids.ffiContactIndexEntryClass, "emojiId", JAVA_STRING, &ids.ffiContactIndexEntryEmojiIdField)
+
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxReceived", "(J)V", &ids.txReceivedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxReplyReceived", "(J)V", &ids.txReplyReceivedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxFinalized", "(J)V", &ids.txFinalizedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxBroadcast", "(J)V", &ids.txBroadcastCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxMined", "(J)V", &ids.txMinedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxMinedUnconfirmed", "(J[B)V", &ids.txMinedUnconfirmedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxFauxConfirmed", "(J)V", &ids.txFauxConfirmedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxFauxUnconfirmed", "(J[B)V", &ids.txFauxUnconfirmedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onDirectSendResult", "([BJ)V", &ids.directSendResultCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxCancelled", "(J[B)V", &ids.txCancellationCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTXOValidationComplete", "([B[B)V", &ids.txoValidationCompleteCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onContactLivenessDataUpdated", "(J)V", &ids.contactsLivenessDataUpdatedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onBalanceUpdated", "(J)V", &ids.balanceUpdatedCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxValidationComplete", "([B[B)V", &ids.transactionValidationCompleteCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onConnectivityStatus", "([B)V", &ids.connectivityStatusCallbackId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onWalletScannedHeight", "([B)V", &ids.walletScannedHeightCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onBaseNodeStatus", "(J)V", &ids.baseNodeStatusCallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onWalletRecovery", "(I[B[B)V", &ids.recoveringProcessCompleteCallbackMethodId)
+
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxMinedUnconfirmed", "(JJ)V", &ids.txMinedUnconfirmedU64CallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxFauxUnconfirmed", "(JJ)V", &ids.txFauxUnconfirmedU64CallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onDirectSendResult", "(JJ)V", &ids.directSendResultU64CallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxCancelled", "(JJ)V", &ids.txCancellationU64CallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTXOValidationComplete", "(JJ)V", &ids.txoValidationCompleteU64CallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onTxValidationComplete", "(JJ)V", &ids.transactionValidationCompleteU64CallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onConnectivityStatus", "(J)V", &ids.connectivityStatusU64CallbackId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onWalletScannedHeight", "(J)V", &ids.walletScannedHeightU64CallbackMethodId)
+           && FindMethod(jEnv, ids.ffiWalletClass, "onWalletRecovery", "(IJJ)V", &ids.recoveringProcessCompleteU64CallbackMethodId)
+
+           && FindMethod(jEnv, ids.ffiWalletClass, "onEvents", "(" JAVA_BYTE_BUFFER ")V", &ids.onEventsMethodId);
+}
+
 inline jlong GetPointerField(JNIEnv *jEnv, jobject jThis) {
-    jclass cls = jEnv->GetObjectClass(jThis);
-    jfieldID fid = jEnv->GetFieldID(cls, "pointer", "J");
-    jlong lByteVector = jEnv->GetLongField(jThis, fid);
-    return lByteVector;
+    return jEnv->GetLongField(jThis, GetJniIds().ffiBasePointerField);
 }
 
 template <typename T>
@@ -64,9 +340,7 @@ inline T GetPointerField(JNIEnv *jEnv, jobject jThis) {
 }
 
 inline void SetPointerField(JNIEnv *jEnv, jobject jThis, jlong jPointer) {
-    jclass cls = jEnv->GetObjectClass(jThis);
-    jfieldID fid = jEnv->GetFieldID(cls, "pointer", "J");
-    jEnv->SetLongField(jThis, fid, jPointer);
+    jEnv->SetLongField(jThis, GetJniIds().ffiBasePointerField, jPointer);
 }
 
 inline void SetNullPointerField(JNIEnv *jEnv, jobject jThis) {
@@ -96,33 +370,262 @@ inline jbyteArray getBytesFromUnsignedLongLong(JNIEnv *jEnv, unsigned long long
     return result;
 }
 
+// u64 values cross as a jlong holding the same 64 bits; Kotlin reads them back with toUnsignedBigInteger()
+inline jlong getLongFromUnsignedLongLong(unsigned long long value) {
+    return static_cast<jlong>(value);
+}
+
+// error codes from 9000 up are raised by the bridge itself rather than by the wallet library
+const jint InvalidNumericArgumentErrorCode = 9001;
+const jint OutOfMemoryErrorCode = 9002;
+const jint UnexpectedLibraryDataErrorCode = 9003;
+const jint InvalidArgumentErrorCode = 9004;
+
+/**
+ * Appends the bytes of a library ByteVector. Native calls only, no JNI crossing per byte.
+ */
+inline bool AppendByteVector(ByteVector *pVector, std::vector<unsigned char> &bytes, int *errorPointer) {
+    unsigned int length = byte_vector_get_length(pVector, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    size_t start = bytes.size();
+    bytes.resize(start + length);
+    for (unsigned int i = 0; i < length; i++) {
+        bytes[start + i] = byte_vector_get_at(pVector, i, errorPointer);
+        if (*errorPointer != 0) {
+            bytes.resize(start);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Appends a NUL terminated UTF-8 string as UTF-16, the encoding of Java strings, and returns the
+ * number of chars appended. Malformed sequences become U+FFFD.
+ */
+inline size_t AppendUtf16(std::vector<jchar> &chars, const char *utf8) {
+    size_t start = chars.size();
+    size_t length = strlen(utf8);
+    chars.resize(start + length);
+    size_t count = Utf8ToUtf16(utf8, length, chars.data() + start);
+    chars.resize(start + count);
+    return count;
+}
+
+/**
+ * Throws OutOfMemoryError for a size no Java array or string can hold, so callers see the same
+ * pending exception as when the VM fails the allocation itself.
+ */
+inline void ThrowOutOfMemoryError(JNIEnv *jEnv, const char *message) {
+    jEnv->ThrowNew(GetJniIds().outOfMemoryErrorClass, message);
+}
+
+/**
+ * Creates a Java string from length bytes of UTF-8. Use this rather than NewStringUTF for anything
+ * the library returns: that one takes modified UTF-8, where emoji are spelled differently. Returns
+ * null with an OutOfMemoryError pending if the string can't be allocated.
+ */
+inline jstring NewJavaString(JNIEnv *jEnv, const char *utf8, size_t length) {
+    if (length > INT_MAX) {
+        ThrowOutOfMemoryError(jEnv, "String too long");
+        return nullptr;
+    }
+    // an emoji id, a message or a word fits on the stack
+    jchar stackChars[256];
+    std::vector<jchar> heapChars;
+    jchar *chars = stackChars;
+    if (length > sizeof(stackChars) / sizeof(stackChars[0])) {
+        heapChars.resize(length);
+        chars = heapChars.data();
+    }
+    size_t count = Utf8ToUtf16(utf8, length, chars);
+    return jEnv->NewString(chars, static_cast<jsize>(count));
+}
+
+/**
+ * Creates a Java string from a NUL terminated UTF-8 string, or returns null for null.
+ */
+inline jstring NewJavaString(JNIEnv *jEnv, const char *utf8) {
+    return utf8 == nullptr ? nullptr : NewJavaString(jEnv, utf8, strlen(utf8));
+}
+
+inline jstring NewJavaString(JNIEnv *jEnv, const std::string &utf8) {
+    return NewJavaString(jEnv, utf8.data(), utf8.size());
+}
+
+/**
+ * NUL terminated UTF-8 copy of a Java string, for passing strings to the library in place of a
+ * GetStringUTFChars / ReleaseStringUTFChars pair. The chars are read straight out of the string and
+ * transcoded once, into real UTF-8, so emoji arrive as the library expects them. c_str() is null
+ * for a null string and stays valid until the object goes out of scope.
+ *
+ * c_str() is also null if the chars could not be read (the OutOfMemoryError is cleared), which it
+ * can't tell apart from a null string: callers must check ok(), e.g. through CheckJavaString.
+ */
+class JavaStringUtf8 {
+public:
+    JavaStringUtf8(JNIEnv *jEnv, jstring jString) {
+        if (jString == nullptr) {
+            return;
+        }
+        auto length = static_cast<size_t>(jEnv->GetStringLength(jString));
+        char *utf8 = stackBytes;
+        if (3 * length + 1 > sizeof(stackBytes)) {
+            heapBytes.resize(3 * length + 1);
+            utf8 = heapBytes.data();
+        }
+        // critical access hands out the string's own chars where the VM can; nothing else touches
+        // JNI until it is released
+        const jchar *chars = jEnv->GetStringCritical(jString, nullptr);
+        if (chars == nullptr) {
+            jEnv->ExceptionClear();
+            read = false;
+            return;
+        }
+        size_t size = Utf16ToUtf8(chars, length, utf8);
+        jEnv->ReleaseStringCritical(jString, chars);
+        utf8[size] = '\0';
+        pUtf8 = utf8;
+    }
+
+    JavaStringUtf8(const JavaStringUtf8 &) = delete;
+    JavaStringUtf8 &operator=(const JavaStringUtf8 &) = delete;
+
+    const char *c_str() const {
+        return pUtf8;
+    }
+
+    // false if the string could not be read, true for a null string
+    bool ok() const {
+        return read;
+    }
+
+private:
+    char stackBytes[256];
+    std::vector<char> heapBytes;
+    const char *pUtf8 = nullptr;
+    bool read = true;
+};
+
+/**
+ * Sets OutOfMemoryErrorCode and returns false if string could not be read.
+ */
+inline bool CheckJavaString(const JavaStringUtf8 &string, int *errorPointer) {
+    if (!string.ok()) {
+        *errorPointer = OutOfMemoryErrorCode;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Decodes exactly size bytes of hex, either case. Returns false if hex is shorter, longer or not hex.
+ */
+inline bool HexToBytes(const char *hex, unsigned char *out, size_t size) {
+    if (hex == nullptr) {
+        return false;
+    }
+    // HexDecode reads whole blocks, so a short string must be caught before it runs past the NUL
+    return strnlen(hex, 2 * size + 1) == 2 * size && HexDecode(hex, size, out);
+}
+
+/**
+ * Writes 2 * size lowercase hex chars and a NUL to hex.
+ */
+inline void BytesToHex(const unsigned char *bytes, size_t size, char *hex) {
+    HexEncode(bytes, size, hex, false);
+    hex[2 * size] = '\0';
+}
+
+/**
+ * Copies bytes into a new direct ByteBuffer owned by the Java heap (ByteBuffer.allocateDirect), so
+ * Kotlin can keep it without a matching native free. Returns null with an OutOfMemoryError pending
+ * if the buffer can't be allocated.
+ */
+inline jobject NewDirectByteBufferCopy(JNIEnv *jEnv, const void *data, size_t size) {
+    if (size > INT_MAX) {
+        ThrowOutOfMemoryError(jEnv, "Buffer too large");
+        return nullptr;
+    }
+    const JniIds &ids = GetJniIds();
+    jobject buffer = jEnv->CallStaticObjectMethod(ids.byteBufferClass, ids.byteBufferAllocateDirectMethod, static_cast<jint>(size));
+    if (buffer == nullptr) {
+        return nullptr;
+    }
+    if (size > 0) {
+        memcpy(jEnv->GetDirectBufferAddress(buffer), data, size);
+    }
+    return buffer;
+}
+
+/**
+ * Validates a jlong passed for an unsigned native parameter. Negative values and values above max set
+ * InvalidNumericArgumentErrorCode instead of wrapping around.
+ */
+inline bool CheckUnsignedArgument(jlong value, int *errorPointer, unsigned long long max = LLONG_MAX) {
+    if (value < 0 || static_cast<unsigned long long>(value) > max) {
+        *errorPointer = InvalidNumericArgumentErrorCode;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Throws FFIException(code). Falls back to ThrowNew with the code in the message if the
+ * exception object can't be constructed.
+ */
+inline void ThrowFFIException(JNIEnv *jEnv, jint code) {
+    const JniIds &ids = GetJniIds();
+    auto exception = static_cast<jthrowable>(jEnv->NewObject(ids.ffiExceptionClass, ids.ffiExceptionCodeConstructor, code));
+    if (exception != nullptr) {
+        jEnv->Throw(exception);
+        jEnv->DeleteLocalRef(exception);
+    } else if (!jEnv->ExceptionCheck()) {
+        char message[32];
+        snprintf(message, sizeof(message), "Error code: %d", code);
+        jEnv->ThrowNew(ids.ffiExceptionClass, message);
+    }
+}
+
+/**
+ * Reports the result code of a native call. With an FFIError the code is written to it, as before.
+ * Without one (null error) nothing happens on success and FFIException is thrown on failure, so
+ * the success path touches no Java object at all. Nothing but releases may follow this call.
+ */
 inline jboolean setErrorCode(JNIEnv *jEnv, jobject error, jint value) {
-    jclass errorClass = jEnv->GetObjectClass(error);
-    if (errorClass == nullptr)
-        return static_cast<jboolean>(false);
-    jfieldID errorField = jEnv->GetFieldID(errorClass, "code", "I");
-    if (errorField == nullptr)
+    if (error == nullptr) {
+        if (value != 0) {
+            ThrowFFIException(jEnv, value);
+        }
         return static_cast<jboolean>(false);
-    jEnv->SetIntField(error, errorField, value);
+    }
+    jEnv->SetIntField(error, GetJniIds().ffiErrorCodeField, value);
     return static_cast<jboolean>(true);
 }
 
-template <typename G>
-inline G ExecuteWithError(JNIEnv *jEnv, jobject error, std::function<G(int*)> fun) {
+// The callable is a template parameter rather than a std::function so every call site
+// gets its own instantiation: no type erasure, no capture allocation, no indirect call.
+template <typename G, typename F>
+inline G ExecuteWithError(JNIEnv *jEnv, jobject error, F &&fun) {
     int errorCode = 0;
     G result = fun(&errorCode);
     setErrorCode(jEnv, error, errorCode);
     return result;
 }
 
-inline void ExecuteWithError(JNIEnv *jEnv, jobject error, std::function<void(int*)> fun) {
+template <typename F>
+inline void ExecuteWithError(JNIEnv *jEnv, jobject error, F &&fun) {
     int errorCode = 0;
     fun(&errorCode);
     setErrorCode(jEnv, error, errorCode);
 }
 
-template <typename G>
-inline jlong ExecuteWithErrorAndCast(JNIEnv *jEnv, jobject error, std::function<G(int*)> fun) {
-    G result = ExecuteWithError(jEnv, error, fun);
+template <typename G, typename F>
+inline jlong ExecuteWithErrorAndCast(JNIEnv *jEnv, jobject error, F &&fun) {
+    G result = ExecuteWithError<G>(jEnv, error, std::forward<F>(fun));
     return reinterpret_cast<jlong>(result);
-}
\ No newline at end of file
+}
+
+#endif // TARI_JNI_COMMON
@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFICommsConfig_jniCreate(
         JNIEnv *jEnv,
         jobject jThis,
@@ -51,33 +51,34 @@ Java_com_tari_android_wallet_ffi_FFICommsConfig_jniCreate(
         jlong jDiscoveryTimeoutSec,
         jlong jSafDurationSec,
         jobject error) {
-    const char *pControlServiceAddress = jEnv->GetStringUTFChars(jPublicAddress, JNI_FALSE);
-    const char *pDatabaseName = jEnv->GetStringUTFChars(jDatabaseName, JNI_FALSE);
-    const char *pDatastorePath = jEnv->GetStringUTFChars(jDatastorePath, JNI_FALSE);
+    JavaStringUtf8 controlServiceAddress(jEnv, jPublicAddress);
+    JavaStringUtf8 databaseName(jEnv, jDatabaseName);
+    JavaStringUtf8 datastorePath(jEnv, jDatastorePath);
     auto pTransport = GetPointerField<TariTransportConfig *>(jEnv, jTransport);
     if (jDiscoveryTimeoutSec < 0) {
         jDiscoveryTimeoutSec = abs(jDiscoveryTimeoutSec);
     }
 
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
+        if (!CheckJavaString(controlServiceAddress, errorPointer) || !CheckJavaString(databaseName, errorPointer) ||
+            !CheckJavaString(datastorePath, errorPointer)) {
+            return;
+        }
         TariCommsConfig *pCommsConfig = comms_config_create(
-                pControlServiceAddress,
+                controlServiceAddress.c_str(),
                 pTransport,
-                pDatabaseName,
-                pDatastorePath,
+                databaseName.c_str(),
+                datastorePath.c_str(),
                 static_cast<unsigned long long int>(jDiscoveryTimeoutSec),
                 static_cast<unsigned long long int>(jSafDurationSec),
                 errorPointer
         );
-        jEnv->ReleaseStringUTFChars(jPublicAddress, pControlServiceAddress);
-        jEnv->ReleaseStringUTFChars(jDatabaseName, pDatabaseName);
-        jEnv->ReleaseStringUTFChars(jDatastorePath, pDatastorePath);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pCommsConfig));
     });
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFICommsConfig_jniGetLastVersion(
         JNIEnv *jEnv,
         jobject jThis,
@@ -86,7 +87,7 @@ Java_com_tari_android_wallet_ffi_FFICommsConfig_jniGetLastVersion(
         auto pWallet = GetPointerField<TariCommsConfig *>(jEnv, jThis);
         char *pSignature = wallet_get_last_version(pWallet, errorPointer);
 
-        jstring result = jEnv->NewStringUTF(pSignature);
+        jstring result = NewJavaString(jEnv, pSignature);
         string_destroy(pSignature);
 
         return result;
@@ -94,10 +95,20 @@ Java_com_tari_android_wallet_ffi_FFICommsConfig_jniGetLastVersion(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFICommsConfig_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     comms_config_destroy(GetPointerField<TariCommsConfig *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
 }
+
+static const JNINativeMethod ffiCommsConfigMethods[] = {
+        NATIVE_METHOD(FFICommsConfig, jniCreate, "(" JAVA_STRING FFI_TYPE("FFITariTransportConfig") JAVA_STRING JAVA_STRING "JJ" FFI_ERROR ")V"),
+        NATIVE_METHOD(FFICommsConfig, jniGetLastVersion, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFICommsConfig, jniDestroy, "()V"),
+};
+
+jint RegisterCommsConfigNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFICommsConfig"), ffiCommsConfigMethods, NELEM(ffiCommsConfigMethods));
+}
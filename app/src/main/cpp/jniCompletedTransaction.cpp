@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetId(
         JNIEnv *jEnv,
         jobject jThis,
@@ -52,7 +52,19 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetId(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetIdU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(completed_transaction_get_transaction_id(pCompletedTx, errorPointer));
+    });
+}
+
+extern "C"
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetDestinationPublicKey(
         JNIEnv *jEnv,
         jobject jThis,
@@ -64,7 +76,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetDestinationPublicKey(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetSourcePublicKey(
         JNIEnv *jEnv,
         jobject jThis,
@@ -76,7 +88,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetSourcePublicKey(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetTransactionKernel(
         JNIEnv *jEnv,
         jobject jThis,
@@ -88,7 +100,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetTransactionKernel(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetAmount(
         JNIEnv *jEnv,
         jobject jThis,
@@ -100,7 +112,19 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetAmount(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetAmountU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(completed_transaction_get_amount(pCompletedTx, errorPointer));
+    });
+}
+
+extern "C"
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetFee(
         JNIEnv *jEnv,
         jobject jThis,
@@ -112,7 +136,19 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetFee(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetFeeU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(completed_transaction_get_fee(pCompletedTx, errorPointer));
+    });
+}
+
+extern "C"
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetTimestamp(
         JNIEnv *jEnv,
         jobject jThis,
@@ -124,7 +160,19 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetTimestamp(
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetTimestampU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(completed_transaction_get_timestamp(pCompletedTx, errorPointer));
+    });
+}
+
+extern "C"
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetMessage(
         JNIEnv *jEnv,
         jobject jThis,
@@ -132,14 +180,14 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetMessage(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         const char *pMessage = completed_transaction_get_message(pCompletedTx, errorPointer);
-        jstring result = jEnv->NewStringUTF(pMessage);
+        jstring result = NewJavaString(jEnv, pMessage);
         string_destroy(const_cast<char *>(pMessage));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetPaymentId(
         JNIEnv *jEnv,
         jobject jThis,
@@ -147,14 +195,14 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetPaymentId(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         const char *pPaymentId = completed_transaction_get_payment_id(pCompletedTx, errorPointer);
-        jstring result = jEnv->NewStringUTF(pPaymentId);
+        jstring result = NewJavaString(jEnv, pPaymentId);
         string_destroy(const_cast<char *>(pPaymentId));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetStatus(
         JNIEnv *jEnv,
         jobject jThis,
@@ -166,7 +214,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetStatus(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetConfirmationCount(
         JNIEnv *jEnv,
         jobject jThis,
@@ -178,7 +226,19 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetConfirmationCount(
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetConfirmationCountU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(completed_transaction_get_confirmations(pCompletedTx, errorPointer));
+    });
+}
+
+extern "C"
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniIsOutbound(
         JNIEnv *jEnv,
         jobject jThis,
@@ -190,7 +250,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniIsOutbound(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -199,7 +259,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniDestroy(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetCancellationReason(
         JNIEnv *jEnv,
         jobject jThis,
@@ -209,3 +269,29 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetCancellationReason(
         return reinterpret_cast<jint>(completed_transaction_get_cancellation_reason(pCompletedTx, errorPointer));
     });
 }
+
+static const JNINativeMethod ffiCompletedTxMethods[] = {
+        NATIVE_METHOD(FFICompletedTx, jniGetId, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFICompletedTx, jniGetIdU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTx, jniGetDestinationPublicKey, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTx, jniGetSourcePublicKey, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTx, jniGetTransactionKernel, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTx, jniGetAmount, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFICompletedTx, jniGetAmountU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTx, jniGetFee, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFICompletedTx, jniGetFeeU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTx, jniGetTimestamp, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFICompletedTx, jniGetTimestampU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTx, jniGetMessage, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFICompletedTx, jniGetPaymentId, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFICompletedTx, jniGetStatus, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFICompletedTx, jniGetConfirmationCount, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFICompletedTx, jniGetConfirmationCountU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFICompletedTx, jniIsOutbound, "(" FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFICompletedTx, jniDestroy, "()V"),
+        NATIVE_METHOD(FFICompletedTx, jniGetCancellationReason, "(" FFI_ERROR ")I"),
+};
+
+jint RegisterCompletedTransactionNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFICompletedTx"), ffiCompletedTxMethods, NELEM(ffiCompletedTxMethods));
+}
@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcess(
         JNIEnv *jEnv,
         jobject jThis,
@@ -48,14 +48,14 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcess(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pKernel = GetPointerField<TariTransactionKernel *>(jEnv, jThis);
         const char *pStr = transaction_kernel_get_excess_hex(pKernel, errorPointer);
-        jstring result = jEnv->NewStringUTF(pStr);
+        jstring result = NewJavaString(jEnv, pStr);
         string_destroy(const_cast<char *>(pStr));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcessPublicNonce(
         JNIEnv *jEnv,
         jobject jThis,
@@ -63,14 +63,14 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcessPublicNonce(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pKernel = GetPointerField<TariTransactionKernel *>(jEnv, jThis);
         const char *pStr = transaction_kernel_get_excess_public_nonce_hex(pKernel, errorPointer);
-        jstring result = jEnv->NewStringUTF(pStr);
+        jstring result = NewJavaString(jEnv, pStr);
         string_destroy(const_cast<char *>(pStr));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcessSignature(
         JNIEnv *jEnv,
         jobject jThis,
@@ -78,17 +78,28 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcessSignature(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pKernel = GetPointerField<TariTransactionKernel *>(jEnv, jThis);
         const char *pStr = transaction_kernel_get_excess_signature_hex(pKernel, errorPointer);
-        jstring result = jEnv->NewStringUTF(pStr);
+        jstring result = NewJavaString(jEnv, pStr);
         string_destroy(const_cast<char *>(pStr));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     transaction_kernel_destroy(GetPointerField<TariTransactionKernel *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiCompletedTxKernelMethods[] = {
+        NATIVE_METHOD(FFICompletedTxKernel, jniGetExcess, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFICompletedTxKernel, jniGetExcessPublicNonce, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFICompletedTxKernel, jniGetExcessSignature, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFICompletedTxKernel, jniDestroy, "()V"),
+};
+
+jint RegisterCompletedTransactionKernelNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFICompletedTxKernel"), ffiCompletedTxKernelMethods, NELEM(ffiCompletedTxKernelMethods));
+}
@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIContact_jniCreate(
         JNIEnv *jEnv,
         jobject jThis,
@@ -49,16 +49,18 @@ Java_com_tari_android_wallet_ffi_FFIContact_jniCreate(
         jobject jPublicKey,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        const char *pAlias = jEnv->GetStringUTFChars(jAlias, JNI_FALSE);
+        JavaStringUtf8 alias(jEnv, jAlias);
+        if (!CheckJavaString(alias, errorPointer)) {
+            return;
+        }
         auto pTariWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jPublicKey);
-        TariContact *pContact = contact_create(pAlias, pTariWalletAddress, jIsFavorite, errorPointer);
-        jEnv->ReleaseStringUTFChars(jAlias, pAlias);
+        TariContact *pContact = contact_create(alias.c_str(), pTariWalletAddress, jIsFavorite, errorPointer);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pContact));
     });
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFIContact_jniGetAlias(
         JNIEnv *jEnv,
         jobject jThis,
@@ -66,14 +68,14 @@ Java_com_tari_android_wallet_ffi_FFIContact_jniGetAlias(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pContact = GetPointerField<TariContact *>(jEnv, jThis);
         const char *pAlias = contact_get_alias(pContact, errorPointer);
-        jstring result = jEnv->NewStringUTF(pAlias);
+        jstring result = NewJavaString(jEnv, pAlias);
         string_destroy(const_cast<char *>(pAlias));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFIContact_jniGetIsFavorite(
         JNIEnv *jEnv,
         jobject jThis,
@@ -86,7 +88,7 @@ Java_com_tari_android_wallet_ffi_FFIContact_jniGetIsFavorite(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIContact_jniGetTariWalletAddress(
         JNIEnv *jEnv,
         jobject jThis,
@@ -98,10 +100,22 @@ Java_com_tari_android_wallet_ffi_FFIContact_jniGetTariWalletAddress(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIContact_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     contact_destroy(GetPointerField<TariContact *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
 }
+
+static const JNINativeMethod ffiContactMethods[] = {
+        NATIVE_METHOD(FFIContact, jniCreate, "(" JAVA_STRING "Z" FFI_TYPE("FFITariWalletAddress") FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIContact, jniGetAlias, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFIContact, jniGetIsFavorite, "(" FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIContact, jniGetTariWalletAddress, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIContact, jniDestroy, "()V"),
+};
+
+jint RegisterContactNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIContact"), ffiContactMethods, NELEM(ffiContactMethods));
+}
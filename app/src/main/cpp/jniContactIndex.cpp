@@ -0,0 +1,172 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <wallet.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "jniCommon.cpp"
+#include "jniContactIndex.h"
+
+static std::mutex contactIndexMutex;
+static bool contactIndexBuilt = false;
+static std::unordered_map<std::string, ContactIndexEntry> contactIndex;
+
+static bool ReadContact(TariContact *pContact, std::string *pAddressBytes, ContactIndexEntry *pEntry, int *errorPointer) {
+    TariWalletAddress *pAddress = contact_get_tari_address(pContact, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    bool read = GetAddressBytes(pAddress, pAddressBytes, errorPointer);
+    if (read) {
+        char *pEmojiId = tari_address_to_emoji_id(pAddress, errorPointer);
+        if (*errorPointer == 0) {
+            pEntry->emojiId = pEmojiId;
+        }
+        string_destroy(pEmojiId);
+    }
+    tari_address_destroy(pAddress);
+    if (*errorPointer != 0) {
+        return false;
+    }
+
+    char *pAlias = contact_get_alias(pContact, errorPointer);
+    if (*errorPointer == 0) {
+        pEntry->alias = pAlias;
+    }
+    string_destroy(pAlias);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    pEntry->favourite = contact_get_favourite(pContact, errorPointer);
+    return *errorPointer == 0;
+}
+
+// called with contactIndexMutex held
+static bool BuildContactIndex(TariWallet *pWallet, int *errorPointer) {
+    TariContacts *pContacts = wallet_get_contacts(pWallet, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    unsigned int length = contacts_get_length(pContacts, errorPointer);
+    std::unordered_map<std::string, ContactIndexEntry> index(length);
+    for (unsigned int i = 0; *errorPointer == 0 && i < length; i++) {
+        TariContact *pContact = contacts_get_at(pContacts, i, errorPointer);
+        if (*errorPointer != 0) {
+            break;
+        }
+        std::string addressBytes;
+        ContactIndexEntry entry;
+        if (ReadContact(pContact, &addressBytes, &entry, errorPointer)) {
+            index[std::move(addressBytes)] = std::move(entry);
+        }
+        contact_destroy(pContact);
+    }
+    contacts_destroy(pContacts);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    contactIndex.swap(index);
+    contactIndexBuilt = true;
+    LOGI("Contact index built with %zu contacts", contactIndex.size());
+    return true;
+}
+
+bool GetAddressBytes(TariWalletAddress *pAddress, std::string *pBytes, int *errorPointer) {
+    ByteVector *pByteVector = tari_address_get_bytes(pAddress, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    std::vector<unsigned char> bytes;
+    bool copied = AppendByteVector(pByteVector, bytes, errorPointer);
+    byte_vector_destroy(pByteVector);
+    if (copied) {
+        pBytes->assign(bytes.begin(), bytes.end());
+    }
+    return copied;
+}
+
+bool FindIndexedContact(TariWallet *pWallet, const std::string &addressBytes, ContactIndexEntry *pEntry, int *errorPointer) {
+    std::lock_guard<std::mutex> lock(contactIndexMutex);
+    if (!contactIndexBuilt && !BuildContactIndex(pWallet, errorPointer)) {
+        return false;
+    }
+    auto found = contactIndex.find(addressBytes);
+    if (found == contactIndex.end()) {
+        return false;
+    }
+    *pEntry = found->second;
+    return true;
+}
+
+void IndexUpsertedContact(TariContact *pContact) {
+    std::lock_guard<std::mutex> lock(contactIndexMutex);
+    if (!contactIndexBuilt) {
+        return;
+    }
+    int error = 0;
+    std::string addressBytes;
+    ContactIndexEntry entry;
+    if (ReadContact(pContact, &addressBytes, &entry, &error)) {
+        contactIndex[std::move(addressBytes)] = std::move(entry);
+    } else {
+        // can't tell which entry changed, start over on the next lookup
+        contactIndex.clear();
+        contactIndexBuilt = false;
+    }
+}
+
+void IndexRemovedContact(TariContact *pContact) {
+    int error = 0;
+    TariWalletAddress *pAddress = contact_get_tari_address(pContact, &error);
+    std::string addressBytes;
+    bool read = error == 0 && GetAddressBytes(pAddress, &addressBytes, &error);
+    tari_address_destroy(pAddress);
+    if (read) {
+        RemoveIndexedContact(addressBytes);
+    } else {
+        ClearContactIndex();
+    }
+}
+
+void RemoveIndexedContact(const std::string &addressBytes) {
+    std::lock_guard<std::mutex> lock(contactIndexMutex);
+    contactIndex.erase(addressBytes);
+}
+
+void ClearContactIndex() {
+    std::lock_guard<std::mutex> lock(contactIndexMutex);
+    contactIndex.clear();
+    contactIndexBuilt = false;
+}
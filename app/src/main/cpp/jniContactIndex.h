@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <string>
+
+// uses the wallet.h types, include after wallet.h
+
+/**
+ * What the contact index keeps per address: enough to rebuild the TariContact for lookups and removal.
+ */
+struct ContactIndexEntry {
+    std::string alias;
+    bool favourite;
+    std::string emojiId;
+};
+
+/**
+ * Looks up a contact by its address bytes. The index is built from wallet_get_contacts on first use
+ * and kept current through IndexUpsertedContact and IndexRemovedContact afterwards.
+ * Returns false if there is no such contact or the index could not be built (errorPointer is set).
+ */
+bool FindIndexedContact(TariWallet *pWallet, const std::string &addressBytes, ContactIndexEntry *pEntry, int *errorPointer);
+
+/**
+ * Call after wallet_upsert_contact or wallet_remove_contact succeeded.
+ */
+void IndexUpsertedContact(TariContact *pContact);
+
+void IndexRemovedContact(TariContact *pContact);
+
+void RemoveIndexedContact(const std::string &addressBytes);
+
+/**
+ * Drops the index, e.g. when the wallet is destroyed. It is rebuilt on the next lookup.
+ */
+void ClearContactIndex();
+
+/**
+ * The bytes the index is keyed by.
+ */
+bool GetAddressBytes(TariWalletAddress *pAddress, std::string *pBytes, int *errorPointer);
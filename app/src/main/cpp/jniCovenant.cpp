@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFICovenant_jniCreateFromBytes(
         JNIEnv *jEnv,
         jobject jThis,
@@ -54,10 +54,19 @@ Java_com_tari_android_wallet_ffi_FFICovenant_jniCreateFromBytes(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFICovenant_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     covenant_destroy(GetPointerField<TariCovenant *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiCovenantMethods[] = {
+        NATIVE_METHOD(FFICovenant, jniCreateFromBytes, "(" FFI_TYPE("FFIByteVector") FFI_ERROR ")V"),
+        NATIVE_METHOD(FFICovenant, jniDestroy, "()V"),
+};
+
+jint RegisterCovenantNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFICovenant"), ffiCovenantMethods, NELEM(ffiCovenantMethods));
+}
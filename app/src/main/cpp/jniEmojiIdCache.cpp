@@ -0,0 +1,267 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <wallet.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "jniCommon.cpp"
+#include "jniContactIndex.h"
+#include "jniEmojiIdCache.h"
+
+// address and key bytes never collide in practice, the prefix makes sure they can't
+static const char AddressKeyPrefix = 'a';
+static const char PublicKeyKeyPrefix = 'k';
+
+struct EmojiIdCacheEntry {
+    std::string key;
+    jstring emojiId; // global reference
+};
+
+static std::mutex emojiIdCacheMutex;
+static std::list<EmojiIdCacheEntry> emojiIdCacheEntries; // most recently used first
+static std::unordered_map<std::string, std::list<EmojiIdCacheEntry>::iterator> emojiIdCacheIndex;
+static size_t emojiIdCacheCapacity = DefaultEmojiIdCacheCapacity;
+static jlong emojiIdCacheHits = 0;
+static jlong emojiIdCacheMisses = 0;
+static jlong emojiIdCacheEvictions = 0;
+
+// called with emojiIdCacheMutex held
+static void EvictEmojiIds(JNIEnv *jEnv, size_t capacity) {
+    while (emojiIdCacheEntries.size() > capacity) {
+        EmojiIdCacheEntry &entry = emojiIdCacheEntries.back();
+        jEnv->DeleteGlobalRef(entry.emojiId);
+        emojiIdCacheIndex.erase(entry.key);
+        emojiIdCacheEntries.pop_back();
+        emojiIdCacheEvictions++;
+    }
+}
+
+static jstring FindEmojiId(JNIEnv *jEnv, const std::string &key) {
+    std::lock_guard<std::mutex> lock(emojiIdCacheMutex);
+    auto found = emojiIdCacheIndex.find(key);
+    if (found == emojiIdCacheIndex.end()) {
+        emojiIdCacheMisses++;
+        return nullptr;
+    }
+    emojiIdCacheHits++;
+    emojiIdCacheEntries.splice(emojiIdCacheEntries.begin(), emojiIdCacheEntries, found->second);
+    return static_cast<jstring>(jEnv->NewLocalRef(found->second->emojiId));
+}
+
+static void InsertEmojiId(JNIEnv *jEnv, const std::string &key, jstring emojiId) {
+    std::lock_guard<std::mutex> lock(emojiIdCacheMutex);
+    // another thread may have converted the same address in the meantime
+    if (emojiIdCacheCapacity == 0 || emojiIdCacheIndex.count(key) != 0) {
+        return;
+    }
+    auto globalEmojiId = static_cast<jstring>(jEnv->NewGlobalRef(emojiId));
+    if (globalEmojiId == nullptr) {
+        return;
+    }
+    emojiIdCacheEntries.push_front(EmojiIdCacheEntry{key, globalEmojiId});
+    emojiIdCacheIndex[key] = emojiIdCacheEntries.begin();
+    EvictEmojiIds(jEnv, emojiIdCacheCapacity);
+}
+
+// looks key up, converts with convert (a library call returning a string to free) on a miss
+template <typename F>
+static jstring GetOrConvertEmojiId(JNIEnv *jEnv, const std::string &key, int *errorPointer, F &&convert) {
+    jstring emojiId = FindEmojiId(jEnv, key);
+    if (emojiId != nullptr) {
+        return emojiId;
+    }
+    char *pEmojiId = convert(errorPointer);
+    if (*errorPointer != 0) {
+        if (pEmojiId != nullptr) {
+            string_destroy(pEmojiId);
+        }
+        return nullptr;
+    }
+    emojiId = NewJavaString(jEnv, pEmojiId);
+    bool converted = pEmojiId != nullptr;
+    string_destroy(pEmojiId);
+    if (emojiId == nullptr) {
+        if (converted) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+        } else {
+            *errorPointer = UnexpectedLibraryDataErrorCode;
+        }
+        return nullptr;
+    }
+    InsertEmojiId(jEnv, key, emojiId);
+    return emojiId;
+}
+
+jstring GetAddressEmojiId(JNIEnv *jEnv, TariWalletAddress *pAddress, const std::string &addressBytes, int *errorPointer) {
+    return GetOrConvertEmojiId(jEnv, AddressKeyPrefix + addressBytes, errorPointer, [&](int *convertError) {
+        return tari_address_to_emoji_id(pAddress, convertError);
+    });
+}
+
+jstring GetAddressEmojiId(JNIEnv *jEnv, TariWalletAddress *pAddress, int *errorPointer) {
+    std::string addressBytes;
+    if (!GetAddressBytes(pAddress, &addressBytes, errorPointer)) {
+        return nullptr;
+    }
+    return GetAddressEmojiId(jEnv, pAddress, addressBytes, errorPointer);
+}
+
+jstring GetAddressBytesEmojiId(JNIEnv *jEnv, const std::string &addressBytes, int *errorPointer) {
+    return GetOrConvertEmojiId(jEnv, AddressKeyPrefix + addressBytes, errorPointer, [&](int *convertError) -> char * {
+        ByteVector *pBytes = byte_vector_create(reinterpret_cast<const unsigned char *>(addressBytes.data()),
+                                                static_cast<unsigned int>(addressBytes.size()), convertError);
+        if (*convertError != 0) {
+            return nullptr;
+        }
+        TariWalletAddress *pAddress = tari_address_create(pBytes, convertError);
+        byte_vector_destroy(pBytes);
+        if (*convertError != 0) {
+            return nullptr;
+        }
+        char *pEmojiId = tari_address_to_emoji_id(pAddress, convertError);
+        tari_address_destroy(pAddress);
+        return pEmojiId;
+    });
+}
+
+jstring GetPublicKeyEmojis(JNIEnv *jEnv, TariPublicKey *pKey, int *errorPointer) {
+    ByteVector *pKeyBytes = public_key_get_bytes(pKey, errorPointer);
+    if (*errorPointer != 0) {
+        return nullptr;
+    }
+    std::vector<unsigned char> keyBytes;
+    bool copied = AppendByteVector(pKeyBytes, keyBytes, errorPointer);
+    byte_vector_destroy(pKeyBytes);
+    if (!copied) {
+        return nullptr;
+    }
+    std::string key(1, PublicKeyKeyPrefix);
+    key.append(keyBytes.begin(), keyBytes.end());
+    return GetOrConvertEmojiId(jEnv, key, errorPointer, [&](int *convertError) {
+        return public_key_get_emoji_encoding(pKey, convertError);
+    });
+}
+
+void SetEmojiIdCacheCapacity(JNIEnv *jEnv, size_t capacity) {
+    std::lock_guard<std::mutex> lock(emojiIdCacheMutex);
+    emojiIdCacheCapacity = capacity;
+    EvictEmojiIds(jEnv, capacity);
+}
+
+void GetEmojiIdCacheStats(jlong *stats) {
+    std::lock_guard<std::mutex> lock(emojiIdCacheMutex);
+    stats[0] = static_cast<jlong>(emojiIdCacheCapacity);
+    stats[1] = static_cast<jlong>(emojiIdCacheEntries.size());
+    stats[2] = emojiIdCacheHits;
+    stats[3] = emojiIdCacheMisses;
+    stats[4] = emojiIdCacheEvictions;
+}
+
+extern "C"
+jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIEmojiIdCache_jniGetEmojiIds(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jAddresses,
+        jobject error) {
+    return ExecuteWithError<jobjectArray>(jEnv, error, [&](int *errorPointer) -> jobjectArray {
+        jsize count = jEnv->GetArrayLength(jAddresses);
+        jobjectArray result = jEnv->NewObjectArray(count, GetJniIds().stringClass, nullptr);
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        std::string addressBytes;
+        for (jsize i = 0; i < count; i++) {
+            auto jBytes = static_cast<jbyteArray>(jEnv->GetObjectArrayElement(jAddresses, i));
+            if (jBytes == nullptr) {
+                continue;
+            }
+            addressBytes.resize(static_cast<size_t>(jEnv->GetArrayLength(jBytes)));
+            jEnv->GetByteArrayRegion(jBytes, 0, static_cast<jsize>(addressBytes.size()), reinterpret_cast<jbyte *>(&addressBytes[0]));
+            jEnv->DeleteLocalRef(jBytes);
+            // an address the library rejects is left null rather than failing the whole batch, running
+            // out of memory ends it
+            int addressError = 0;
+            jstring emojiId = GetAddressBytesEmojiId(jEnv, addressBytes, &addressError);
+            if (addressError == OutOfMemoryErrorCode) {
+                jEnv->DeleteLocalRef(result);
+                *errorPointer = OutOfMemoryErrorCode;
+                return nullptr;
+            }
+            if (emojiId != nullptr) {
+                jEnv->SetObjectArrayElement(result, i, emojiId);
+                jEnv->DeleteLocalRef(emojiId);
+            }
+        }
+        return result;
+    });
+}
+
+extern "C"
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFIEmojiIdCache_jniSetCapacity(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jint capacity) {
+    SetEmojiIdCacheCapacity(jEnv, capacity > 0 ? static_cast<size_t>(capacity) : 0);
+}
+
+extern "C"
+jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIEmojiIdCache_jniGetStats(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    jlong stats[EmojiIdCacheStatsCount];
+    GetEmojiIdCacheStats(stats);
+    jlongArray result = jEnv->NewLongArray(EmojiIdCacheStatsCount);
+    if (result != nullptr) {
+        jEnv->SetLongArrayRegion(result, 0, EmojiIdCacheStatsCount, stats);
+    }
+    return result;
+}
+
+static const JNINativeMethod ffiEmojiIdCacheMethods[] = {
+        NATIVE_METHOD(FFIEmojiIdCache, jniGetEmojiIds, "([[B" FFI_ERROR ")[" JAVA_STRING),
+        NATIVE_METHOD(FFIEmojiIdCache, jniSetCapacity, "(I)V"),
+        NATIVE_METHOD(FFIEmojiIdCache, jniGetStats, "()[J"),
+};
+
+jint RegisterEmojiIdCacheNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIEmojiIdCache"), ffiEmojiIdCacheMethods, NELEM(ffiEmojiIdCacheMethods));
+}
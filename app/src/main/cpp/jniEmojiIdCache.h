@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <jni.h>
+#include <cstddef>
+#include <string>
+
+// uses the wallet.h types, include after wallet.h
+
+/**
+ * Size-bounded LRU cache of emoji ids keyed by address bytes, and of public key emoji encodings
+ * keyed by key bytes. Entries hold a global reference to the Java string, so a hit costs neither
+ * a library call nor a string allocation. Safe to call from any thread.
+ *
+ * The getters return a new local reference, or null with errorPointer set (OutOfMemoryErrorCode,
+ * with the exception cleared, if the Java string could not be allocated).
+ */
+jstring GetAddressEmojiId(JNIEnv *jEnv, TariWalletAddress *pAddress, const std::string &addressBytes, int *errorPointer);
+
+jstring GetAddressEmojiId(JNIEnv *jEnv, TariWalletAddress *pAddress, int *errorPointer);
+
+/**
+ * For callers that only have the bytes; the address is only created on a miss.
+ */
+jstring GetAddressBytesEmojiId(JNIEnv *jEnv, const std::string &addressBytes, int *errorPointer);
+
+jstring GetPublicKeyEmojis(JNIEnv *jEnv, TariPublicKey *pKey, int *errorPointer);
+
+const size_t DefaultEmojiIdCacheCapacity = 1024;
+
+/**
+ * Evicts the least recently used entries down to the new capacity. 0 disables the cache.
+ */
+void SetEmojiIdCacheCapacity(JNIEnv *jEnv, size_t capacity);
+
+/**
+ * Number of values written by GetEmojiIdCacheStats: {capacity, size, hits, misses, evictions}.
+ */
+const int EmojiIdCacheStatsCount = 5;
+
+void GetEmojiIdCacheStats(jlong *stats);
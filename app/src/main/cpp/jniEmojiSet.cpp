@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniCreate(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -49,7 +49,7 @@ Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniCreate(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -61,7 +61,7 @@ Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -74,10 +74,21 @@ Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniGetAt(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     emoji_set_destroy(GetPointerField<EmojiSet *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiEmojiSetMethods[] = {
+        NATIVE_METHOD(FFIEmojiSet, jniCreate, "()V"),
+        NATIVE_METHOD(FFIEmojiSet, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIEmojiSet, jniGetAt, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIEmojiSet, jniDestroy, "()V"),
+};
+
+jint RegisterEmojiSetNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIEmojiSet"), ffiEmojiSetMethods, NELEM(ffiEmojiSetMethods));
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <wallet.h>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "jniCommon.cpp"
+#include "jniFeeEstimateCache.h"
+
+// distinct amounts typed between two balance updates, the memo starts over when it is full
+static const size_t FeeEstimateCacheCapacity = 256;
+
+struct FeeEstimateKey {
+    unsigned long long amount;
+    unsigned long long feePerGram;
+    unsigned long long kernelCount;
+    unsigned long long outputCount;
+
+    bool operator==(const FeeEstimateKey &other) const {
+        return amount == other.amount && feePerGram == other.feePerGram &&
+               kernelCount == other.kernelCount && outputCount == other.outputCount;
+    }
+};
+
+struct FeeEstimateKeyHash {
+    size_t operator()(const FeeEstimateKey &key) const {
+        uint64_t hash = key.amount;
+        hash = hash * 0x9E3779B97F4A7C15ull ^ key.feePerGram;
+        hash = hash * 0x9E3779B97F4A7C15ull ^ key.kernelCount;
+        hash = hash * 0x9E3779B97F4A7C15ull ^ key.outputCount;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
+static std::mutex feeEstimateMutex;
+static std::unordered_map<FeeEstimateKey, unsigned long long, FeeEstimateKeyHash> feeEstimates;
+// bumped by every invalidation, an estimate is only stored if it did not change while it ran
+static uint64_t feeEstimateGeneration = 0;
+static jlong feeEstimateHits = 0;
+static jlong feeEstimateMisses = 0;
+static jlong feeEstimateInvalidations = 0;
+
+unsigned long long EstimateTxFee(
+        TariWallet *pWallet,
+        unsigned long long amount,
+        unsigned long long feePerGram,
+        unsigned long long kernelCount,
+        unsigned long long outputCount,
+        int *errorPointer) {
+    FeeEstimateKey key{amount, feePerGram, kernelCount, outputCount};
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(feeEstimateMutex);
+        auto found = feeEstimates.find(key);
+        if (found != feeEstimates.end()) {
+            feeEstimateHits++;
+            *errorPointer = 0;
+            return found->second;
+        }
+        feeEstimateMisses++;
+        generation = feeEstimateGeneration;
+    }
+    // coin selection can take a while, don't hold the lock over it
+    unsigned long long fee = wallet_get_fee_estimate(pWallet, amount, nullptr, feePerGram, kernelCount, outputCount, errorPointer);
+    // failures (e.g. not enough funds) are not memoised, they are cheap and depend on more than the key
+    if (*errorPointer == 0) {
+        std::lock_guard<std::mutex> lock(feeEstimateMutex);
+        if (generation == feeEstimateGeneration) {
+            if (feeEstimates.size() >= FeeEstimateCacheCapacity) {
+                feeEstimates.clear();
+            }
+            feeEstimates[key] = fee;
+        }
+    }
+    return fee;
+}
+
+void InvalidateFeeEstimates() {
+    std::lock_guard<std::mutex> lock(feeEstimateMutex);
+    feeEstimates.clear();
+    feeEstimateGeneration++;
+    feeEstimateInvalidations++;
+}
+
+void GetFeeEstimateCacheStats(jlong *stats) {
+    std::lock_guard<std::mutex> lock(feeEstimateMutex);
+    stats[0] = static_cast<jlong>(feeEstimates.size());
+    stats[1] = feeEstimateHits;
+    stats[2] = feeEstimateMisses;
+    stats[3] = feeEstimateInvalidations;
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+// uses the wallet.h types, include after wallet.h
+
+/**
+ * Memo of wallet_get_fee_estimate results keyed by (amount, fee per gram, kernel count, output count).
+ * Every estimate runs coin selection over the unspent outputs, and the send screen asks for the same
+ * amount at several fee rates each time the amount changes. The memo is only valid for one set of
+ * spendable outputs, so the callbacks that change it call InvalidateFeeEstimates.
+ */
+unsigned long long EstimateTxFee(
+        TariWallet *pWallet,
+        unsigned long long amount,
+        unsigned long long feePerGram,
+        unsigned long long kernelCount,
+        unsigned long long outputCount,
+        int *errorPointer);
+
+/**
+ * Call when the spendable outputs may have changed: balance updates, txs mined, confirmed or
+ * cancelled, and txs sent. An estimate that was running meanwhile is returned but not memoised.
+ */
+void InvalidateFeeEstimates();
+
+/**
+ * Number of values written by GetFeeEstimateCacheStats: {size, hits, misses, invalidations}.
+ */
+const int FeeEstimateCacheStatsCount = 4;
+
+void GetFeeEstimateCacheStats(jlong *stats);
@@ -0,0 +1,286 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <vector>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "jniCommon.cpp"
+#include "jniHex.h"
+
+static const char lowerHexDigits[] = "0123456789abcdef";
+static const char upperHexDigits[] = "0123456789ABCDEF";
+
+static inline int HexDigitValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static void HexEncodeScalar(const unsigned char *bytes, size_t size, char *hex, bool upperCase) {
+    const char *digits = upperCase ? upperHexDigits : lowerHexDigits;
+    for (size_t i = 0; i < size; i++) {
+        hex[2 * i] = digits[bytes[i] >> 4];
+        hex[2 * i + 1] = digits[bytes[i] & 0x0F];
+    }
+}
+
+static bool HexDecodeScalar(const char *hex, size_t size, unsigned char *out) {
+    for (size_t i = 0; i < size; i++) {
+        int high = HexDigitValue(hex[2 * i]);
+        int low = high < 0 ? -1 : HexDigitValue(hex[2 * i + 1]);
+        if (low < 0) {
+            return false;
+        }
+        out[i] = static_cast<unsigned char>((high << 4) | low);
+    }
+    return true;
+}
+
+// The vector paths map a nibble n to '0' + n, plus the distance from '9' + 1 to 'a' (or 'A') when
+// n > 9. Decoding goes the other way: c - '0' is a digit if it is at most 9, (c | 0x20) - 'a' is a
+// letter of either case if it is at most 5, anything else makes the whole block invalid.
+static const unsigned char LowerLetterOffset = 'a' - '0' - 10;
+static const unsigned char UpperLetterOffset = 'A' - '0' - 10;
+
+#if defined(__ARM_NEON)
+
+static inline uint8x16_t NibblesToHex(uint8x16_t nibbles, uint8x16_t letterOffset) {
+    uint8x16_t isLetter = vcgtq_u8(nibbles, vdupq_n_u8(9));
+    return vaddq_u8(vaddq_u8(nibbles, vdupq_n_u8('0')), vandq_u8(isLetter, letterOffset));
+}
+
+// returns the nibble of every char and sets the lanes that are not hex in invalid
+static inline uint8x16_t HexToNibbles(uint8x16_t chars, uint8x16_t *invalid) {
+    uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+    uint8x16_t letter = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+    uint8x16_t isLetter = vcleq_u8(letter, vdupq_n_u8(5));
+    *invalid = vorrq_u8(*invalid, vmvnq_u8(vorrq_u8(isDigit, isLetter)));
+    return vbslq_u8(isDigit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+}
+
+void HexEncode(const unsigned char *bytes, size_t size, char *hex, bool upperCase) {
+    const uint8x16_t letterOffset = vdupq_n_u8(upperCase ? UpperLetterOffset : LowerLetterOffset);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t block = vld1q_u8(bytes + i);
+        uint8x16x2_t chars;
+        chars.val[0] = NibblesToHex(vshrq_n_u8(block, 4), letterOffset);
+        chars.val[1] = NibblesToHex(vandq_u8(block, vdupq_n_u8(0x0F)), letterOffset);
+        vst2q_u8(reinterpret_cast<uint8_t *>(hex + 2 * i), chars);
+    }
+    HexEncodeScalar(bytes + i, size - i, hex + 2 * i, upperCase);
+}
+
+bool HexDecode(const char *hex, size_t size, unsigned char *out) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t *>(hex + 2 * i));
+        uint8x16_t invalid = vdupq_n_u8(0);
+        uint8x16_t high = HexToNibbles(chars.val[0], &invalid);
+        uint8x16_t low = HexToNibbles(chars.val[1], &invalid);
+        uint64x2_t invalidLanes = vreinterpretq_u64_u8(invalid);
+        if ((vgetq_lane_u64(invalidLanes, 0) | vgetq_lane_u64(invalidLanes, 1)) != 0) {
+            return false;
+        }
+        vst1q_u8(out + i, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+    return HexDecodeScalar(hex + 2 * i, size - i, out + i);
+}
+
+#elif defined(__SSE2__)
+
+static inline __m128i NibblesToHex(__m128i nibbles, __m128i letterOffset) {
+    __m128i isLetter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), _mm_and_si128(isLetter, letterOffset));
+}
+
+// unsigned a <= b, SSE2 only compares signed bytes
+static inline __m128i LessOrEqual(__m128i a, __m128i b) {
+    return _mm_cmpeq_epi8(_mm_min_epu8(a, b), a);
+}
+
+static inline __m128i HexToNibbles(__m128i chars, __m128i *valid) {
+    __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i isDigit = LessOrEqual(digit, _mm_set1_epi8(9));
+    __m128i isLetter = LessOrEqual(letter, _mm_set1_epi8(5));
+    *valid = _mm_and_si128(*valid, _mm_or_si128(isDigit, isLetter));
+    return _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_andnot_si128(isDigit, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+// 16 chars are 8 (high, low) nibble pairs; each 16 bit lane becomes (high << 4) | low
+static inline __m128i PackNibblePairs(__m128i nibbles) {
+    __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+    return _mm_or_si128(high, _mm_srli_epi16(nibbles, 8));
+}
+
+void HexEncode(const unsigned char *bytes, size_t size, char *hex, bool upperCase) {
+    const __m128i letterOffset = _mm_set1_epi8(static_cast<char>(upperCase ? UpperLetterOffset : LowerLetterOffset));
+    const __m128i lowNibbleMask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+        __m128i high = NibblesToHex(_mm_and_si128(_mm_srli_epi16(block, 4), lowNibbleMask), letterOffset);
+        __m128i low = NibblesToHex(_mm_and_si128(block, lowNibbleMask), letterOffset);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hex + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hex + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    HexEncodeScalar(bytes + i, size - i, hex + 2 * i, upperCase);
+}
+
+bool HexDecode(const char *hex, size_t size, unsigned char *out) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i valid = _mm_set1_epi8(-1);
+        __m128i first = HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hex + 2 * i)), &valid);
+        __m128i second = HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hex + 2 * i + 16)), &valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF) {
+            return false;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(PackNibblePairs(first), PackNibblePairs(second)));
+    }
+    return HexDecodeScalar(hex + 2 * i, size - i, out + i);
+}
+
+#else
+
+void HexEncode(const unsigned char *bytes, size_t size, char *hex, bool upperCase) {
+    HexEncodeScalar(bytes, size, hex, upperCase);
+}
+
+bool HexDecode(const char *hex, size_t size, unsigned char *out) {
+    return HexDecodeScalar(hex, size, out);
+}
+
+#endif
+
+extern "C"
+jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIHex_jniEncode(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jbyteArray jBytes,
+        jint recordSize,
+        jboolean upperCase,
+        jobject error) {
+    return ExecuteWithError<jobjectArray>(jEnv, error, [&](int *errorPointer) -> jobjectArray {
+        jsize size = jEnv->GetArrayLength(jBytes);
+        if (recordSize <= 0 || size % recordSize != 0) {
+            *errorPointer = InvalidArgumentErrorCode;
+            return nullptr;
+        }
+        jsize count = size / recordSize;
+        jobjectArray result = jEnv->NewObjectArray(count, GetJniIds().stringClass, nullptr);
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        std::vector<unsigned char> bytes(static_cast<size_t>(size));
+        jEnv->GetByteArrayRegion(jBytes, 0, size, reinterpret_cast<jbyte *>(bytes.data()));
+        std::vector<char> hex(2 * static_cast<size_t>(recordSize));
+        for (jsize i = 0; i < count; i++) {
+            HexEncode(bytes.data() + static_cast<size_t>(i) * recordSize, static_cast<size_t>(recordSize), hex.data(), upperCase == JNI_TRUE);
+            jstring jHex = NewJavaString(jEnv, hex.data(), 2 * static_cast<size_t>(recordSize));
+            if (jHex == nullptr) {
+                jEnv->ExceptionClear();
+                *errorPointer = OutOfMemoryErrorCode;
+                return nullptr;
+            }
+            jEnv->SetObjectArrayElement(result, i, jHex);
+            jEnv->DeleteLocalRef(jHex);
+        }
+        return result;
+    });
+}
+
+extern "C"
+jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIHex_jniDecode(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jHexStrings,
+        jint recordSize,
+        jobject error) {
+    return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) -> jbyteArray {
+        jsize count = jEnv->GetArrayLength(jHexStrings);
+        if (recordSize < 0 || (recordSize > 0 && count > INT_MAX / recordSize)) {
+            *errorPointer = InvalidArgumentErrorCode;
+            return nullptr;
+        }
+        auto hexLength = 2 * static_cast<size_t>(recordSize);
+        std::vector<unsigned char> bytes(static_cast<size_t>(count) * recordSize);
+        std::vector<jchar> chars(hexLength);
+        std::vector<char> hex(hexLength);
+        for (jsize i = 0; i < count; i++) {
+            auto jHex = static_cast<jstring>(jEnv->GetObjectArrayElement(jHexStrings, i));
+            bool sized = jHex != nullptr && static_cast<size_t>(jEnv->GetStringLength(jHex)) == hexLength;
+            if (sized) {
+                jEnv->GetStringRegion(jHex, 0, static_cast<jsize>(hexLength), chars.data());
+            }
+            jEnv->DeleteLocalRef(jHex);
+            if (!sized) {
+                return nullptr;
+            }
+            // anything outside ASCII becomes a NUL, which HexDecode rejects
+            for (size_t j = 0; j < hexLength; j++) {
+                hex[j] = chars[j] < 0x80 ? static_cast<char>(chars[j]) : '\0';
+            }
+            if (!HexDecode(hex.data(), static_cast<size_t>(recordSize), bytes.data() + static_cast<size_t>(i) * recordSize)) {
+                return nullptr;
+            }
+        }
+        jbyteArray result = jEnv->NewByteArray(static_cast<jsize>(bytes.size()));
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        jEnv->SetByteArrayRegion(result, 0, static_cast<jsize>(bytes.size()), reinterpret_cast<const jbyte *>(bytes.data()));
+        return result;
+    });
+}
+
+static const JNINativeMethod ffiHexMethods[] = {
+        NATIVE_METHOD(FFIHex, jniEncode, "([BIZ" FFI_ERROR ")[" JAVA_STRING),
+        NATIVE_METHOD(FFIHex, jniDecode, "([" JAVA_STRING "I" FFI_ERROR ")[B"),
+};
+
+jint RegisterHexNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIHex"), ffiHexMethods, NELEM(ffiHexMethods));
+}
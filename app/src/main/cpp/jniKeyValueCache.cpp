@@ -0,0 +1,295 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <wallet.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "jniCommon.cpp"
+#include "jniKeyValueCache.h"
+
+// how long buffered writes wait for more to come before they are flushed
+static const std::chrono::milliseconds KeyValueFlushDelay(2000);
+
+struct CachedKeyValue {
+    std::string value;
+    bool dirty;
+};
+
+// lock order: keyValueStoreMutex, then keyValueMutex. keyValueStoreMutex serialises the database
+// calls, so a flush can't write a value over a later write-through or removal of the same key
+static std::mutex keyValueStoreMutex;
+static std::mutex keyValueMutex;
+static std::unordered_map<std::string, CachedKeyValue> keyValues;
+static size_t dirtyKeyValueCount = 0;
+static TariWallet *keyValueWallet = nullptr;
+
+static std::thread keyValueFlusher;
+static std::condition_variable keyValueFlusherWake;
+static bool keyValueFlusherRunning = false;
+static bool keyValueFlusherStopping = false;
+// first error of a background flush since the last commit, reported by the next commit
+static int keyValueFlushError = 0;
+
+static long long keyValueHits = 0;
+static long long keyValueMisses = 0;
+static long long bufferedKeyValueWrites = 0;
+static long long flushedKeyValueWrites = 0;
+static long long keyValueFlushes = 0;
+
+// called with keyValueMutex held
+static void StoreCachedKeyValue(const std::string &key, const std::string &value, bool dirty) {
+    CachedKeyValue &entry = keyValues[key];
+    if (entry.dirty && !dirty) {
+        dirtyKeyValueCount--;
+    } else if (!entry.dirty && dirty) {
+        dirtyKeyValueCount++;
+    }
+    entry.value = value;
+    entry.dirty = dirty;
+}
+
+// called with keyValueMutex held
+static void DropCachedKeyValue(const std::string &key) {
+    auto found = keyValues.find(key);
+    if (found != keyValues.end()) {
+        if (found->second.dirty) {
+            dirtyKeyValueCount--;
+        }
+        keyValues.erase(found);
+    }
+}
+
+// called with keyValueMutex held
+static bool FindCachedKeyValue(const std::string &key, std::string *pValue) {
+    auto found = keyValues.find(key);
+    if (found == keyValues.end()) {
+        return false;
+    }
+    *pValue = found->second.value;
+    return true;
+}
+
+static bool FlushKeyValues(TariWallet *pWallet, int *errorPointer) {
+    std::lock_guard<std::mutex> storeLock(keyValueStoreMutex);
+    std::vector<std::pair<std::string, std::string>> pending;
+    {
+        std::lock_guard<std::mutex> lock(keyValueMutex);
+        if (dirtyKeyValueCount == 0) {
+            return true;
+        }
+        pending.reserve(dirtyKeyValueCount);
+        for (auto &entry : keyValues) {
+            if (entry.second.dirty) {
+                pending.emplace_back(entry.first, entry.second.value);
+                entry.second.dirty = false;
+            }
+        }
+        dirtyKeyValueCount = 0;
+        keyValueFlushes++;
+    }
+    int firstError = 0;
+    for (const auto &keyValue : pending) {
+        int error = 0;
+        wallet_set_key_value(pWallet, keyValue.first.c_str(), keyValue.second.c_str(), &error);
+        std::lock_guard<std::mutex> lock(keyValueMutex);
+        if (error == 0) {
+            flushedKeyValueWrites++;
+            continue;
+        }
+        LOGE("Failed to write the value of key %s: %d", keyValue.first.c_str(), error);
+        if (firstError == 0) {
+            firstError = error;
+        }
+        // keep it buffered for the next flush, unless it was written again meanwhile
+        auto found = keyValues.find(keyValue.first);
+        if (found != keyValues.end() && !found->second.dirty) {
+            found->second.dirty = true;
+            dirtyKeyValueCount++;
+        }
+    }
+    *errorPointer = firstError;
+    return firstError == 0;
+}
+
+static void RunKeyValueFlusher() {
+    std::unique_lock<std::mutex> lock(keyValueMutex);
+    while (!keyValueFlusherStopping) {
+        if (dirtyKeyValueCount == 0) {
+            keyValueFlusherWake.wait(lock);
+            continue;
+        }
+        // the first buffered write starts the delay, the ones that follow it are flushed along with it
+        if (keyValueFlusherWake.wait_for(lock, KeyValueFlushDelay, [] { return keyValueFlusherStopping; })) {
+            break;
+        }
+        TariWallet *pWallet = keyValueWallet;
+        lock.unlock();
+        int error = 0;
+        bool flushed = FlushKeyValues(pWallet, &error);
+        lock.lock();
+        // the failed values are still dirty and retried after another delay
+        if (!flushed && keyValueFlushError == 0) {
+            keyValueFlushError = error;
+        }
+    }
+}
+
+// called with keyValueMutex held
+static void StartKeyValueFlusher() {
+    if (keyValueFlusherRunning) {
+        return;
+    }
+    keyValueFlusherStopping = false;
+    try {
+        keyValueFlusher = std::thread(RunKeyValueFlusher);
+        keyValueFlusherRunning = true;
+    } catch (const std::system_error &e) {
+        // buffered values are still written on commit and on close
+        LOGE("Failed to start the key value flusher: %s", e.what());
+    }
+}
+
+bool GetKeyValue(TariWallet *pWallet, const std::string &key, std::string *pValue, int *errorPointer) {
+    {
+        std::lock_guard<std::mutex> lock(keyValueMutex);
+        if (FindCachedKeyValue(key, pValue)) {
+            keyValueHits++;
+            return true;
+        }
+    }
+    std::lock_guard<std::mutex> storeLock(keyValueStoreMutex);
+    {
+        // written while this thread waited for the store
+        std::lock_guard<std::mutex> lock(keyValueMutex);
+        if (FindCachedKeyValue(key, pValue)) {
+            keyValueHits++;
+            return true;
+        }
+        keyValueMisses++;
+    }
+    const char *pStoredValue = wallet_get_value(pWallet, key.c_str(), errorPointer);
+    bool found = *errorPointer == 0 && pStoredValue != nullptr;
+    if (found) {
+        pValue->assign(pStoredValue);
+        std::lock_guard<std::mutex> lock(keyValueMutex);
+        // a buffered write that came in meanwhile is newer than what was read
+        keyValues.emplace(key, CachedKeyValue{*pValue, false});
+    }
+    if (pStoredValue != nullptr) {
+        string_destroy(const_cast<char *>(pStoredValue));
+    }
+    return found;
+}
+
+bool SetKeyValue(TariWallet *pWallet, const std::string &key, const std::string &value, int *errorPointer) {
+    std::lock_guard<std::mutex> storeLock(keyValueStoreMutex);
+    bool result = wallet_set_key_value(pWallet, key.c_str(), value.c_str(), errorPointer);
+    std::lock_guard<std::mutex> lock(keyValueMutex);
+    if (*errorPointer == 0) {
+        // also replaces a buffered write of the key, this one is newer
+        StoreCachedKeyValue(key, value, false);
+    } else {
+        DropCachedKeyValue(key);
+    }
+    return result;
+}
+
+bool RemoveKeyValue(TariWallet *pWallet, const std::string &key, int *errorPointer) {
+    std::lock_guard<std::mutex> storeLock(keyValueStoreMutex);
+    {
+        std::lock_guard<std::mutex> lock(keyValueMutex);
+        DropCachedKeyValue(key);
+    }
+    return wallet_clear_value(pWallet, key.c_str(), errorPointer);
+}
+
+void SetKeyValues(TariWallet *pWallet, const std::vector<std::string> &keys, const std::vector<std::string> &values) {
+    std::lock_guard<std::mutex> lock(keyValueMutex);
+    keyValueWallet = pWallet;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        StoreCachedKeyValue(keys[i], values[i], true);
+    }
+    bufferedKeyValueWrites += static_cast<long long>(keys.size());
+    StartKeyValueFlusher();
+    keyValueFlusherWake.notify_one();
+}
+
+bool CommitKeyValues(TariWallet *pWallet, int *errorPointer) {
+    int flusherError;
+    {
+        std::lock_guard<std::mutex> lock(keyValueMutex);
+        flusherError = keyValueFlushError;
+        keyValueFlushError = 0;
+    }
+    if (!FlushKeyValues(pWallet, errorPointer)) {
+        return false;
+    }
+    *errorPointer = flusherError;
+    return flusherError == 0;
+}
+
+void CloseKeyValueCache(TariWallet *pWallet) {
+    bool flusherRunning;
+    {
+        std::lock_guard<std::mutex> lock(keyValueMutex);
+        flusherRunning = keyValueFlusherRunning;
+        keyValueFlusherStopping = true;
+        keyValueFlusherWake.notify_one();
+    }
+    if (flusherRunning) {
+        keyValueFlusher.join();
+    }
+    int error = 0;
+    bool flushed = FlushKeyValues(pWallet, &error);
+    std::lock_guard<std::mutex> lock(keyValueMutex);
+    if (!flushed) {
+        LOGE("%zu buffered key values could not be written (%d) and are lost.", dirtyKeyValueCount, error);
+    } else if (keyValueFlushError != 0) {
+        LOGE("A background key value flush failed (%d) since the last commit, its values were written on close.",
+             keyValueFlushError);
+    }
+    LOGI("Key value cache closed: %lld hits, %lld misses, %lld writes buffered, %lld written in %lld flushes.", keyValueHits,
+         keyValueMisses, bufferedKeyValueWrites, flushedKeyValueWrites, keyValueFlushes);
+    keyValues.clear();
+    dirtyKeyValueCount = 0;
+    keyValueWallet = nullptr;
+    keyValueFlusherRunning = false;
+    keyValueFlusherStopping = false;
+    keyValueFlushError = 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+// uses the wallet.h types, include after wallet.h
+
+// set by wallet_get_value for a key that has no value
+const int ValuesNotFoundErrorCode = 424;
+
+/**
+ * Write-back cache in front of the wallet's key-value store. Values read or written once are served
+ * from memory; batched writes (SetKeyValues) are buffered and written by a background flusher a
+ * short while after the first of them, on CommitKeyValues, and when the wallet is closed. Every
+ * read sees the latest write, whether it has reached the database yet or not.
+ *
+ * The single-key setter and remover still write through, so their result is the database's.
+ */
+bool GetKeyValue(TariWallet *pWallet, const std::string &key, std::string *pValue, int *errorPointer);
+
+bool SetKeyValue(TariWallet *pWallet, const std::string &key, const std::string &value, int *errorPointer);
+
+bool RemoveKeyValue(TariWallet *pWallet, const std::string &key, int *errorPointer);
+
+/**
+ * Buffers the writes, keys[i] is set to values[i].
+ */
+void SetKeyValues(TariWallet *pWallet, const std::vector<std::string> &keys, const std::vector<std::string> &values);
+
+/**
+ * Writes the buffered values now. Returns false with errorPointer set to the first failure, of this
+ * write or of a background flush since the last commit. Values that failed to be written stay
+ * buffered and are retried by the next flush.
+ */
+bool CommitKeyValues(TariWallet *pWallet, int *errorPointer);
+
+/**
+ * Stops the flusher, writes what is still buffered and empties the cache, logging values that
+ * could not be written. Call before the wallet is destroyed.
+ */
+void CloseKeyValueCache(TariWallet *pWallet);
@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIOutputFeatures_jniCreate(
         JNIEnv *jEnv,
         jobject jThis,
@@ -64,7 +64,7 @@ Java_com_tari_android_wallet_ffi_FFIOutputFeatures_jniCreate(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIOutputFeatures_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
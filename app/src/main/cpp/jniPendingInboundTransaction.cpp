@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetId(
         JNIEnv *jEnv,
         jobject jThis,
@@ -52,7 +52,19 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetId(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetIdU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(pending_inbound_transaction_get_transaction_id(pInboundTx, errorPointer));
+    });
+}
+
+extern "C"
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetSourcePublicKey(
         JNIEnv *jEnv,
         jobject jThis,
@@ -64,7 +76,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetSourcePublicKey(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetAmount(
         JNIEnv *jEnv,
         jobject jThis,
@@ -76,7 +88,19 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetAmount(
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetAmountU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(pending_inbound_transaction_get_amount(pInboundTx, errorPointer));
+    });
+}
+
+extern "C"
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetMessage(
         JNIEnv *jEnv,
         jobject jThis,
@@ -84,14 +108,14 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetMessage(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
         const char *pMessage = pending_inbound_transaction_get_message(pInboundTx, errorPointer);
-        jstring result = jEnv->NewStringUTF(pMessage);
+        jstring result = NewJavaString(jEnv, pMessage);
         string_destroy(const_cast<char *>(pMessage));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetTimestamp(
         JNIEnv *jEnv,
         jobject jThis,
@@ -103,7 +127,19 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetTimestamp(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetTimestampU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(pending_inbound_transaction_get_timestamp(pInboundTx, errorPointer));
+    });
+}
+
+extern "C"
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetStatus(
         JNIEnv *jEnv,
         jobject jThis,
@@ -115,10 +151,27 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetStatus(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     pending_inbound_transaction_destroy(GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
 }
+
+static const JNINativeMethod ffiPendingInboundTxMethods[] = {
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetId, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetIdU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetSourcePublicKey, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetAmount, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetAmountU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetMessage, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetTimestamp, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetTimestampU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingInboundTx, jniGetStatus, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIPendingInboundTx, jniDestroy, "()V"),
+};
+
+jint RegisterPendingInboundTransactionNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIPendingInboundTx"), ffiPendingInboundTxMethods, NELEM(ffiPendingInboundTxMethods));
+}
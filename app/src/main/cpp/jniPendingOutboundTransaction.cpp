@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetId(
         JNIEnv *jEnv,
         jobject jThis,
@@ -52,7 +52,19 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetId(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetIdU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(pending_outbound_transaction_get_transaction_id(pOutboundTx, errorPointer));
+    });
+}
+
+extern "C"
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetDestinationPublicKey(
         JNIEnv *jEnv,
         jobject jThis,
@@ -64,7 +76,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetDestinationPublicKey
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetAmount(
         JNIEnv *jEnv,
         jobject jThis,
@@ -75,9 +87,21 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetAmount(
     });
 }
 
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetAmountU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(pending_outbound_transaction_get_amount(pOutboundTx, errorPointer));
+    });
+}
+
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetFee(
         JNIEnv *jEnv,
         jobject jThis,
@@ -89,7 +113,19 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetFee(
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetFeeU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(pending_outbound_transaction_get_fee(pOutboundTx, errorPointer));
+    });
+}
+
+extern "C"
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetMessage(
         JNIEnv *jEnv,
         jobject jThis,
@@ -97,14 +133,14 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetMessage(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         const char *pMessage = pending_outbound_transaction_get_message(pOutboundTx, errorPointer);
-        jstring result = jEnv->NewStringUTF(pMessage);
+        jstring result = NewJavaString(jEnv, pMessage);
         string_destroy(const_cast<char *>(pMessage));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetTimestamp(
         JNIEnv *jEnv,
         jobject jThis,
@@ -116,7 +152,19 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetTimestamp(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetTimestampU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(pending_outbound_transaction_get_timestamp(pOutboundTx, errorPointer));
+    });
+}
+
+extern "C"
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetStatus(
         JNIEnv *jEnv,
         jobject jThis,
@@ -128,10 +176,29 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetStatus(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     pending_outbound_transaction_destroy(GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiPendingOutboundTxMethods[] = {
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetId, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetIdU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetDestinationPublicKey, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetAmount, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetAmountU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetFee, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetFeeU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetMessage, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetTimestamp, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetTimestampU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniGetStatus, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIPendingOutboundTx, jniDestroy, "()V"),
+};
+
+jint RegisterPendingOutboundTransactionNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIPendingOutboundTx"), ffiPendingOutboundTxMethods, NELEM(ffiPendingOutboundTxMethods));
+}
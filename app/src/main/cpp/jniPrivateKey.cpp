@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniCreate(
         JNIEnv *jEnv,
         jobject jThis,
@@ -54,7 +54,7 @@ Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniCreate(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniGenerate(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -62,22 +62,24 @@ Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniGenerate(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniFromHex(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jHexStr,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        const char *pStr = jEnv->GetStringUTFChars(jHexStr, JNI_FALSE);
-        TariPrivateKey *pPrivateKey = private_key_from_hex(pStr, errorPointer);
-        jEnv->ReleaseStringUTFChars(jHexStr, pStr);
+        JavaStringUtf8 hex(jEnv, jHexStr);
+        if (!CheckJavaString(hex, errorPointer)) {
+            return;
+        }
+        TariPrivateKey *pPrivateKey = private_key_from_hex(hex.c_str(), errorPointer);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pPrivateKey));
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniGetBytes(
         JNIEnv *jEnv,
         jobject jThis,
@@ -89,7 +91,7 @@ Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniGetBytes(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
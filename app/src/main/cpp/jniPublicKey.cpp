@@ -38,9 +38,10 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniEmojiIdCache.h"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKey_jniCreate(
         JNIEnv *jEnv,
         jobject jThis,
@@ -54,22 +55,24 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniCreate(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKey_jniFromHex(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jHexStr,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        const char *pStr = jEnv->GetStringUTFChars(jHexStr, JNI_FALSE);
-        TariPublicKey *pPublicKey = public_key_from_hex(pStr, errorPointer);
-        jEnv->ReleaseStringUTFChars(jHexStr, pStr);
+        JavaStringUtf8 hex(jEnv, jHexStr);
+        if (!CheckJavaString(hex, errorPointer)) {
+            return;
+        }
+        TariPublicKey *pPublicKey = public_key_from_hex(hex.c_str(), errorPointer);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pPublicKey));
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKey_jniFromPrivateKey(
         JNIEnv *jEnv,
         jobject jThis,
@@ -83,7 +86,7 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniFromPrivateKey(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKey_jniGetBytes(
         JNIEnv *jEnv,
         jobject jThis,
@@ -95,22 +98,19 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniGetBytes(
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKey_jniGetEmojiId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pPublicKey = GetPointerField<TariPublicKey *>(jEnv, jThis);
-        const char *pEmojiId = public_key_get_emoji_encoding(pPublicKey, errorPointer);
-        jstring result = jEnv->NewStringUTF(pEmojiId);
-        string_destroy(const_cast<char *>(pEmojiId));
-        return result;
+        return GetPublicKeyEmojis(jEnv, pPublicKey, errorPointer);
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKey_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -119,7 +119,7 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniDestroy(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKeys_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -131,7 +131,7 @@ Java_com_tari_android_wallet_ffi_FFIPublicKeys_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKeys_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -144,10 +144,30 @@ Java_com_tari_android_wallet_ffi_FFIPublicKeys_jniGetAt(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKeys_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     public_keys_destroy(GetPointerField<TariPublicKeys *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiPublicKeyMethods[] = {
+        NATIVE_METHOD(FFIPublicKey, jniCreate, "(" FFI_TYPE("FFIByteVector") FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIPublicKey, jniFromHex, "(" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIPublicKey, jniGetBytes, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPublicKey, jniGetEmojiId, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFIPublicKey, jniDestroy, "()V"),
+};
+
+static const JNINativeMethod ffiPublicKeysMethods[] = {
+        NATIVE_METHOD(FFIPublicKeys, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIPublicKeys, jniGetAt, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIPublicKeys, jniDestroy, "()V"),
+};
+
+jint RegisterPublicKeyNatives(JNIEnv *jEnv) {
+    bool registered = RegisterNativeMethods(jEnv, FFI_CLASS("FFIPublicKey"), ffiPublicKeyMethods, NELEM(ffiPublicKeyMethods)) == JNI_OK
+            && RegisterNativeMethods(jEnv, FFI_CLASS("FFIPublicKeys"), ffiPublicKeysMethods, NELEM(ffiPublicKeysMethods)) == JNI_OK;
+    return registered ? JNI_OK : JNI_ERR;
+}
@@ -40,7 +40,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFISeedWords_jniCreate(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -49,21 +49,24 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniCreate(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetMnemonicWordListForLanguage(
         JNIEnv *jEnv,
         jobject jThis,
         jstring language,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        const char *pLanguage = jEnv->GetStringUTFChars(language, JNI_FALSE);
-        TariSeedWords *pSeedWords = seed_words_get_mnemonic_word_list_for_language(pLanguage, errorPointer);
+        JavaStringUtf8 languageName(jEnv, language);
+        if (!CheckJavaString(languageName, errorPointer)) {
+            return;
+        }
+        TariSeedWords *pSeedWords = seed_words_get_mnemonic_word_list_for_language(languageName.c_str(), errorPointer);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pSeedWords));
     });
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFISeedWords_jniPushWord(
         JNIEnv *jEnv,
         jobject jThis,
@@ -71,15 +74,17 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniPushWord(
         jobject error) {
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jThis);
-        const char *pWord = jEnv->GetStringUTFChars(jWord, JNI_FALSE);
-        jint result = seed_words_push_word(pSeedWords, pWord, errorPointer);
-        jEnv->ReleaseStringUTFChars(jWord, pWord);
+        JavaStringUtf8 word(jEnv, jWord);
+        if (!CheckJavaString(word, errorPointer)) {
+            return 0;
+        }
+        jint result = seed_words_push_word(pSeedWords, word.c_str(), errorPointer);
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -91,7 +96,7 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetLength(
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -100,17 +105,30 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetAt(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jThis);
         const char *pWord = seed_words_get_at(pSeedWords, static_cast<unsigned int>(index), errorPointer);
-        jstring result = jEnv->NewStringUTF(pWord);
+        jstring result = NewJavaString(jEnv, pWord);
         string_destroy(const_cast<char *>(pWord));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFISeedWords_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     seed_words_destroy(GetPointerField<TariSeedWords *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiSeedWordsMethods[] = {
+        NATIVE_METHOD(FFISeedWords, jniCreate, "()V"),
+        NATIVE_METHOD(FFISeedWords, jniGetMnemonicWordListForLanguage, "(" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFISeedWords, jniPushWord, "(" JAVA_STRING FFI_ERROR ")I"),
+        NATIVE_METHOD(FFISeedWords, jniGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFISeedWords, jniGetAt, "(I" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFISeedWords, jniDestroy, "()V"),
+};
+
+jint RegisterSeedWordsNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFISeedWords"), ffiSeedWordsMethods, NELEM(ffiSeedWordsMethods));
+}
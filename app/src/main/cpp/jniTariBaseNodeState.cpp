@@ -4,7 +4,7 @@
 
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFITariBaseNodeState_jniGetHeightOfLongestChain(
         JNIEnv *jEnv,
         jobject jThis,
@@ -13,4 +13,12 @@ Java_com_tari_android_wallet_ffi_FFITariBaseNodeState_jniGetHeightOfLongestChain
         auto pTariBaseNodeState = GetPointerField<TariBaseNodeState *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, basenode_state_get_height_of_the_longest_chain(pTariBaseNodeState, errorPointer));
     });
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiTariBaseNodeStateMethods[] = {
+        NATIVE_METHOD(FFITariBaseNodeState, jniGetHeightOfLongestChain, "(" FFI_ERROR ")[B"),
+};
+
+jint RegisterTariBaseNodeStateNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFITariBaseNodeState"), ffiTariBaseNodeStateMethods, NELEM(ffiTariBaseNodeStateMethods));
+}
@@ -40,18 +40,24 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariCoinPreview_jniLoadData(
         JNIEnv *jEnv,
         jobject jThis) {
-    jclass dataClass = jEnv->GetObjectClass(jThis);
+    const JniIds &ids = GetJniIds();
     auto outputs = GetPointerField<TariCoinPreview *>(jEnv, jThis);
 
-    jfieldID vectorPointerField = jEnv->GetFieldID(dataClass, "vectorPointer", "J");
     auto pointerToVector = (long) (outputs->expected_outputs);
-    jEnv->SetLongField(jThis, vectorPointerField, pointerToVector);
+    jEnv->SetLongField(jThis, ids.ffiTariCoinPreviewVectorPointerField, pointerToVector);
 
-    jfieldID feeField = jEnv->GetFieldID(dataClass, "feeValue", "J");
     auto feeValue = (long) (outputs->fee);
-    jEnv->SetLongField(jThis, feeField, feeValue);
-}
\ No newline at end of file
+    jEnv->SetLongField(jThis, ids.ffiTariCoinPreviewFeeValueField, feeValue);
+}
+
+static const JNINativeMethod ffiTariCoinPreviewMethods[] = {
+        NATIVE_METHOD(FFITariCoinPreview, jniLoadData, "()V"),
+};
+
+jint RegisterTariCoinPreviewNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFITariCoinPreview"), ffiTariCoinPreviewMethods, NELEM(ffiTariCoinPreviewMethods));
+}
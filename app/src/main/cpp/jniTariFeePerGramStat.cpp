@@ -39,7 +39,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetOrder(
         JNIEnv *jEnv,
         jobject jThis,
@@ -53,7 +53,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetOrder(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetMin(
         JNIEnv *jEnv,
         jobject jThis,
@@ -67,7 +67,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetMin(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetMax(
         JNIEnv *jEnv,
         jobject jThis,
@@ -81,7 +81,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetMax(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetAverage(
         JNIEnv *jEnv,
         jobject jThis,
@@ -92,4 +92,15 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetAverage(
         unsigned long long order = fee_per_gram_stat_get_avg_fee_per_gram(pTariFeePerGramStat, errorPointer);
         return getBytesFromUnsignedLongLong(jEnv, order);
     });
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiFeePerGramStatMethods[] = {
+        NATIVE_METHOD(FFIFeePerGramStat, jniGetOrder, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIFeePerGramStat, jniGetMin, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIFeePerGramStat, jniGetMax, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIFeePerGramStat, jniGetAverage, "(" FFI_ERROR ")[B"),
+};
+
+jint RegisterTariFeePerGramStatNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIFeePerGramStat"), ffiFeePerGramStatMethods, NELEM(ffiFeePerGramStatMethods));
+}
@@ -39,7 +39,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT int JNICALL
+int JNICALL
 Java_com_tari_android_wallet_ffi_FFIFeePerGramStats_jniFeePerGramStatsGetLength(
         JNIEnv *jEnv,
         jobject jThis,
@@ -52,7 +52,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStats_jniFeePerGramStatsGetLength(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIFeePerGramStats_jniGetAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -65,10 +65,20 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStats_jniGetAt(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIFeePerGramStats_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     fee_per_gram_stats_destroy(GetPointerField<TariFeePerGramStats *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiFeePerGramStatsMethods[] = {
+        NATIVE_METHOD(FFIFeePerGramStats, jniFeePerGramStatsGetLength, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIFeePerGramStats, jniGetAt, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIFeePerGramStats, jniDestroy, "()V"),
+};
+
+jint RegisterTariFeePerGramStatsNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFIFeePerGramStats"), ffiFeePerGramStatsMethods, NELEM(ffiFeePerGramStatsMethods));
+}
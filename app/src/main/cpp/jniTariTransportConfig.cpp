@@ -39,7 +39,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariTransportConfig_jniMemoryTransport(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -48,22 +48,24 @@ Java_com_tari_android_wallet_ffi_FFITariTransportConfig_jniMemoryTransport(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariTransportConfig_jniTCPTransport(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jpAddress,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        char *pAddress = const_cast<char *>(jEnv->GetStringUTFChars(jpAddress, JNI_FALSE));
-        TariTransportConfig *pTransport = transport_tcp_create(pAddress, errorPointer);
-        jEnv->ReleaseStringUTFChars(jpAddress, pAddress);
+        JavaStringUtf8 address(jEnv, jpAddress);
+        if (!CheckJavaString(address, errorPointer)) {
+            return;
+        }
+        TariTransportConfig *pTransport = transport_tcp_create(const_cast<char *>(address.c_str()), errorPointer);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pTransport));
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariTransportConfig_jniTorTransport(
         JNIEnv *jEnv,
         jobject jThis,
@@ -74,23 +76,25 @@ Java_com_tari_android_wallet_ffi_FFITariTransportConfig_jniTorTransport(
         jstring jpSocksPass,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        char *pControl = const_cast<char *>(jEnv->GetStringUTFChars(jpControl, JNI_FALSE));
+        JavaStringUtf8 control(jEnv, jpControl);
         auto pTorCookie = GetPointerField<ByteVector *>(jEnv, jpTorCookie);
-        char *pSocksUsername = const_cast<char *>(jEnv->GetStringUTFChars(jpSocksUser, JNI_FALSE));
-        char *pSocksPassword = const_cast<char *>(jEnv->GetStringUTFChars(jpSocksPass, JNI_FALSE));
-        TariTransportConfig *transport = transport_tor_create(pControl, pTorCookie,
+        JavaStringUtf8 socksUsername(jEnv, jpSocksUser);
+        JavaStringUtf8 socksPassword(jEnv, jpSocksPass);
+        if (!CheckJavaString(control, errorPointer) || !CheckJavaString(socksUsername, errorPointer) ||
+            !CheckJavaString(socksPassword, errorPointer)) {
+            return;
+        }
+        TariTransportConfig *transport = transport_tor_create(const_cast<char *>(control.c_str()), pTorCookie,
                                                               static_cast<unsigned short>(jPort),
                                                               false,
-                                                              pSocksUsername, pSocksPassword, errorPointer);
-        jEnv->ReleaseStringUTFChars(jpControl, pControl);
-        jEnv->ReleaseStringUTFChars(jpSocksUser, pSocksUsername);
-        jEnv->ReleaseStringUTFChars(jpSocksPass, pSocksPassword);
+                                                              const_cast<char *>(socksUsername.c_str()),
+                                                              const_cast<char *>(socksPassword.c_str()), errorPointer);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(transport));
     });
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFITariTransportConfig_jniGetMemoryAddress(
         JNIEnv *jEnv,
         jobject jThis,
@@ -98,17 +102,29 @@ Java_com_tari_android_wallet_ffi_FFITariTransportConfig_jniGetMemoryAddress(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pTransport = GetPointerField<TariTransportConfig *>(jEnv, jThis);
         const char *pAddress = transport_memory_get_address(pTransport, errorPointer);
-        jstring result = jEnv->NewStringUTF(pAddress);
+        jstring result = NewJavaString(jEnv, pAddress);
         string_destroy(const_cast<char *>(pAddress));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariTransportConfig_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     transport_type_destroy(GetPointerField<TariTransportConfig *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
 }
+
+static const JNINativeMethod ffiTariTransportConfigMethods[] = {
+        NATIVE_METHOD(FFITariTransportConfig, jniMemoryTransport, "()V"),
+        NATIVE_METHOD(FFITariTransportConfig, jniTCPTransport, "(" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFITariTransportConfig, jniTorTransport, "(" JAVA_STRING FFI_TYPE("FFIByteVector") "I" JAVA_STRING JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFITariTransportConfig, jniGetMemoryAddress, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFITariTransportConfig, jniDestroy, "()V"),
+};
+
+jint RegisterTariTransportConfigNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFITariTransportConfig"), ffiTariTransportConfigMethods, NELEM(ffiTariTransportConfigMethods));
+}
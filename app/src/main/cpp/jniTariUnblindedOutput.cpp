@@ -39,22 +39,24 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUnblindedOutput_jniFromJson(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jJson,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        const char *pJson = jEnv->GetStringUTFChars(jJson, JNI_FALSE);
-        UnblindedOutput *pUnblindedOutput = create_tari_unblinded_output_from_json(pJson, errorPointer);
-        jEnv->ReleaseStringUTFChars(jJson, pJson);
+        JavaStringUtf8 json(jEnv, jJson);
+        if (!CheckJavaString(json, errorPointer)) {
+            return;
+        }
+        UnblindedOutput *pUnblindedOutput = create_tari_unblinded_output_from_json(json.c_str(), errorPointer);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pUnblindedOutput));
     });
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUnblindedOutput_jniToJson(
         JNIEnv *jEnv,
         jobject jThis,
@@ -62,17 +64,27 @@ Java_com_tari_android_wallet_ffi_FFITariUnblindedOutput_jniToJson(
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pUnblindedOutput = GetPointerField<UnblindedOutput *>(jEnv, jThis);
         const char *pJson = tari_unblinded_output_to_json(pUnblindedOutput, errorPointer);
-        jstring result = jEnv->NewStringUTF(pJson);
+        jstring result = NewJavaString(jEnv, pJson);
         string_destroy(const_cast<char *>(pJson));
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUnblindedOutput_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     tari_unblinded_output_destroy(GetPointerField<TariUnblindedOutput *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
 }
+
+static const JNINativeMethod ffiTariUnblindedOutputMethods[] = {
+        NATIVE_METHOD(FFITariUnblindedOutput, jniFromJson, "(" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFITariUnblindedOutput, jniToJson, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFITariUnblindedOutput, jniDestroy, "()V"),
+};
+
+jint RegisterTariUnblindedOutputNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFITariUnblindedOutput"), ffiTariUnblindedOutputMethods, NELEM(ffiTariUnblindedOutputMethods));
+}
@@ -40,34 +40,37 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUtxo_jniLoadData(
         JNIEnv *jEnv,
         jobject jThis) {
-    jclass dataClass = jEnv->GetObjectClass(jThis);
+    const JniIds &ids = GetJniIds();
     auto outputs = GetPointerField<TariUtxo *>(jEnv, jThis);
 
-    jfieldID valueField = jEnv->GetFieldID(dataClass, "value", "J");
     auto lenValue = (long) (outputs->value);
-    jEnv->SetLongField(jThis, valueField, lenValue);
+    jEnv->SetLongField(jThis, ids.ffiTariUtxoValueField, lenValue);
 
-    jfieldID minedHeightField = jEnv->GetFieldID(dataClass, "minedHeight", "J");
     auto minedHeight = (long) (outputs->mined_height);
-    jEnv->SetLongField(jThis, minedHeightField, minedHeight);
+    jEnv->SetLongField(jThis, ids.ffiTariUtxoMinedHeightField, minedHeight);
 
-    jfieldID minedTimestampField = jEnv->GetFieldID(dataClass, "minedTimestamp", "J");
     auto minedTimestamp = (long) (outputs->mined_timestamp);
-    jEnv->SetLongField(jThis, minedTimestampField, minedTimestamp);
+    jEnv->SetLongField(jThis, ids.ffiTariUtxoMinedTimestampField, minedTimestamp);
 
-    jfieldID lockHeightField = jEnv->GetFieldID(dataClass, "lockHeight", "J");
     auto lockHeight = (long) (outputs->lock_height);
-    jEnv->SetLongField(jThis, lockHeightField, lockHeight);
+    jEnv->SetLongField(jThis, ids.ffiTariUtxoLockHeightField, lockHeight);
 
-    jfieldID statusField = jEnv->GetFieldID(dataClass, "status", "B");
     auto statusValue = (jbyte) (outputs->status);
-    jEnv->SetByteField(jThis, statusField, statusValue);
+    jEnv->SetByteField(jThis, ids.ffiTariUtxoStatusField, statusValue);
 
-    jfieldID commitmentField = jEnv->GetFieldID(dataClass, "commitment", "Ljava/lang/String;");
-    jstring commitmentValue = jEnv->NewStringUTF(outputs->commitment);
-    jEnv->SetObjectField(jThis, commitmentField, commitmentValue);
-}
\ No newline at end of file
+    jstring commitmentValue = NewJavaString(jEnv, outputs->commitment);
+    jEnv->SetObjectField(jThis, ids.ffiTariUtxoCommitmentField, commitmentValue);
+    jEnv->DeleteLocalRef(commitmentValue);
+}
+
+static const JNINativeMethod ffiTariUtxoMethods[] = {
+        NATIVE_METHOD(FFITariUtxo, jniLoadData, "()V"),
+};
+
+jint RegisterTariUtxoNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFITariUtxo"), ffiTariUtxoMethods, NELEM(ffiTariUtxoMethods));
+}
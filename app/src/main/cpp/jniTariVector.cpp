@@ -36,32 +36,31 @@
 #include <wallet.h>
 #include <string>
 #include <cmath>
+#include <cstring>
+#include <vector>
 #include <android/log.h>
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariVector_jniLoadData(
         JNIEnv *jEnv,
         jobject jThis) {
-    jclass dataClass = jEnv->GetObjectClass(jThis);
+    const JniIds &ids = GetJniIds();
     auto outputs = GetPointerField<TariVector *>(jEnv, jThis);
 
-    jfieldID sizeField = jEnv->GetFieldID(dataClass, "len", "J");
     auto lenValue = (long)(outputs->len);
-    jEnv->SetLongField(jThis, sizeField, lenValue);
+    jEnv->SetLongField(jThis, ids.ffiTariVectorLenField, lenValue);
 
-    jfieldID capField = jEnv->GetFieldID(dataClass, "cap", "J");
     auto capValue = (long)(outputs->cap);
-    jEnv->SetLongField(jThis, capField, capValue);
+    jEnv->SetLongField(jThis, ids.ffiTariVectorCapField, capValue);
 
-    jfieldID tagField = jEnv->GetFieldID(dataClass, "tag", "I");
     auto tagValue = (int)(outputs->tag);
-    jEnv->SetIntField(jThis, tagField, tagValue);
+    jEnv->SetIntField(jThis, ids.ffiTariVectorTagField, tagValue);
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFITariVector_jniGetItemAt(
         JNIEnv *jEnv,
         jobject jThis,
@@ -79,4 +78,77 @@ Java_com_tari_android_wallet_ffi_FFITariVector_jniGetItemAt(
     }
 
     return pointerToItem;
-}
\ No newline at end of file
+}
+
+/**
+ * Layout of FFITariVector.jniExportUtxos, decoded by UtxosExport.kt. Keep both in sync.
+ * Native byte order: a header of version and count (8 bytes), then the value, mined height, mined
+ * timestamp and lock height columns (u64), the commitments (32 bytes each) and the statuses (1 byte each).
+ */
+const int32_t UtxosExportVersion = 1;
+const size_t UtxosExportHeaderSize = 8;
+const size_t CommitmentSize = 32;
+
+extern "C"
+jobject JNICALL
+Java_com_tari_android_wallet_ffi_FFITariVector_jniExportUtxos(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jobject>(jEnv, error, [&](int *errorPointer) -> jobject {
+        auto outputs = GetPointerField<TariVector *>(jEnv, jThis);
+        size_t count = outputs->tag == Utxo ? outputs->len : 0;
+        auto utxos = static_cast<TariUtxo *>(outputs->ptr);
+
+        std::vector<unsigned char> buffer(UtxosExportHeaderSize + count * (4 * sizeof(uint64_t) + CommitmentSize + 1));
+        int32_t header[2] = {UtxosExportVersion, static_cast<int32_t>(count)};
+        memcpy(buffer.data(), header, sizeof(header));
+        auto values = reinterpret_cast<uint64_t *>(buffer.data() + UtxosExportHeaderSize);
+        uint64_t *minedHeights = values + count;
+        uint64_t *minedTimestamps = minedHeights + count;
+        uint64_t *lockHeights = minedTimestamps + count;
+        auto commitments = reinterpret_cast<unsigned char *>(lockHeights + count);
+        unsigned char *statuses = commitments + count * CommitmentSize;
+
+        for (size_t i = 0; i < count; i++) {
+            const TariUtxo &utxo = utxos[i];
+            values[i] = utxo.value;
+            minedHeights[i] = utxo.mined_height;
+            minedTimestamps[i] = utxo.mined_timestamp;
+            lockHeights[i] = utxo.lock_height;
+            statuses[i] = utxo.status;
+            if (!HexToBytes(utxo.commitment, commitments + i * CommitmentSize, CommitmentSize)) {
+                LOGE("UTXO %zu has no 32 byte commitment", i);
+                *errorPointer = UnexpectedLibraryDataErrorCode;
+                return nullptr;
+            }
+        }
+
+        jobject result = NewDirectByteBufferCopy(jEnv, buffer.data(), buffer.size());
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+        }
+        return result;
+    });
+}
+
+extern "C"
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFITariVector_jniDestroy(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    destroy_tari_vector(GetPointerField<TariVector *>(jEnv, jThis));
+    SetNullPointerField(jEnv, jThis);
+}
+
+static const JNINativeMethod ffiTariVectorMethods[] = {
+        NATIVE_METHOD(FFITariVector, jniLoadData, "()V"),
+        NATIVE_METHOD(FFITariVector, jniGetItemAt, "(I)J"),
+        NATIVE_METHOD(FFITariVector, jniExportUtxos, "(" FFI_ERROR ")" JAVA_BYTE_BUFFER),
+        NATIVE_METHOD(FFITariVector, jniDestroy, "()V"),
+};
+
+jint RegisterTariVectorNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFITariVector"), ffiTariVectorMethods, NELEM(ffiTariVectorMethods));
+}
@@ -36,11 +36,15 @@
 #include <wallet.h>
 #include <string>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniBase58.h"
+#include "jniEmojiIdCache.h"
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniCreate(
         JNIEnv *jEnv,
         jobject jThis,
@@ -54,52 +58,53 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniCreate(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniFromBase58(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jBase58Str,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        const char *pBase58Str = jEnv->GetStringUTFChars(jBase58Str, JNI_FALSE);
-        auto pTariWalletAddress = tari_address_from_base58(pBase58Str, errorPointer);
-        jEnv->ReleaseStringUTFChars(jBase58Str, pBase58Str);
+        JavaStringUtf8 base58Str(jEnv, jBase58Str);
+        if (!CheckJavaString(base58Str, errorPointer)) {
+            return;
+        }
+        auto pTariWalletAddress = tari_address_from_base58(base58Str.c_str(), errorPointer);
         SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pTariWalletAddress));
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniFromEmojiId(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jpEmoji,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        const char *pStr = jEnv->GetStringUTFChars(jpEmoji, JNI_FALSE);
-        auto result = reinterpret_cast<jlong>(emoji_id_to_tari_address(pStr, errorPointer));
-        jEnv->ReleaseStringUTFChars(jpEmoji, pStr);
+        JavaStringUtf8 emoji(jEnv, jpEmoji);
+        if (!CheckJavaString(emoji, errorPointer)) {
+            return;
+        }
+        auto result = reinterpret_cast<jlong>(emoji_id_to_tari_address(emoji.c_str(), errorPointer));
         SetPointerField(jEnv, jThis, result);
     });
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetEmojiId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
-        const char *pEmoji = tari_address_to_emoji_id(pWalletAddress, errorPointer);
-        jstring result = jEnv->NewStringUTF(pEmoji);
-        string_destroy(const_cast<char *>(pEmoji));
-        return result;
+        return GetAddressEmojiId(jEnv, pWalletAddress, errorPointer);
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetBytes(
         JNIEnv *jEnv,
         jobject jThis,
@@ -111,7 +116,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetBytes(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
@@ -120,7 +125,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniDestroy(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetNetwork(
         JNIEnv *jEnv,
         jobject jThis,
@@ -132,7 +137,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetNetwork(
 }
 
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetFeatures(
         JNIEnv *jEnv,
         jobject jThis,
@@ -144,7 +149,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetFeatures(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetViewKey(
         JNIEnv *jEnv,
         jobject jThis,
@@ -156,7 +161,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetViewKey(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetSpendKey(
         JNIEnv *jEnv,
         jobject jThis,
@@ -167,7 +172,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetSpendKey(
     });
 }
 extern "C"
-JNIEXPORT jint JNICALL
+jint JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetChecksum(
         JNIEnv *jEnv,
         jobject jThis,
@@ -176,4 +181,132 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetChecksum(
         auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
         return static_cast<jint>(tari_address_checksum_u8(pWalletAddress, errorPointer));
     });
-}
\ No newline at end of file
+}
+
+// cached emoji encoding of the key, or null for a missing key
+static jstring TakePublicKeyEmojis(JNIEnv *jEnv, TariPublicKey *pKey, int *errorPointer) {
+    if (pKey == nullptr) {
+        return nullptr;
+    }
+    return GetPublicKeyEmojis(jEnv, pKey, errorPointer);
+}
+
+extern "C"
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniDecompose(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jParts,
+        jobject error) {
+    ExecuteWithError(jEnv, error, [&](int *errorPointer) {
+        const JniIds &ids = GetJniIds();
+        auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
+
+        // every getter resets the error, so each one is checked before the next runs
+        jint network = tari_address_network_u8(pWalletAddress, errorPointer);
+        if (*errorPointer != 0) {
+            return;
+        }
+        jint features = tari_address_features_u8(pWalletAddress, errorPointer);
+        if (*errorPointer != 0) {
+            return;
+        }
+        jint checksum = tari_address_checksum_u8(pWalletAddress, errorPointer);
+        if (*errorPointer != 0) {
+            return;
+        }
+        jEnv->SetIntField(jParts, ids.ffiTariWalletAddressPartsNetworkField, network);
+        jEnv->SetIntField(jParts, ids.ffiTariWalletAddressPartsFeaturesField, features);
+        jEnv->SetIntField(jParts, ids.ffiTariWalletAddressPartsChecksumField, checksum);
+
+        std::vector<unsigned char> bytes;
+        ByteVector *pBytes = tari_address_get_bytes(pWalletAddress, errorPointer);
+        if (*errorPointer != 0) {
+            return;
+        }
+        bool copied = AppendByteVector(pBytes, bytes, errorPointer);
+        byte_vector_destroy(pBytes);
+        if (!copied) {
+            return;
+        }
+        jbyteArray jBytes = jEnv->NewByteArray(static_cast<jsize>(bytes.size()));
+        if (jBytes == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return;
+        }
+        jEnv->SetByteArrayRegion(jBytes, 0, static_cast<jsize>(bytes.size()), reinterpret_cast<const jbyte *>(bytes.data()));
+        jEnv->SetObjectField(jParts, ids.ffiTariWalletAddressPartsBytesField, jBytes);
+        jEnv->DeleteLocalRef(jBytes);
+
+        jstring base58 = NewJavaString(jEnv, Base58EncodeAddress(bytes.data(), bytes.size()));
+        if (base58 == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return;
+        }
+        jEnv->SetObjectField(jParts, ids.ffiTariWalletAddressPartsBase58Field, base58);
+        jEnv->DeleteLocalRef(base58);
+
+        jstring emojiId = GetAddressEmojiId(jEnv, pWalletAddress, std::string(bytes.begin(), bytes.end()), errorPointer);
+        if (*errorPointer != 0) {
+            return;
+        }
+        jEnv->SetObjectField(jParts, ids.ffiTariWalletAddressPartsEmojiIdField, emojiId);
+        jEnv->DeleteLocalRef(emojiId);
+
+        // a one-sided only address has no view key
+        TariPublicKey *pViewKey = tari_address_view_key(pWalletAddress, errorPointer);
+        if (*errorPointer != 0) {
+            return;
+        }
+        jstring viewKeyEmojis = TakePublicKeyEmojis(jEnv, pViewKey, errorPointer);
+        public_key_destroy(pViewKey);
+        if (*errorPointer != 0) {
+            return;
+        }
+        jEnv->SetObjectField(jParts, ids.ffiTariWalletAddressPartsViewKeyEmojisField, viewKeyEmojis);
+        jEnv->DeleteLocalRef(viewKeyEmojis);
+
+        TariPublicKey *pSpendKey = tari_address_spend_key(pWalletAddress, errorPointer);
+        if (*errorPointer != 0) {
+            return;
+        }
+        jstring spendKeyEmojis = TakePublicKeyEmojis(jEnv, pSpendKey, errorPointer);
+        bool spendKeyIsZero = false;
+        if (*errorPointer == 0) {
+            std::vector<unsigned char> spendKeyBytes;
+            ByteVector *pSpendKeyBytes = public_key_get_bytes(pSpendKey, errorPointer);
+            if (*errorPointer == 0 && AppendByteVector(pSpendKeyBytes, spendKeyBytes, errorPointer)) {
+                spendKeyIsZero = std::all_of(spendKeyBytes.begin(), spendKeyBytes.end(), [](unsigned char b) { return b == 0; });
+            }
+            byte_vector_destroy(pSpendKeyBytes);
+        }
+        public_key_destroy(pSpendKey);
+        if (*errorPointer != 0) {
+            return;
+        }
+        jEnv->SetObjectField(jParts, ids.ffiTariWalletAddressPartsSpendKeyEmojisField, spendKeyEmojis);
+        jEnv->SetBooleanField(jParts, ids.ffiTariWalletAddressPartsSpendKeyIsZeroField, spendKeyIsZero ? JNI_TRUE : JNI_FALSE);
+        jEnv->DeleteLocalRef(spendKeyEmojis);
+    });
+}
+
+static const JNINativeMethod ffiTariWalletAddressMethods[] = {
+        NATIVE_METHOD(FFITariWalletAddress, jniCreate, "(" FFI_TYPE("FFIByteVector") FFI_ERROR ")V"),
+        NATIVE_METHOD(FFITariWalletAddress, jniFromBase58, "(" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFITariWalletAddress, jniFromEmojiId, "(" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFITariWalletAddress, jniGetEmojiId, "(" FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFITariWalletAddress, jniGetBytes, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFITariWalletAddress, jniDestroy, "()V"),
+        NATIVE_METHOD(FFITariWalletAddress, jniGetNetwork, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFITariWalletAddress, jniGetFeatures, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFITariWalletAddress, jniGetViewKey, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFITariWalletAddress, jniGetSpendKey, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFITariWalletAddress, jniGetChecksum, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFITariWalletAddress, jniDecompose, "(" FFI_TYPE("FFITariWalletAddressParts") FFI_ERROR ")V"),
+};
+
+jint RegisterTariWalletAddressNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFITariWalletAddress"), ffiTariWalletAddressMethods, NELEM(ffiTariWalletAddressMethods));
+}
@@ -39,7 +39,7 @@
 #include "jniCommon.cpp"
 
 extern "C"
-JNIEXPORT int JNICALL
+int JNICALL
 Java_com_tari_android_wallet_ffi_FFITransactionSendStatus_jniTransactionSendStatusDecode(
         JNIEnv *jEnv,
         jobject jThis,
@@ -52,10 +52,19 @@ Java_com_tari_android_wallet_ffi_FFITransactionSendStatus_jniTransactionSendStat
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFITransactionSendStatus_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
     transaction_send_status_destroy(GetPointerField<TariTransactionSendStatus *>(jEnv, jThis));
     SetNullPointerField(jEnv, jThis);
 }
+
+static const JNINativeMethod ffiTransactionSendStatusMethods[] = {
+        NATIVE_METHOD(FFITransactionSendStatus, jniTransactionSendStatusDecode, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFITransactionSendStatus, jniDestroy, "()V"),
+};
+
+jint RegisterTransactionSendStatusNatives(JNIEnv *jEnv) {
+    return RegisterNativeMethods(jEnv, FFI_CLASS("FFITransactionSendStatus"), ffiTransactionSendStatusMethods, NELEM(ffiTransactionSendStatusMethods));
+}
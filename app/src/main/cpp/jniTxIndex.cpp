@@ -0,0 +1,363 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <wallet.h>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "jniCommon.cpp"
+#include "jniTxIndex.h"
+
+typedef std::unordered_map<uint64_t, TxIndexRecord> TxIndex;
+
+static std::mutex txIndexMutex;
+static bool txIndexBuilt = false;
+static TxIndex txIndex;
+// the build reads the database without txIndexMutex, the callbacks meanwhile queue their changes
+// here to be replayed onto the new index
+static bool txIndexBuilding = false;
+static bool txIndexSpoiled = false;
+static std::vector<std::pair<uint64_t, TxIndexRecord>> txIndexChanges;
+// bumped by ClearTxIndex, so a build that was running across it isn't kept
+static uint64_t txIndexGeneration = 0;
+// one build at a time
+static std::mutex txIndexBuildMutex;
+
+static bool ReadCompletedTx(TariCompletedTransaction *pTx, bool cancelled, uint64_t *pTxId, TxIndexRecord *pRecord, int *errorPointer) {
+    pRecord->kind = cancelled ? CancelledTxKind : CompletedTxKind;
+    *pTxId = completed_transaction_get_transaction_id(pTx, errorPointer);
+    if (*errorPointer == 0) {
+        pRecord->status = completed_transaction_get_status(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->outbound = completed_transaction_is_outbound(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->amount = completed_transaction_get_amount(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->fee = completed_transaction_get_fee(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->timestamp = completed_transaction_get_timestamp(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->confirmations = completed_transaction_get_confirmations(pTx, errorPointer);
+    }
+    return *errorPointer == 0;
+}
+
+static bool ReadPendingInboundTx(TariPendingInboundTransaction *pTx, uint64_t *pTxId, TxIndexRecord *pRecord, int *errorPointer) {
+    pRecord->kind = PendingInboundTxKind;
+    pRecord->outbound = false;
+    pRecord->fee = 0;
+    pRecord->confirmations = 0;
+    *pTxId = pending_inbound_transaction_get_transaction_id(pTx, errorPointer);
+    if (*errorPointer == 0) {
+        pRecord->status = pending_inbound_transaction_get_status(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->amount = pending_inbound_transaction_get_amount(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->timestamp = pending_inbound_transaction_get_timestamp(pTx, errorPointer);
+    }
+    return *errorPointer == 0;
+}
+
+static bool ReadPendingOutboundTx(TariPendingOutboundTransaction *pTx, uint64_t *pTxId, TxIndexRecord *pRecord, int *errorPointer) {
+    pRecord->kind = PendingOutboundTxKind;
+    pRecord->outbound = true;
+    pRecord->confirmations = 0;
+    *pTxId = pending_outbound_transaction_get_transaction_id(pTx, errorPointer);
+    if (*errorPointer == 0) {
+        pRecord->status = pending_outbound_transaction_get_status(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->amount = pending_outbound_transaction_get_amount(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->fee = pending_outbound_transaction_get_fee(pTx, errorPointer);
+    }
+    if (*errorPointer == 0) {
+        pRecord->timestamp = pending_outbound_transaction_get_timestamp(pTx, errorPointer);
+    }
+    return *errorPointer == 0;
+}
+
+static bool IndexCompletedTxs(TariCompletedTransactions *pTxs, bool cancelled, TxIndex &index, int *errorPointer) {
+    unsigned int length = completed_transactions_get_length(pTxs, errorPointer);
+    for (unsigned int i = 0; *errorPointer == 0 && i < length; i++) {
+        TariCompletedTransaction *pTx = completed_transactions_get_at(pTxs, i, errorPointer);
+        if (*errorPointer != 0) {
+            break;
+        }
+        uint64_t txId;
+        TxIndexRecord record = {};
+        if (ReadCompletedTx(pTx, cancelled, &txId, &record, errorPointer)) {
+            index[txId] = record;
+        }
+        completed_transaction_destroy(pTx);
+    }
+    completed_transactions_destroy(pTxs);
+    return *errorPointer == 0;
+}
+
+static bool IndexPendingInboundTxs(TariPendingInboundTransactions *pTxs, TxIndex &index, int *errorPointer) {
+    unsigned int length = pending_inbound_transactions_get_length(pTxs, errorPointer);
+    for (unsigned int i = 0; *errorPointer == 0 && i < length; i++) {
+        TariPendingInboundTransaction *pTx = pending_inbound_transactions_get_at(pTxs, i, errorPointer);
+        if (*errorPointer != 0) {
+            break;
+        }
+        uint64_t txId;
+        TxIndexRecord record = {};
+        if (ReadPendingInboundTx(pTx, &txId, &record, errorPointer)) {
+            index[txId] = record;
+        }
+        pending_inbound_transaction_destroy(pTx);
+    }
+    pending_inbound_transactions_destroy(pTxs);
+    return *errorPointer == 0;
+}
+
+static bool IndexPendingOutboundTxs(TariPendingOutboundTransactions *pTxs, TxIndex &index, int *errorPointer) {
+    unsigned int length = pending_outbound_transactions_get_length(pTxs, errorPointer);
+    for (unsigned int i = 0; *errorPointer == 0 && i < length; i++) {
+        TariPendingOutboundTransaction *pTx = pending_outbound_transactions_get_at(pTxs, i, errorPointer);
+        if (*errorPointer != 0) {
+            break;
+        }
+        uint64_t txId;
+        TxIndexRecord record = {};
+        if (ReadPendingOutboundTx(pTx, &txId, &record, errorPointer)) {
+            index[txId] = record;
+        }
+        pending_outbound_transaction_destroy(pTx);
+    }
+    pending_outbound_transactions_destroy(pTxs);
+    return *errorPointer == 0;
+}
+
+// Pending first: a tx moves on to completed or cancelled, and should it be read in both lists
+// during the build, the later state wins.
+static bool ReadTxIndex(TariWallet *pWallet, TxIndex &index, int *errorPointer) {
+    TariPendingInboundTransactions *pInbound = wallet_get_pending_inbound_transactions(pWallet, errorPointer);
+    if (*errorPointer != 0 || !IndexPendingInboundTxs(pInbound, index, errorPointer)) {
+        return false;
+    }
+    TariPendingOutboundTransactions *pOutbound = wallet_get_pending_outbound_transactions(pWallet, errorPointer);
+    if (*errorPointer != 0 || !IndexPendingOutboundTxs(pOutbound, index, errorPointer)) {
+        return false;
+    }
+    TariCompletedTransactions *pCompleted = wallet_get_completed_transactions(pWallet, errorPointer);
+    if (*errorPointer != 0 || !IndexCompletedTxs(pCompleted, false, index, errorPointer)) {
+        return false;
+    }
+    TariCompletedTransactions *pCancelled = wallet_get_cancelled_transactions(pWallet, errorPointer);
+    return *errorPointer == 0 && IndexCompletedTxs(pCancelled, true, index, errorPointer);
+}
+
+static bool LookUpTx(const TxIndex &index, uint64_t txId, TxIndexRecord *pRecord) {
+    auto found = index.find(txId);
+    if (found == index.end()) {
+        return false;
+    }
+    *pRecord = found->second;
+    return true;
+}
+
+bool FindIndexedTx(TariWallet *pWallet, uint64_t txId, TxIndexRecord *pRecord, int *errorPointer) {
+    {
+        std::lock_guard<std::mutex> lock(txIndexMutex);
+        if (txIndexBuilt) {
+            return LookUpTx(txIndex, txId, pRecord);
+        }
+    }
+    std::lock_guard<std::mutex> buildLock(txIndexBuildMutex);
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(txIndexMutex);
+        // built by the caller we waited for
+        if (txIndexBuilt) {
+            return LookUpTx(txIndex, txId, pRecord);
+        }
+        txIndexBuilding = true;
+        txIndexSpoiled = false;
+        txIndexChanges.clear();
+        generation = txIndexGeneration;
+    }
+    TxIndex index;
+    bool read = ReadTxIndex(pWallet, index, errorPointer);
+    std::lock_guard<std::mutex> lock(txIndexMutex);
+    txIndexBuilding = false;
+    if (!read) {
+        txIndexChanges.clear();
+        return false;
+    }
+    // in callback order, the last state of a tx wins
+    for (const auto &change : txIndexChanges) {
+        index[change.first] = change.second;
+    }
+    txIndexChanges.clear();
+    bool found = LookUpTx(index, txId, pRecord);
+    // otherwise answer from this build and leave it to the next lookup to try again
+    if (generation == txIndexGeneration && !txIndexSpoiled) {
+        txIndex.swap(index);
+        txIndexBuilt = true;
+        LOGI("Tx index built with %zu txs", txIndex.size());
+    }
+    return found;
+}
+
+// Whether a changed tx needs reading at all. If neither, a build that starts later reads the
+// change from the database, which the library updates before it calls back.
+static bool IsTxIndexLive() {
+    std::lock_guard<std::mutex> lock(txIndexMutex);
+    return txIndexBuilt || txIndexBuilding;
+}
+
+// the tx was read outside txIndexMutex, read is false if that failed
+static void ApplyTxChange(bool read, uint64_t txId, const TxIndexRecord &record) {
+    std::lock_guard<std::mutex> lock(txIndexMutex);
+    if (txIndexBuilt) {
+        if (read) {
+            txIndex[txId] = record;
+        } else {
+            // can't tell which tx changed, start over on the next lookup
+            txIndex.clear();
+            txIndexBuilt = false;
+        }
+    } else if (txIndexBuilding) {
+        if (read) {
+            txIndexChanges.emplace_back(txId, record);
+        } else {
+            txIndexSpoiled = true;
+        }
+    }
+}
+
+void IndexCompletedTx(TariCompletedTransaction *pTx, bool cancelled) {
+    if (!IsTxIndexLive()) {
+        return;
+    }
+    int error = 0;
+    uint64_t txId = 0;
+    TxIndexRecord record = {};
+    bool read = ReadCompletedTx(pTx, cancelled, &txId, &record, &error);
+    ApplyTxChange(read, txId, record);
+}
+
+void IndexPendingInboundTx(TariPendingInboundTransaction *pTx) {
+    if (!IsTxIndexLive()) {
+        return;
+    }
+    int error = 0;
+    uint64_t txId = 0;
+    TxIndexRecord record = {};
+    bool read = ReadPendingInboundTx(pTx, &txId, &record, &error);
+    ApplyTxChange(read, txId, record);
+}
+
+void IndexSentTx(TariWallet *pWallet, uint64_t txId) {
+    if (!IsTxIndexLive()) {
+        return;
+    }
+    // a standard send starts out pending, a one-sided one is completed right away
+    int error = 0;
+    uint64_t readTxId;
+    TxIndexRecord record = {};
+    TariPendingOutboundTransaction *pPending = wallet_get_pending_outbound_transaction_by_id(pWallet, txId, &error);
+    if (error == 0 && pPending != nullptr) {
+        bool read = ReadPendingOutboundTx(pPending, &readTxId, &record, &error);
+        pending_outbound_transaction_destroy(pPending);
+        if (read) {
+            ApplyTxChange(true, txId, record);
+            return;
+        }
+    }
+    error = 0;
+    TariCompletedTransaction *pCompleted = wallet_get_completed_transaction_by_id(pWallet, txId, &error);
+    if (error == 0 && pCompleted != nullptr) {
+        bool read = ReadCompletedTx(pCompleted, false, &readTxId, &record, &error);
+        completed_transaction_destroy(pCompleted);
+        if (read) {
+            ApplyTxChange(true, txId, record);
+            return;
+        }
+    }
+    ApplyTxChange(false, txId, record);
+}
+
+static bool SameRecord(const TxIndexRecord &a, const TxIndexRecord &b) {
+    return a.kind == b.kind && a.status == b.status && a.outbound == b.outbound && a.amount == b.amount
+           && a.fee == b.fee && a.timestamp == b.timestamp && a.confirmations == b.confirmations;
+}
+
+int CheckTxIndex(TariWallet *pWallet, int *errorPointer) {
+    std::lock_guard<std::mutex> lock(txIndexMutex);
+    if (!txIndexBuilt) {
+        return 0;
+    }
+    TxIndex expected;
+    if (!ReadTxIndex(pWallet, expected, errorPointer)) {
+        return -1;
+    }
+    int mismatches = 0;
+    for (const auto &entry : expected) {
+        auto found = txIndex.find(entry.first);
+        if (found == txIndex.end()) {
+            LOGE("Tx index check: tx %llu is missing.", static_cast<unsigned long long>(entry.first));
+            mismatches++;
+        } else if (!SameRecord(found->second, entry.second)) {
+            LOGE("Tx index check: tx %llu is kind %d status %d, the database has kind %d status %d.",
+                 static_cast<unsigned long long>(entry.first), found->second.kind, found->second.status, entry.second.kind, entry.second.status);
+            mismatches++;
+        }
+    }
+    for (const auto &entry : txIndex) {
+        if (expected.find(entry.first) == expected.end()) {
+            LOGE("Tx index check: tx %llu is not in the database.", static_cast<unsigned long long>(entry.first));
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+void ClearTxIndex() {
+    std::lock_guard<std::mutex> lock(txIndexMutex);
+    txIndex.clear();
+    txIndexBuilt = false;
+    txIndexGeneration++;
+}
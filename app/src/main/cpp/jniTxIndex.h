@@ -0,0 +1,95 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstdint>
+
+// uses the wallet.h types, include after wallet.h
+
+/**
+ * Which of the wallet's tx lists a tx is in. Values match the KIND_ constants of IndexedTx.kt.
+ */
+enum TxIndexKind : int32_t {
+    CompletedTxKind = 0,
+    CancelledTxKind = 1,
+    PendingInboundTxKind = 2,
+    PendingOutboundTxKind = 3,
+};
+
+/**
+ * What the tx index keeps per tx id: enough for list rows, status badges and notifications
+ * without a database read.
+ */
+struct TxIndexRecord {
+    int32_t kind;
+    int32_t status;
+    bool outbound;
+    uint64_t amount;
+    uint64_t fee;
+    uint64_t timestamp;
+    uint64_t confirmations;
+};
+
+/**
+ * Looks up a tx by id. The index is built from the four bulk getters (completed, cancelled,
+ * pending inbound and outbound) on first use and kept current through the Index* calls below.
+ * The build runs outside the index lock, so the callbacks aren't held up by it; the changes they
+ * report meanwhile are replayed onto the new index before it is installed. Returns false if there
+ * is no such tx or the index could not be built (errorPointer is set).
+ */
+bool FindIndexedTx(TariWallet *pWallet, uint64_t txId, TxIndexRecord *pRecord, int *errorPointer);
+
+/**
+ * Call from the tx callbacks with the transaction they were given, before it is queued.
+ */
+void IndexCompletedTx(TariCompletedTransaction *pTx, bool cancelled);
+
+void IndexPendingInboundTx(TariPendingInboundTransaction *pTx);
+
+/**
+ * Call after wallet_send_transaction succeeded; no callback reports the new tx.
+ */
+void IndexSentTx(TariWallet *pWallet, uint64_t txId);
+
+/**
+ * Self-check for tests: builds a second index from the database and compares it with the live
+ * one. Returns the number of txs that differ, are missing or are extra, logging each of them, or
+ * -1 if the database could not be read (errorPointer is set). Only meaningful while no tx is
+ * changing, and 0 while the live index has not been built yet.
+ */
+int CheckTxIndex(TariWallet *pWallet, int *errorPointer);
+
+/**
+ * Drops the index, e.g. when the wallet is destroyed. It is rebuilt on the next lookup.
+ */
+void ClearTxIndex();
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <wallet.h>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include "jniCommon.cpp"
+#include "jniTxJournal.h"
+
+const int32_t TxChangesLayoutVersion = 1;
+
+struct TxJournalEntry {
+    uint64_t version;
+    uint64_t txId;
+    uint64_t value;
+    int32_t eventType;
+    int32_t status;
+};
+
+static_assert(sizeof(TxJournalEntry) == 32, "TxChanges.kt decodes 32 byte records");
+
+struct TxChangesHeader {
+    int32_t layoutVersion;
+    int32_t count;
+    int32_t truncated;
+    int32_t reserved;
+    uint64_t latestVersion;
+};
+
+static_assert(sizeof(TxChangesHeader) == 24, "TxChanges.kt decodes a 24 byte header");
+
+static std::mutex txJournalMutex;
+static std::deque<TxJournalEntry> txJournal;
+static uint64_t txJournalLatestVersion = 0;
+// changes up to this version are no longer in the journal
+static uint64_t txJournalDroppedThrough = 0;
+
+static void Journal(int32_t eventType, uint64_t txId, int32_t status, uint64_t value) {
+    std::lock_guard<std::mutex> lock(txJournalMutex);
+    if (txJournal.size() == TxJournalCapacity) {
+        txJournalDroppedThrough = txJournal.front().version;
+        txJournal.pop_front();
+    }
+    TxJournalEntry entry = {++txJournalLatestVersion, txId, value, eventType, status};
+    txJournal.push_back(entry);
+}
+
+void JournalCompletedTx(int32_t eventType, TariCompletedTransaction *pTx, uint64_t value) {
+    int error = 0;
+    unsigned long long txId = completed_transaction_get_transaction_id(pTx, &error);
+    int status = error == 0 ? completed_transaction_get_status(pTx, &error) : 0;
+    if (error != 0) {
+        LOGE("Tx change could not be read (%d), not journaled.", error);
+        return;
+    }
+    Journal(eventType, txId, status, value);
+}
+
+void JournalPendingInboundTx(int32_t eventType, TariPendingInboundTransaction *pTx) {
+    int error = 0;
+    unsigned long long txId = pending_inbound_transaction_get_transaction_id(pTx, &error);
+    int status = error == 0 ? pending_inbound_transaction_get_status(pTx, &error) : 0;
+    if (error != 0) {
+        LOGE("Tx change could not be read (%d), not journaled.", error);
+        return;
+    }
+    Journal(eventType, txId, status, 0);
+}
+
+void JournalSentTx(TariWallet *pWallet, uint64_t txId) {
+    int error = 0;
+    int status = 0;
+    TariPendingOutboundTransaction *pPending = wallet_get_pending_outbound_transaction_by_id(pWallet, txId, &error);
+    if (error == 0 && pPending != nullptr) {
+        status = pending_outbound_transaction_get_status(pPending, &error);
+        pending_outbound_transaction_destroy(pPending);
+    } else {
+        // a one-sided send is completed right away
+        error = 0;
+        TariCompletedTransaction *pCompleted = wallet_get_completed_transaction_by_id(pWallet, txId, &error);
+        if (error == 0 && pCompleted != nullptr) {
+            status = completed_transaction_get_status(pCompleted, &error);
+            completed_transaction_destroy(pCompleted);
+        } else if (error == 0) {
+            error = -1;
+        }
+    }
+    if (error != 0) {
+        LOGE("Sent tx could not be read (%d), not journaled.", error);
+        return;
+    }
+    Journal(TxSentJournalEvent, txId, status, 0);
+}
+
+std::vector<unsigned char> PackTxChangesSince(uint64_t version) {
+    std::lock_guard<std::mutex> lock(txJournalMutex);
+    // entries are in version order, the first one newer than version is found by its offset
+    size_t first = txJournal.size();
+    if (!txJournal.empty() && version < txJournal.back().version) {
+        uint64_t oldest = txJournal.front().version;
+        first = version < oldest ? 0 : static_cast<size_t>(version - oldest + 1);
+    }
+    TxChangesHeader header = {};
+    header.layoutVersion = TxChangesLayoutVersion;
+    header.count = static_cast<int32_t>(txJournal.size() - first);
+    header.truncated = version < txJournalDroppedThrough || version > txJournalLatestVersion ? 1 : 0;
+    header.latestVersion = txJournalLatestVersion;
+    std::vector<unsigned char> packed(sizeof(header) + header.count * sizeof(TxJournalEntry));
+    memcpy(packed.data(), &header, sizeof(header));
+    unsigned char *pRecord = packed.data() + sizeof(header);
+    for (size_t i = first; i < txJournal.size(); i++, pRecord += sizeof(TxJournalEntry)) {
+        memcpy(pRecord, &txJournal[i], sizeof(TxJournalEntry));
+    }
+    return packed;
+}
+
+void ClearTxJournal() {
+    std::lock_guard<std::mutex> lock(txJournalMutex);
+    txJournal.clear();
+    txJournalDroppedThrough = txJournalLatestVersion;
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// uses the wallet.h types, include after wallet.h
+
+/**
+ * Change journal of the tx callbacks. Every state transition the bridge sees is stamped with the
+ * next version, so a poller asks for what changed since the last version it saw instead of
+ * re-reading the whole history. The newest TxJournalCapacity entries are kept.
+ */
+const size_t TxJournalCapacity = 4096;
+
+/**
+ * Call from the tx callbacks with the transaction they were given, before it is queued. eventType
+ * is the WalletEventType of the callback and value its u64 argument (confirmations or rejection
+ * reason), 0 if it has none.
+ */
+void JournalCompletedTx(int32_t eventType, TariCompletedTransaction *pTx, uint64_t value = 0);
+
+void JournalPendingInboundTx(int32_t eventType, TariPendingInboundTransaction *pTx);
+
+/**
+ * Event type journaled for a tx this wallet sent. No callback reports it, so it is outside
+ * WalletEventType; matches TxChange.SENT_EVENT in TxChanges.kt.
+ */
+const int32_t TxSentJournalEvent = 0;
+
+/**
+ * Call after wallet_send_transaction succeeded. Journals the new pending outbound tx, or the
+ * completed one for a one-sided send.
+ */
+void JournalSentTx(TariWallet *pWallet, uint64_t txId);
+
+/**
+ * Packs the entries newer than version for FFIWallet.jniGetChangesSince, decoded by TxChanges.kt.
+ * Keep both in sync. In native byte order: a header {layout version, entry count, truncated,
+ * reserved (int32 each), latest version (u64)} followed by one record per entry, oldest first,
+ * {version, tx id, value (u64 each), event type, status (int32 each)}. truncated is 1 when entries
+ * newer than version were already dropped, or when version is newer than any this journal handed
+ * out (it came from an earlier process); the poller then has to re-read the full lists.
+ */
+std::vector<unsigned char> PackTxChangesSince(uint64_t version);
+
+/**
+ * Drops all entries, e.g. when the wallet is destroyed. Versions keep counting up, so a poller
+ * holding an older version is told its changes were truncated.
+ */
+void ClearTxJournal();
@@ -0,0 +1,275 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <cstdint>
+#include <cstring>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "jniUtf.h"
+
+static const jchar ReplacementChar = 0xFFFD;
+
+// Decodes the multi-byte sequence starting at utf8[i], appends it to out and returns the index of
+// the next sequence. A broken sequence becomes a single U+FFFD and decoding resumes at the first
+// byte that doesn't belong to it.
+static inline size_t DecodeUtf8Sequence(const unsigned char *utf8, size_t i, size_t length, jchar *out, size_t *o) {
+    unsigned int c = utf8[i];
+    size_t continuationBytes = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : 1;
+    // the common case, a complete sequence, decoded without a loop
+    if (i + continuationBytes < length) {
+        unsigned int c1 = utf8[i + 1];
+        if (continuationBytes == 3) {
+            unsigned int c2 = utf8[i + 2];
+            unsigned int c3 = utf8[i + 3];
+            unsigned int codePoint = ((c & 0x07) << 18) | ((c1 & 0x3F) << 12) | ((c2 & 0x3F) << 6) | (c3 & 0x3F);
+            if (c <= 0xF4 && ((c1 & 0xC0) | ((c2 & 0xC0) >> 2) | ((c3 & 0xC0) >> 4)) == 0xA8
+                    && codePoint >= 0x10000 && codePoint <= 0x10FFFF) {
+                codePoint -= 0x10000;
+                out[(*o)++] = static_cast<jchar>(0xD800 + (codePoint >> 10));
+                out[(*o)++] = static_cast<jchar>(0xDC00 + (codePoint & 0x3FF));
+                return i + 4;
+            }
+        } else if (continuationBytes == 2) {
+            unsigned int c2 = utf8[i + 2];
+            unsigned int codePoint = ((c & 0x0F) << 12) | ((c1 & 0x3F) << 6) | (c2 & 0x3F);
+            if (((c1 & 0xC0) | ((c2 & 0xC0) >> 2)) == 0xA0 && codePoint >= 0x800 && (codePoint < 0xD800 || codePoint > 0xDFFF)) {
+                out[(*o)++] = static_cast<jchar>(codePoint);
+                return i + 3;
+            }
+        } else if (c >= 0xC2 && (c1 & 0xC0) == 0x80) {
+            out[(*o)++] = static_cast<jchar>(((c & 0x1F) << 6) | (c1 & 0x3F));
+            return i + 2;
+        }
+    }
+    // anything else, one byte at a time so a broken sequence is cut where it breaks
+    unsigned int codePoint;
+    unsigned int minCodePoint;
+    if (c >= 0xC2 && c <= 0xDF) {
+        codePoint = c & 0x1F;
+        minCodePoint = 0x80;
+    } else if ((c & 0xF0) == 0xE0) {
+        codePoint = c & 0x0F;
+        minCodePoint = 0x800;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        codePoint = c & 0x07;
+        minCodePoint = 0x10000;
+    } else {
+        out[(*o)++] = ReplacementChar;
+        return i + 1;
+    }
+    size_t end = i + 1 + continuationBytes;
+    for (i++; i < end; i++) {
+        if (i >= length || (utf8[i] & 0xC0) != 0x80) {
+            out[(*o)++] = ReplacementChar;
+            return i;
+        }
+        codePoint = (codePoint << 6) | (utf8[i] & 0x3F);
+    }
+    if (codePoint < minCodePoint || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+        out[(*o)++] = ReplacementChar;
+    } else if (codePoint >= 0x10000) {
+        codePoint -= 0x10000;
+        out[(*o)++] = static_cast<jchar>(0xD800 + (codePoint >> 10));
+        out[(*o)++] = static_cast<jchar>(0xDC00 + (codePoint & 0x3FF));
+    } else {
+        out[(*o)++] = static_cast<jchar>(codePoint);
+    }
+    return end;
+}
+
+// Encodes the non-ASCII char at utf16[i], or the surrogate pair starting there, and returns the
+// index of the next char.
+static inline size_t EncodeUtf8Sequence(const jchar *utf16, size_t i, size_t length, unsigned char *out, size_t *o) {
+    unsigned int c = utf16[i];
+    if (c < 0x800) {
+        out[(*o)++] = static_cast<unsigned char>(0xC0 | (c >> 6));
+        out[(*o)++] = static_cast<unsigned char>(0x80 | (c & 0x3F));
+        return i + 1;
+    }
+    if (c >= 0xD800 && c <= 0xDFFF) {
+        if (c <= 0xDBFF && i + 1 < length && utf16[i + 1] >= 0xDC00 && utf16[i + 1] <= 0xDFFF) {
+            unsigned int codePoint = 0x10000 + ((c - 0xD800) << 10) + (utf16[i + 1] - 0xDC00);
+            out[(*o)++] = static_cast<unsigned char>(0xF0 | (codePoint >> 18));
+            out[(*o)++] = static_cast<unsigned char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out[(*o)++] = static_cast<unsigned char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out[(*o)++] = static_cast<unsigned char>(0x80 | (codePoint & 0x3F));
+            return i + 2;
+        }
+        c = ReplacementChar;
+    }
+    out[(*o)++] = static_cast<unsigned char>(0xE0 | (c >> 12));
+    out[(*o)++] = static_cast<unsigned char>(0x80 | ((c >> 6) & 0x3F));
+    out[(*o)++] = static_cast<unsigned char>(0x80 | (c & 0x3F));
+    return i + 1;
+}
+
+// The block functions below convert a whole block of AsciiBlockSize chars unconditionally and
+// return how many of them, from the start, were ASCII. Only that many are kept: the rest of the
+// output is overwritten by the scalar path, so the caller must leave room for a full block.
+
+// index of the first byte with its high bit set in a 16 byte block split into two 64 bit halves
+static inline size_t LeadingAscii(uint64_t low, uint64_t high) {
+    const uint64_t highBits = 0x8080808080808080ULL;
+    if ((low & highBits) != 0) {
+        return static_cast<size_t>(__builtin_ctzll(low & highBits)) / 8;
+    }
+    if ((high & highBits) != 0) {
+        return 8 + static_cast<size_t>(__builtin_ctzll(high & highBits)) / 8;
+    }
+    return 16;
+}
+
+static const size_t AsciiBlockSize = 16;
+
+#if defined(__ARM_NEON)
+
+static inline size_t WidenAsciiBlock(const unsigned char *utf8, jchar *out) {
+    uint8x16_t block = vld1q_u8(utf8);
+    vst1q_u16(reinterpret_cast<uint16_t *>(out), vmovl_u8(vget_low_u8(block)));
+    vst1q_u16(reinterpret_cast<uint16_t *>(out) + 8, vmovl_u8(vget_high_u8(block)));
+    uint64x2_t lanes = vreinterpretq_u64_u8(block);
+    return LeadingAscii(vgetq_lane_u64(lanes, 0), vgetq_lane_u64(lanes, 1));
+}
+
+// the saturating narrow maps every char above 0x7F to a byte with its high bit set
+static inline size_t NarrowAsciiBlock(const jchar *utf16, unsigned char *out) {
+    uint16x8_t low = vld1q_u16(reinterpret_cast<const uint16_t *>(utf16));
+    uint16x8_t high = vld1q_u16(reinterpret_cast<const uint16_t *>(utf16) + 8);
+    uint8x16_t block = vcombine_u8(vqmovn_u16(low), vqmovn_u16(high));
+    vst1q_u8(out, block);
+    uint64x2_t lanes = vreinterpretq_u64_u8(block);
+    return LeadingAscii(vgetq_lane_u64(lanes, 0), vgetq_lane_u64(lanes, 1));
+}
+
+#elif defined(__SSE2__)
+
+static inline size_t LeadingAscii(__m128i block) {
+    unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(block));
+    return mask == 0 ? 16 : static_cast<size_t>(__builtin_ctz(mask));
+}
+
+static inline size_t WidenAsciiBlock(const unsigned char *utf8, jchar *out) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf8));
+    __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(block, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpackhi_epi8(block, zero));
+    return LeadingAscii(block);
+}
+
+// packus saturates every char above 0x7F to a byte with its high bit set; the chars are unsigned
+// but 0x8000 and up read as negative and saturate to 0, so those are flagged separately
+static inline size_t NarrowAsciiBlock(const jchar *utf16, unsigned char *out) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf16));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf16 + 8));
+    __m128i block = _mm_packus_epi16(low, high);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), block);
+    __m128i negative = _mm_packs_epi16(_mm_srai_epi16(low, 15), _mm_srai_epi16(high, 15));
+    return LeadingAscii(_mm_or_si128(block, negative));
+}
+
+#else
+
+static inline size_t WidenAsciiBlock(const unsigned char *utf8, jchar *out) {
+    uint64_t low, high;
+    memcpy(&low, utf8, 8);
+    memcpy(&high, utf8 + 8, 8);
+    for (size_t i = 0; i < AsciiBlockSize; i++) {
+        out[i] = utf8[i];
+    }
+    return LeadingAscii(low, high);
+}
+
+static inline size_t NarrowAsciiBlock(const jchar *utf16, unsigned char *out) {
+    for (size_t i = 0; i < AsciiBlockSize; i++) {
+        if (utf16[i] >= 0x80) {
+            return i;
+        }
+        out[i] = static_cast<unsigned char>(utf16[i]);
+    }
+    return AsciiBlockSize;
+}
+
+#endif
+
+// Output never runs ahead of input in chars, so out + o has room for a full block whenever there
+// is one left to read: o <= i for Utf8ToUtf16 and o <= 3 * i for Utf16ToUtf8.
+
+size_t Utf8ToUtf16(const char *utf8, size_t length, jchar *out) {
+    auto in = reinterpret_cast<const unsigned char *>(utf8);
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        if (length - i >= AsciiBlockSize) {
+            size_t ascii = WidenAsciiBlock(in + i, out + o);
+            i += ascii;
+            o += ascii;
+            if (ascii == AsciiBlockSize) {
+                continue;
+            }
+        } else if (in[i] < 0x80) {
+            out[o++] = in[i++];
+            continue;
+        }
+        // stay scalar through a run of non-ASCII, e.g. an emoji id, rather than retry a block per char
+        do {
+            i = DecodeUtf8Sequence(in, i, length, out, &o);
+        } while (i < length && in[i] >= 0x80);
+    }
+    return o;
+}
+
+size_t Utf16ToUtf8(const jchar *utf16, size_t length, char *out) {
+    auto bytes = reinterpret_cast<unsigned char *>(out);
+    size_t i = 0;
+    size_t o = 0;
+    while (i < length) {
+        if (length - i >= AsciiBlockSize) {
+            size_t ascii = NarrowAsciiBlock(utf16 + i, bytes + o);
+            i += ascii;
+            o += ascii;
+            if (ascii == AsciiBlockSize) {
+                continue;
+            }
+        } else if (utf16[i] < 0x80) {
+            bytes[o++] = static_cast<unsigned char>(utf16[i++]);
+            continue;
+        }
+        do {
+            i = EncodeUtf8Sequence(utf16, i, length, bytes, &o);
+        } while (i < length && utf16[i] >= 0x80);
+    }
+    return o;
+}
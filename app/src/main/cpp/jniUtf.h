@@ -0,0 +1,56 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <jni.h>
+#include <cstddef>
+
+/**
+ * UTF-8 <-> UTF-16 transcoding for strings crossing the bridge. The library speaks real UTF-8 and
+ * Java strings are UTF-16; JNI's own UTF functions use modified UTF-8 instead, which differs for NUL
+ * and for everything outside the BMP, i.e. every emoji. Runs of ASCII are converted 16 chars per
+ * step with NEON on ARM and SSE2 on x86, everything else goes through the scalar path.
+ */
+
+/**
+ * Converts length bytes of UTF-8 to UTF-16 and returns the number of chars written. out must hold
+ * length chars, which is always enough. Malformed and overlong sequences, surrogates and code
+ * points past U+10FFFF become U+FFFD.
+ */
+size_t Utf8ToUtf16(const char *utf8, size_t length, jchar *out);
+
+/**
+ * Converts length UTF-16 chars to UTF-8 and returns the number of bytes written, without a
+ * terminating NUL. out must hold 3 * length bytes. Unpaired surrogates become U+FFFD.
+ */
+size_t Utf16ToUtf8(const jchar *utf16, size_t length, char *out);
@@ -36,8 +36,18 @@
 #include <wallet.h>
 #include <string>
 #include <cmath>
+#include <atomic>
+#include <pthread.h>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniWalletEvents.h"
+#include "jniCallbackStats.h"
+#include "jniContactIndex.h"
+#include "jniBalanceCache.h"
+#include "jniTxJournal.h"
+#include "jniTxIndex.h"
+#include "jniFeeEstimateCache.h"
+#include "jniKeyValueCache.h"
 
 /**
  * Java virtual machine pointer for later use in callbacks.
@@ -45,16 +55,117 @@
 JavaVM *g_vm;
 
 /**
- * Called by the environment on JNI load.
+ * Callback threads are owned by the wallet library. They are attached to the VM on their first
+ * callback and stay attached until they exit, when the destructor of this key detaches them.
+ */
+pthread_key_t callbackThreadKey;
+
+// callback thread counters, reported by jniGetCallbackThreadStats
+std::atomic<long long> callbackCount(0);
+std::atomic<long long> callbackThreadAttachCount(0);
+std::atomic<long long> callbackThreadDetachCount(0);
+std::atomic<long long> callbackStatsStartNanos(0);
+
+void detachCallbackThread(void *) {
+    callbackThreadDetachCount++;
+    g_vm->DetachCurrentThread();
+}
+
+/**
+ * RegisterNatives binding tables, defined at the bottom of each jni*.cpp file.
+ */
+jint RegisterBalanceNatives(JNIEnv *jEnv);
+jint RegisterBase58Natives(JNIEnv *jEnv);
+jint RegisterByteVectorNatives(JNIEnv *jEnv);
+jint RegisterCollectionsNatives(JNIEnv *jEnv);
+jint RegisterCommsConfigNatives(JNIEnv *jEnv);
+jint RegisterCompletedTransactionNatives(JNIEnv *jEnv);
+jint RegisterCompletedTransactionKernelNatives(JNIEnv *jEnv);
+jint RegisterContactNatives(JNIEnv *jEnv);
+jint RegisterCovenantNatives(JNIEnv *jEnv);
+jint RegisterEmojiIdCacheNatives(JNIEnv *jEnv);
+jint RegisterEmojiSetNatives(JNIEnv *jEnv);
+jint RegisterHexNatives(JNIEnv *jEnv);
+jint RegisterPendingInboundTransactionNatives(JNIEnv *jEnv);
+jint RegisterPendingOutboundTransactionNatives(JNIEnv *jEnv);
+jint RegisterPublicKeyNatives(JNIEnv *jEnv);
+jint RegisterSeedWordsNatives(JNIEnv *jEnv);
+jint RegisterTariBaseNodeStateNatives(JNIEnv *jEnv);
+jint RegisterTariCoinPreviewNatives(JNIEnv *jEnv);
+jint RegisterTariFeePerGramStatNatives(JNIEnv *jEnv);
+jint RegisterTariFeePerGramStatsNatives(JNIEnv *jEnv);
+jint RegisterTariTransportConfigNatives(JNIEnv *jEnv);
+jint RegisterTariUnblindedOutputNatives(JNIEnv *jEnv);
+jint RegisterTariUtxoNatives(JNIEnv *jEnv);
+jint RegisterTariVectorNatives(JNIEnv *jEnv);
+jint RegisterTariWalletAddressNatives(JNIEnv *jEnv);
+jint RegisterTransactionSendStatusNatives(JNIEnv *jEnv);
+jint RegisterWalletNatives(JNIEnv *jEnv);
+
+typedef jint (*NativesRegistration)(JNIEnv *);
+
+static const NativesRegistration nativesRegistrations[] = {
+        RegisterBalanceNatives,
+        RegisterBase58Natives,
+        RegisterByteVectorNatives,
+        RegisterCollectionsNatives,
+        RegisterCommsConfigNatives,
+        RegisterCompletedTransactionNatives,
+        RegisterCompletedTransactionKernelNatives,
+        RegisterContactNatives,
+        RegisterCovenantNatives,
+        RegisterEmojiIdCacheNatives,
+        RegisterEmojiSetNatives,
+        RegisterHexNatives,
+        RegisterPendingInboundTransactionNatives,
+        RegisterPendingOutboundTransactionNatives,
+        RegisterPublicKeyNatives,
+        RegisterSeedWordsNatives,
+        RegisterTariBaseNodeStateNatives,
+        RegisterTariCoinPreviewNatives,
+        RegisterTariFeePerGramStatNatives,
+        RegisterTariFeePerGramStatsNatives,
+        RegisterTariTransportConfigNatives,
+        RegisterTariUnblindedOutputNatives,
+        RegisterTariUtxoNatives,
+        RegisterTariVectorNatives,
+        RegisterTariWalletAddressNatives,
+        RegisterTransactionSendStatusNatives,
+        RegisterWalletNatives,
+};
+
+/**
+ * Called by the environment on JNI load. Resolves the JNI ID registry used by every entry point
+ * and binds all native methods explicitly, so none of them has to be looked up by symbol name.
  */
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *) {
+    long long start = MonotonicNanos();
     g_vm = vm;
+    JNIEnv *jEnv;
+    if (vm->GetEnv((void **) &jEnv, JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
+    if (pthread_key_create(&callbackThreadKey, detachCallbackThread) != 0) {
+        LOGE("Failed to create the callback thread key.");
+        return JNI_ERR;
+    }
+    if (!LoadJniIds(jEnv)) {
+        LOGE("Failed to resolve JNI IDs.");
+        return JNI_ERR;
+    }
+    for (NativesRegistration registration : nativesRegistrations) {
+        if (registration(jEnv) != JNI_OK) {
+            return JNI_ERR;
+        }
+    }
+    LOGI("JNI_OnLoad finished in %lld us.", (MonotonicNanos() - start) / 1000);
     return JNI_VERSION_1_6;
 }
 
 /**
  * Helper method to get JNI environment attached to the current thread.
- * Used in callback functions.
+ * Used in callback functions. A thread is attached the first time it calls back and is detached
+ * by detachCallbackThread when it exits, so callbacks must not detach it themselves.
  */
 JNIEnv *getJNIEnv() {
     JNIEnv *jniEnv;
@@ -62,9 +173,13 @@ JNIEnv *getJNIEnv() {
     int getEnvStat = g_vm->GetEnv((void **) &jniEnv, JNI_VERSION_1_6);
     switch (getEnvStat) {
         case JNI_EDETACHED: {
+            long long attachStart = MonotonicNanos();
             if (g_vm->AttachCurrentThread(&jniEnv, nullptr) != 0) {
                 LOGE("VM failed to attach.");
             } else {
+                RecordThreadAttachNanos(MonotonicNanos() - attachStart);
+                callbackThreadAttachCount++;
+                pthread_setspecific(callbackThreadKey, jniEnv);
                 result = jniEnv;
             }
             break;
@@ -82,189 +197,278 @@ JNIEnv *getJNIEnv() {
 // Wallet is a singleton so only one of each is needed, should wallet be a class these would
 // have to be arrays with some means to track which wallet maps to which functions
 jobject callbackHandler = nullptr;
-jmethodID txReceivedCallbackMethodId;
-jmethodID txReplyReceivedCallbackMethodId;
-jmethodID txFinalizedCallbackMethodId;
-jmethodID txBroadcastCallbackMethodId;
-jmethodID txMinedCallbackMethodId;
-jmethodID txMinedUnconfirmedCallbackMethodId;
-jmethodID txFauxConfirmedCallbackMethodId;
-jmethodID txFauxUnconfirmedCallbackMethodId;
-jmethodID directSendResultCallbackMethodId;
-jmethodID txCancellationCallbackMethodId;
-jmethodID contactsLivenessDataUpdatedCallbackMethodId;
-jmethodID connectivityStatusCallbackId;
-jmethodID txoValidationCompleteCallbackMethodId;
-jmethodID transactionValidationCompleteCallbackMethodId;
-jmethodID recoveringProcessCompleteCallbackMethodId;
-jmethodID balanceUpdatedCallbackMethodId;
-jmethodID walletScannedHeightCallbackMethodId;
-jmethodID baseNodeStatusCallbackMethodId;
+// set from jniCreate, true to pass u64 callback arguments as 8-byte arrays (former transport)
+bool u64CallbackArgsAsByteArrays = false;
 
-void txBroadcastCallback(TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
+/**
+ * Calls the FFIWallet callback matching the event on the current thread. Used when the event queue
+ * is disabled, otherwise the dispatcher hands events to FFIWallet.onEvents in batches.
+ */
+void DeliverWalletEvent(JNIEnv *jniEnv, const WalletEvent &event) {
+    const JniIds &ids = GetJniIds();
+    jlong pointer = event.pointer;
+    bool asBytes = u64CallbackArgsAsByteArrays;
+    switch (event.type) {
+        case TxReceivedEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.txReceivedCallbackMethodId, pointer);
+            break;
+        case TxReplyReceivedEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.txReplyReceivedCallbackMethodId, pointer);
+            break;
+        case TxFinalizedEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.txFinalizedCallbackMethodId, pointer);
+            break;
+        case TxBroadcastEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.txBroadcastCallbackMethodId, pointer);
+            break;
+        case TxMinedEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.txMinedCallbackMethodId, pointer);
+            break;
+        case TxMinedUnconfirmedEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.txMinedUnconfirmedCallbackMethodId, pointer,
+                                       getBytesFromUnsignedLongLong(jniEnv, event.value1));
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.txMinedUnconfirmedU64CallbackMethodId, pointer,
+                                       getLongFromUnsignedLongLong(event.value1));
+            }
+            break;
+        case TxFauxConfirmedEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.txFauxConfirmedCallbackMethodId, pointer);
+            break;
+        case TxFauxUnconfirmedEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.txFauxUnconfirmedCallbackMethodId, pointer,
+                                       getBytesFromUnsignedLongLong(jniEnv, event.value1));
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.txFauxUnconfirmedU64CallbackMethodId, pointer,
+                                       getLongFromUnsignedLongLong(event.value1));
+            }
+            break;
+        case TxDirectSendResultEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.directSendResultCallbackMethodId,
+                                       getBytesFromUnsignedLongLong(jniEnv, event.value1), pointer);
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.directSendResultU64CallbackMethodId,
+                                       getLongFromUnsignedLongLong(event.value1), pointer);
+            }
+            break;
+        case TxCancelledEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.txCancellationCallbackMethodId, pointer,
+                                       getBytesFromUnsignedLongLong(jniEnv, event.value1));
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.txCancellationU64CallbackMethodId, pointer,
+                                       getLongFromUnsignedLongLong(event.value1));
+            }
+            break;
+        case TxoValidationCompleteEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.txoValidationCompleteCallbackMethodId,
+                                       getBytesFromUnsignedLongLong(jniEnv, event.value1), getBytesFromUnsignedLongLong(jniEnv, event.value2));
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.txoValidationCompleteU64CallbackMethodId,
+                                       getLongFromUnsignedLongLong(event.value1), getLongFromUnsignedLongLong(event.value2));
+            }
+            break;
+        case TxValidationCompleteEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.transactionValidationCompleteCallbackMethodId,
+                                       getBytesFromUnsignedLongLong(jniEnv, event.value1), getBytesFromUnsignedLongLong(jniEnv, event.value2));
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.transactionValidationCompleteU64CallbackMethodId,
+                                       getLongFromUnsignedLongLong(event.value1), getLongFromUnsignedLongLong(event.value2));
+            }
+            break;
+        case ContactsLivenessDataUpdatedEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.contactsLivenessDataUpdatedCallbackMethodId, pointer);
+            break;
+        case BalanceUpdatedEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.balanceUpdatedCallbackMethodId, pointer);
+            break;
+        case ConnectivityStatusEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.connectivityStatusCallbackId, getBytesFromUnsignedLongLong(jniEnv, event.value1));
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.connectivityStatusU64CallbackId, getLongFromUnsignedLongLong(event.value1));
+            }
+            break;
+        case WalletScannedHeightEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.walletScannedHeightCallbackMethodId, getBytesFromUnsignedLongLong(jniEnv, event.value1));
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.walletScannedHeightU64CallbackMethodId, getLongFromUnsignedLongLong(event.value1));
+            }
+            break;
+        case BaseNodeStatusEvent:
+            jniEnv->CallVoidMethod(callbackHandler, ids.baseNodeStatusCallbackMethodId, pointer);
+            break;
+        case WalletRecoveryEvent:
+            if (asBytes) {
+                jniEnv->CallVoidMethod(callbackHandler, ids.recoveringProcessCompleteCallbackMethodId, static_cast<jint>(event.intArg),
+                                       getBytesFromUnsignedLongLong(jniEnv, event.value1), getBytesFromUnsignedLongLong(jniEnv, event.value2));
+            } else {
+                jniEnv->CallVoidMethod(callbackHandler, ids.recoveringProcessCompleteU64CallbackMethodId, static_cast<jint>(event.intArg),
+                                       getLongFromUnsignedLongLong(event.value1), getLongFromUnsignedLongLong(event.value2));
+            }
+            break;
+        default:
+            LOGE("Unknown wallet event %d.", event.type);
     }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txBroadcastCallbackMethodId, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
 }
 
-void txMinedCallback(TariCompletedTransaction *pCompletedTransaction) {
+/**
+ * Records the time the library's thread spends in a callback when it goes out of scope. Every
+ * callback starts one first thing, so the journal, index and cache updates it makes before the
+ * event is queued are counted as well.
+ */
+struct CallbackTimer {
+    int32_t type;
+    long long start;
+
+    explicit CallbackTimer(int32_t type) : type(type), start(MonotonicNanos()) {}
+
+    ~CallbackTimer() {
+        RecordCallbackNanos(type, MonotonicNanos() - start);
+    }
+};
+
+/**
+ * Common path of every wallet callback: queue the event for the dispatcher thread, or deliver it
+ * right away on the library's thread when the queue is disabled.
+ */
+void OnWalletEvent(int32_t type, const void *pointer, uint64_t value1 = 0, uint64_t value2 = 0, int32_t intArg = 0) {
+    callbackCount++;
+    WalletEvent event = {};
+    event.type = type;
+    event.intArg = intArg;
+    event.pointer = reinterpret_cast<jlong>(pointer);
+    event.value1 = value1;
+    event.value2 = value2;
+    if (PostWalletEvent(event)) {
+        return;
+    }
     auto *jniEnv = getJNIEnv();
     if (jniEnv == nullptr || callbackHandler == nullptr) {
         return;
     }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txMinedCallbackMethodId, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    // callback threads stay attached, so local references would otherwise pile up until they exit
+    if (jniEnv->PushLocalFrame(4) != JNI_OK) {
+        jniEnv->ExceptionClear();
+        return;
+    }
+    DeliverWalletEvent(jniEnv, event);
+    if (jniEnv->ExceptionCheck()) {
+        jniEnv->ExceptionDescribe();
+        jniEnv->ExceptionClear();
+    }
+    jniEnv->PopLocalFrame(nullptr);
+}
+
+void txBroadcastCallback(TariCompletedTransaction *pCompletedTransaction) {
+    CallbackTimer timer(TxBroadcastEvent);
+    JournalCompletedTx(TxBroadcastEvent, pCompletedTransaction);
+    IndexCompletedTx(pCompletedTransaction, false);
+    OnWalletEvent(TxBroadcastEvent, pCompletedTransaction);
+}
+
+void txMinedCallback(TariCompletedTransaction *pCompletedTransaction) {
+    CallbackTimer timer(TxMinedEvent);
+    JournalCompletedTx(TxMinedEvent, pCompletedTransaction);
+    IndexCompletedTx(pCompletedTransaction, false);
+    InvalidateFeeEstimates();
+    OnWalletEvent(TxMinedEvent, pCompletedTransaction);
 }
 
 void txMinedUnconfirmedCallback(TariCompletedTransaction *pCompletedTransaction, uint64_t confirmationCount) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, confirmationCount);
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txMinedUnconfirmedCallbackMethodId, jpCompletedTransaction, bytes);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxMinedUnconfirmedEvent);
+    JournalCompletedTx(TxMinedUnconfirmedEvent, pCompletedTransaction, confirmationCount);
+    IndexCompletedTx(pCompletedTransaction, false);
+    OnWalletEvent(TxMinedUnconfirmedEvent, pCompletedTransaction, confirmationCount);
 }
 
 void txFauxConfirmedCallback(TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txFauxConfirmedCallbackMethodId, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxFauxConfirmedEvent);
+    JournalCompletedTx(TxFauxConfirmedEvent, pCompletedTransaction);
+    IndexCompletedTx(pCompletedTransaction, false);
+    InvalidateFeeEstimates();
+    OnWalletEvent(TxFauxConfirmedEvent, pCompletedTransaction);
 }
 
 void txFauxUnconfirmedCallback(TariCompletedTransaction *pCompletedTransaction, uint64_t confirmationCount) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, confirmationCount);
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txFauxUnconfirmedCallbackMethodId, jpCompletedTransaction, bytes);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxFauxUnconfirmedEvent);
+    JournalCompletedTx(TxFauxUnconfirmedEvent, pCompletedTransaction, confirmationCount);
+    IndexCompletedTx(pCompletedTransaction, false);
+    OnWalletEvent(TxFauxUnconfirmedEvent, pCompletedTransaction, confirmationCount);
 }
 
 void txReceivedCallback(TariPendingInboundTransaction *pPendingInboundTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    auto jpPendingInboundTransaction = reinterpret_cast<jlong>(pPendingInboundTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txReceivedCallbackMethodId, jpPendingInboundTransaction);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxReceivedEvent);
+    JournalPendingInboundTx(TxReceivedEvent, pPendingInboundTransaction);
+    IndexPendingInboundTx(pPendingInboundTransaction);
+    OnWalletEvent(TxReceivedEvent, pPendingInboundTransaction);
 }
 
 void txReplyReceivedCallback(TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txReplyReceivedCallbackMethodId, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxReplyReceivedEvent);
+    JournalCompletedTx(TxReplyReceivedEvent, pCompletedTransaction);
+    IndexCompletedTx(pCompletedTransaction, false);
+    OnWalletEvent(TxReplyReceivedEvent, pCompletedTransaction);
 }
 
 void txFinalizedCallback(TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txFinalizedCallbackMethodId, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxFinalizedEvent);
+    JournalCompletedTx(TxFinalizedEvent, pCompletedTransaction);
+    IndexCompletedTx(pCompletedTransaction, false);
+    OnWalletEvent(TxFinalizedEvent, pCompletedTransaction);
 }
 
 void txDirectSendResultCallback(unsigned long long txId, TariTransactionSendStatus *status) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, txId);
-    jniEnv->CallVoidMethod(callbackHandler, directSendResultCallbackMethodId, bytes, status);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxDirectSendResultEvent);
+    OnWalletEvent(TxDirectSendResultEvent, status, txId);
 }
 
 void
 txCancellationCallback(TariCompletedTransaction *pCompletedTransaction, uint64_t rejectionReason) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, rejectionReason);
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jniEnv->CallVoidMethod(callbackHandler, txCancellationCallbackMethodId, jpCompletedTransaction, bytes);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxCancelledEvent);
+    JournalCompletedTx(TxCancelledEvent, pCompletedTransaction, rejectionReason);
+    IndexCompletedTx(pCompletedTransaction, true);
+    InvalidateFeeEstimates();
+    OnWalletEvent(TxCancelledEvent, pCompletedTransaction, rejectionReason);
 }
 
 void txoValidationCompleteCallback(uint64_t requestId, uint64_t status) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, requestId);
-    jbyteArray statusBytes = getBytesFromUnsignedLongLong(jniEnv, status);
-    jniEnv->CallVoidMethod(callbackHandler, txoValidationCompleteCallbackMethodId, requestIdBytes, statusBytes);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxoValidationCompleteEvent);
+    OnWalletEvent(TxoValidationCompleteEvent, nullptr, requestId, status);
 }
 
 void contactsLivenessDataUpdatedCallback(TariContactsLivenessData *pTariContactsLivenessData) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    auto jpTariContactsLivenessData = reinterpret_cast<jlong>(pTariContactsLivenessData);
-    jniEnv->CallVoidMethod(callbackHandler, contactsLivenessDataUpdatedCallbackMethodId, jpTariContactsLivenessData);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(ContactsLivenessDataUpdatedEvent);
+    OnWalletEvent(ContactsLivenessDataUpdatedEvent, pTariContactsLivenessData);
 }
 
 void transactionValidationCompleteCallback(uint64_t requestId, uint64_t status) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, requestId);
-    jbyteArray statusBytes = getBytesFromUnsignedLongLong(jniEnv, status);
-    jniEnv->CallVoidMethod(callbackHandler, transactionValidationCompleteCallbackMethodId, requestIdBytes, statusBytes);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(TxValidationCompleteEvent);
+    OnWalletEvent(TxValidationCompleteEvent, nullptr, requestId, status);
 }
 
 void connectivityStatusCallback(uint64_t status) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, status);
-    jniEnv->CallVoidMethod(callbackHandler, connectivityStatusCallbackId, requestIdBytes);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(ConnectivityStatusEvent);
+    OnWalletEvent(ConnectivityStatusEvent, nullptr, status);
 }
 
 void walletScannedHeightCallback(uint64_t height) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, height);
-    jniEnv->CallVoidMethod(callbackHandler, walletScannedHeightCallbackMethodId, bytes);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(WalletScannedHeightEvent);
+    OnWalletEvent(WalletScannedHeightEvent, nullptr, height);
 }
 
 void balanceUpdatedCallback(TariBalance *pBalance) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    auto jpBalance = reinterpret_cast<jlong>(pBalance);
-    jniEnv->CallVoidMethod(callbackHandler, balanceUpdatedCallbackMethodId, jpBalance);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(BalanceUpdatedEvent);
+    // read before the event is queued, its receiver destroys the balance
+    UpdateCachedBalance(pBalance);
+    InvalidateFeeEstimates();
+    OnWalletEvent(BalanceUpdatedEvent, pBalance);
 }
 
 void storeAndForwardMessagesReceivedCallback() {
@@ -272,38 +476,17 @@ void storeAndForwardMessagesReceivedCallback() {
 }
 
 void baseNodeStatusCallback(TariBaseNodeState *pBaseNodeState) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    auto jpBaseNodeState = reinterpret_cast<jlong>(pBaseNodeState);
-    jniEnv->CallVoidMethod(callbackHandler, baseNodeStatusCallbackMethodId, jpBaseNodeState);
-    g_vm->DetachCurrentThread();
+    CallbackTimer timer(BaseNodeStatusEvent);
+    OnWalletEvent(BaseNodeStatusEvent, pBaseNodeState);
 }
 
 void recoveringProcessCompleteCallback(uint8_t first, uint64_t second, uint64_t third) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
-        return;
-    }
-    jbyteArray bytes2 = getBytesFromUnsignedLongLong(jniEnv, second);
-    jbyteArray bytes3 = getBytesFromUnsignedLongLong(jniEnv, third);
-    jniEnv->CallVoidMethod(callbackHandler, recoveringProcessCompleteCallbackMethodId, static_cast<jint>(first), bytes2, bytes3);
-    g_vm->DetachCurrentThread();
-}
-
-jmethodID getMethodId(JNIEnv *jniEnv, jobject jThis, jstring methodName, jstring methodSignature) {
-    jclass jClass = jniEnv->GetObjectClass(jThis);
-    const char *method = jniEnv->GetStringUTFChars(methodName, JNI_FALSE);
-    const char *signature = jniEnv->GetStringUTFChars(methodSignature, JNI_FALSE);
-    jmethodID methodId = jniEnv->GetMethodID(jClass, method, signature);
-    jniEnv->ReleaseStringUTFChars(methodSignature, signature);
-    jniEnv->ReleaseStringUTFChars(methodName, method);
-    return methodId;
+    CallbackTimer timer(WalletRecoveryEvent);
+    OnWalletEvent(WalletRecoveryEvent, nullptr, second, third, first);
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniCreate(
         JNIEnv *jEnv,
         jobject jThis,
@@ -317,158 +500,37 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniCreate(
         jobject jSeed_words,
         jstring jDnsPeer,
         jboolean isDnsSecureOn,
-        jstring txReceivedCallbackMethodName,
-        jstring txReceivedCallbackMethodSignature,
-        jstring callback_received_tx_reply,
-        jstring callback_received_tx_reply_sig,
-        jstring callback_received_finalized_tx,
-        jstring callback_received_finalized_tx_sig,
-        jstring callback_tx_broadcast,
-        jstring callback_tx_broadcast_sig,
-        jstring callback_tx_mined,
-        jstring callback_tx_mined_sig,
-        jstring callback_tx_mined_unconfirmed,
-        jstring callback_tx_mined_unconfirmed_sig,
-        jstring callback_tx_faux_confirmed,
-        jstring callback_tx_faux_confirmed_sig,
-        jstring callback_tx_faux_unconfirmed,
-        jstring callback_tx_faux_unconfirmed_sig,
-        jstring callback_direct_send_result,
-        jstring callback_direct_send_result_sig,
-        jstring callback_tx_cancellation,
-        jstring callback_tx_cancellation_sig,
-        jstring callback_txo_validation_complete,
-        jstring callback_txo_validation_complete_sig,
-        jstring callback_contacts_liveness_data_updated,
-        jstring callback_contacts_liveness_data_updated_sig,
-        jstring callback_balance_updated,
-        jstring callback_balance_updated_sig,
-        jstring callback_transaction_validation_complete,
-        jstring callback_transaction_validation_complete_sig,
-        jstring callback_connectivity_status,
-        jstring callback_connectivity_status_sig,
-        jstring callback_wallet_scanned_height,
-        jstring callback_wallet_scanned_height_sig,
-        jstring callback_base_node_status,
-        jstring callback_base_node_status_sig,
+        jboolean u64AsByteArrays,
+        jint eventQueueCapacity,
+        jint eventQueueOverflowPolicy,
+        jint eventCoalescingWindowMillis,
         jobject error) {
 
     int errorCode = 0;
+    u64CallbackArgsAsByteArrays = u64AsByteArrays == JNI_TRUE;
+    callbackStatsStartNanos = MonotonicNanos();
     if (callbackHandler == nullptr) {
         callbackHandler = jEnv->NewGlobalRef(jThis);
     }
-    jclass jClass = jEnv->GetObjectClass(jThis);
-    if (jClass == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txReceivedCallbackMethodId = getMethodId(jEnv, jThis, txReceivedCallbackMethodName, txReceivedCallbackMethodSignature);
-    if (txReceivedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txReplyReceivedCallbackMethodId = getMethodId(jEnv, jThis, callback_received_tx_reply, callback_received_tx_reply_sig);
-    if (txReplyReceivedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txFinalizedCallbackMethodId = getMethodId(jEnv, jThis, callback_received_finalized_tx, callback_received_finalized_tx_sig);
-    if (txFinalizedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txBroadcastCallbackMethodId = getMethodId(jEnv, jThis, callback_tx_broadcast, callback_tx_broadcast_sig);
-    if (txBroadcastCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txMinedCallbackMethodId = getMethodId(jEnv, jThis, callback_tx_mined, callback_tx_mined_sig);
-    if (txMinedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txMinedUnconfirmedCallbackMethodId = getMethodId(jEnv, jThis, callback_tx_mined_unconfirmed, callback_tx_mined_unconfirmed_sig);
-    if (txMinedUnconfirmedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txFauxConfirmedCallbackMethodId = getMethodId(jEnv, jThis, callback_tx_faux_confirmed, callback_tx_faux_confirmed_sig);
-    if (txFauxConfirmedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txFauxUnconfirmedCallbackMethodId = getMethodId(jEnv, jThis, callback_tx_faux_unconfirmed, callback_tx_faux_unconfirmed_sig);
-    if (txFauxUnconfirmedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    directSendResultCallbackMethodId = getMethodId(jEnv, jThis, callback_direct_send_result, callback_direct_send_result_sig);
-    if (directSendResultCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txCancellationCallbackMethodId = getMethodId(jEnv, jThis, callback_tx_cancellation, callback_tx_cancellation_sig);
-    if (txCancellationCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    connectivityStatusCallbackId = getMethodId(jEnv, jThis, callback_connectivity_status, callback_connectivity_status_sig);
-    if (connectivityStatusCallbackId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    txoValidationCompleteCallbackMethodId = getMethodId(jEnv, jThis, callback_txo_validation_complete, callback_txo_validation_complete_sig);
-    if (txoValidationCompleteCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    transactionValidationCompleteCallbackMethodId = getMethodId(jEnv, jThis, callback_transaction_validation_complete,
-                                                                callback_transaction_validation_complete_sig);
-    if (transactionValidationCompleteCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    contactsLivenessDataUpdatedCallbackMethodId = getMethodId(jEnv, jThis, callback_contacts_liveness_data_updated,
-                                                              callback_contacts_liveness_data_updated_sig);
-    if (contactsLivenessDataUpdatedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
+    if (eventQueueCapacity > 0) {
+        // callbacks made while the dispatcher could not start are delivered directly
+        StartWalletEventDispatcher(g_vm, callbackHandler, eventQueueCapacity, eventQueueOverflowPolicy, eventCoalescingWindowMillis);
     }
-
-    balanceUpdatedCallbackMethodId = getMethodId(jEnv, jThis, callback_balance_updated, callback_balance_updated_sig);
-    if (balanceUpdatedCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    walletScannedHeightCallbackMethodId = getMethodId(jEnv, jThis, callback_wallet_scanned_height, callback_wallet_scanned_height_sig);
-    if (walletScannedHeightCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
-    baseNodeStatusCallbackMethodId = getMethodId(jEnv, jThis, callback_base_node_status, callback_base_node_status_sig);
-    if (baseNodeStatusCallbackMethodId == nullptr) {
-        SetNullPointerField(jEnv, jThis);
-    }
-
     auto pWalletConfig = GetPointerField<TariCommsConfig *>(jEnv, jpWalletConfig);
 
-    const char *pLogPath = jEnv->GetStringUTFChars(jLogPath, JNI_FALSE);
-    if (strlen(pLogPath) == 0) {
+    JavaStringUtf8 logPath(jEnv, jLogPath);
+    const char *pLogPath = logPath.c_str();
+    if (pLogPath != nullptr && strlen(pLogPath) == 0) {
         pLogPath = nullptr;
     }
 
-    const char *pPassphrase = nullptr;
-    if (jPassphrase != nullptr) {
-        pPassphrase = jEnv->GetStringUTFChars(jPassphrase, JNI_FALSE);
-    }
-
-    const char *pNetwork = nullptr;
-    if (jNetwork != nullptr) {
-        pNetwork = jEnv->GetStringUTFChars(jNetwork, JNI_FALSE);
-    }
-
-    const char *pDnsPeer = nullptr;
-    if (jDnsPeer != nullptr) {
-        pDnsPeer = jEnv->GetStringUTFChars(jDnsPeer, JNI_FALSE);
+    JavaStringUtf8 passphrase(jEnv, jPassphrase);
+    JavaStringUtf8 network(jEnv, jNetwork);
+    JavaStringUtf8 dnsPeer(jEnv, jDnsPeer);
+    if (!CheckJavaString(logPath, &errorCode) || !CheckJavaString(passphrase, &errorCode) || !CheckJavaString(network, &errorCode) ||
+        !CheckJavaString(dnsPeer, &errorCode)) {
+        setErrorCode(jEnv, error, errorCode);
+        return;
     }
 
     bool jRecoveryInProgress = false;
@@ -485,10 +547,10 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniCreate(
             logVerbosity,
             static_cast<unsigned int>(maxNumberOfRollingLogFiles),
             static_cast<unsigned int>(rollingLogFileMaxSizeBytes),
-            pPassphrase,
+            passphrase.c_str(),
             pSeedWords,
-            pNetwork,
-            pDnsPeer,
+            network.c_str(),
+            dnsPeer.c_str(),
             isDnsSecureOn,
             txReceivedCallback,
             txReplyReceivedCallback,
@@ -511,13 +573,12 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniCreate(
             pRecovery,
             &errorCode);
 
-    setErrorCode(jEnv, error, errorCode);
-    jEnv->ReleaseStringUTFChars(jLogPath, pLogPath);
     SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pWallet));
+    setErrorCode(jEnv, error, errorCode);
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetBalance(
         JNIEnv *jEnv,
         jobject jThis,
@@ -528,8 +589,39 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetBalance(
     });
 }
 
+/**
+ * Returns {available, pending incoming, pending outgoing, time locked} from the balance cache, see
+ * GetCachedBalance.
+ */
+extern "C"
+jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCachedBalance(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlongArray>(jEnv, error, [&](int *errorPointer) -> jlongArray {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        unsigned long long values[CachedBalanceValueCount];
+        if (!GetCachedBalance(pWallet, values, errorPointer)) {
+            return nullptr;
+        }
+        jlong longs[CachedBalanceValueCount];
+        for (int i = 0; i < CachedBalanceValueCount; i++) {
+            longs[i] = static_cast<jlong>(values[i]);
+        }
+        jlongArray result = jEnv->NewLongArray(CachedBalanceValueCount);
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        jEnv->SetLongArrayRegion(result, 0, CachedBalanceValueCount, longs);
+        return result;
+    });
+}
+
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetUtxos(
         JNIEnv *jEnv,
         jobject jThis,
@@ -547,7 +639,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetUtxos(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetAllUtxos(
         JNIEnv *jEnv,
         jobject jThis,
@@ -559,21 +651,23 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetAllUtxos(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniLogMessage(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jMessage,
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
-        const char *pMessage = jEnv->GetStringUTFChars(jMessage, JNI_FALSE);
-        log_debug_message(pMessage, errorPointer);
-        jEnv->ReleaseStringUTFChars(jMessage, pMessage);
+        JavaStringUtf8 message(jEnv, jMessage);
+        if (!CheckJavaString(message, errorPointer)) {
+            return;
+        }
+        log_debug_message(message.c_str(), errorPointer);
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetWalletAddress(
         JNIEnv *jEnv,
         jobject jThis,
@@ -585,7 +679,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetWalletAddress(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetContacts(
         JNIEnv *jEnv,
         jobject jThis,
@@ -597,7 +691,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetContacts(
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniAddUpdateContact(
         JNIEnv *jEnv,
         jobject jThis,
@@ -606,12 +700,16 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniAddUpdateContact(
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         auto pContact = GetPointerField<TariContact *>(jEnv, jpContact);
-        return static_cast<jboolean>(wallet_upsert_contact(pWallet, pContact, errorPointer) != 0);
+        bool upserted = wallet_upsert_contact(pWallet, pContact, errorPointer);
+        if (upserted && *errorPointer == 0) {
+            IndexUpsertedContact(pContact);
+        }
+        return static_cast<jboolean>(upserted);
     });
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniRemoveContact(
         JNIEnv *jEnv,
         jobject jThis,
@@ -620,12 +718,98 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniRemoveContact(
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         auto pContact = GetPointerField<TariContact *>(jEnv, jpContact);
-        return static_cast<jboolean>(wallet_remove_contact(pWallet, pContact, errorPointer) != 0);
+        bool removed = wallet_remove_contact(pWallet, pContact, errorPointer);
+        if (removed && *errorPointer == 0) {
+            IndexRemovedContact(pContact);
+        }
+        return static_cast<jboolean>(removed);
+    });
+}
+
+// address bytes of a base58 address, the key of the contact index
+static bool GetBase58AddressBytes(JNIEnv *jEnv, jstring jBase58, std::string *pBytes, int *errorPointer) {
+    JavaStringUtf8 base58(jEnv, jBase58);
+    if (!CheckJavaString(base58, errorPointer)) {
+        return false;
+    }
+    TariWalletAddress *pAddress = tari_address_from_base58(base58.c_str(), errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    bool read = GetAddressBytes(pAddress, pBytes, errorPointer);
+    tari_address_destroy(pAddress);
+    return read;
+}
+
+extern "C"
+jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniFindContact(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jBase58,
+        jobject jEntry,
+        jobject error) {
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) -> jboolean {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        std::string addressBytes;
+        ContactIndexEntry entry;
+        if (!GetBase58AddressBytes(jEnv, jBase58, &addressBytes, errorPointer)
+            || !FindIndexedContact(pWallet, addressBytes, &entry, errorPointer)) {
+            return JNI_FALSE;
+        }
+        const JniIds &ids = GetJniIds();
+        jstring alias = NewJavaString(jEnv, entry.alias);
+        jstring emojiId = NewJavaString(jEnv, entry.emojiId);
+        jEnv->SetObjectField(jEntry, ids.ffiContactIndexEntryAliasField, alias);
+        jEnv->SetBooleanField(jEntry, ids.ffiContactIndexEntryIsFavoriteField, entry.favourite ? JNI_TRUE : JNI_FALSE);
+        jEnv->SetObjectField(jEntry, ids.ffiContactIndexEntryEmojiIdField, emojiId);
+        jEnv->DeleteLocalRef(alias);
+        jEnv->DeleteLocalRef(emojiId);
+        return JNI_TRUE;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniRemoveContactByAddress(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jBase58,
+        jobject error) {
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) -> jboolean {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        JavaStringUtf8 base58(jEnv, jBase58);
+        if (!CheckJavaString(base58, errorPointer)) {
+            return JNI_FALSE;
+        }
+        TariWalletAddress *pAddress = tari_address_from_base58(base58.c_str(), errorPointer);
+        if (*errorPointer != 0) {
+            return JNI_FALSE;
+        }
+        std::string addressBytes;
+        ContactIndexEntry entry;
+        if (!GetAddressBytes(pAddress, &addressBytes, errorPointer)
+            || !FindIndexedContact(pWallet, addressBytes, &entry, errorPointer)) {
+            tari_address_destroy(pAddress);
+            return JNI_FALSE;
+        }
+        // the library removes by address, rebuild the contact from what the index holds
+        TariContact *pContact = contact_create(entry.alias.c_str(), pAddress, entry.favourite, errorPointer);
+        tari_address_destroy(pAddress);
+        if (*errorPointer != 0) {
+            return JNI_FALSE;
+        }
+        bool removed = wallet_remove_contact(pWallet, pContact, errorPointer);
+        contact_destroy(pContact);
+        if (removed && *errorPointer == 0) {
+            RemoveIndexedContact(addressBytes);
+        }
+        return static_cast<jboolean>(removed);
+    });
+}
+
+extern "C"
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCompletedTxs(
         JNIEnv *jEnv,
         jobject jThis,
@@ -637,7 +821,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCompletedTxs(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCancelledTxs(
         JNIEnv *jEnv,
         jobject jThis,
@@ -649,280 +833,723 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCancelledTxs(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCompletedTxById(
         JNIEnv *jEnv,
         jobject jThis,
-        jstring jTxId,
+        jstring jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        JavaStringUtf8 txIdString(jEnv, jTxId);
+        if (!CheckJavaString(txIdString, errorPointer)) {
+            return 0;
+        }
+        char *pEnd;
+        unsigned long long id = strtoull(txIdString.c_str(), &pEnd, 10);
+        auto result = reinterpret_cast<jlong>(wallet_get_completed_transaction_by_id(pWallet, id, errorPointer));
+        return result;
+    });
+}
+
+// tx ids use the whole u64 range, so the jlong is reinterpreted rather than range checked
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCompletedTxByIdU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return reinterpret_cast<jlong>(wallet_get_completed_transaction_by_id(pWallet, static_cast<unsigned long long>(jTxId), errorPointer));
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCancelledTxById(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        JavaStringUtf8 txIdString(jEnv, jTxId);
+        if (!CheckJavaString(txIdString, errorPointer)) {
+            return 0;
+        }
+        char *pEnd;
+        unsigned long long id = strtoull(txIdString.c_str(), &pEnd, 10);
+        auto result = reinterpret_cast<jlong>(wallet_get_cancelled_transaction_by_id(pWallet, id, errorPointer));
+        return result;
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCancelledTxByIdU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return reinterpret_cast<jlong>(wallet_get_cancelled_transaction_by_id(pWallet, static_cast<unsigned long long>(jTxId), errorPointer));
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingOutboundTxs(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithErrorAndCast<TariPendingOutboundTransactions *>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return wallet_get_pending_outbound_transactions(pWallet, errorPointer);
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingOutboundTxById(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        JavaStringUtf8 txIdString(jEnv, jTxId);
+        if (!CheckJavaString(txIdString, errorPointer)) {
+            return 0;
+        }
+        char *pEnd;
+        unsigned long long id = strtoull(txIdString.c_str(), &pEnd, 10);
+        auto result = reinterpret_cast<jlong>(   wallet_get_pending_outbound_transaction_by_id(pWallet, id, errorPointer));
+        return result;
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingOutboundTxByIdU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return reinterpret_cast<jlong>(wallet_get_pending_outbound_transaction_by_id(pWallet, static_cast<unsigned long long>(jTxId), errorPointer));
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingInboundTxs(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithErrorAndCast<TariPendingInboundTransactions *>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return wallet_get_pending_inbound_transactions(pWallet, errorPointer);
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingInboundTxById(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        JavaStringUtf8 txIdString(jEnv, jTxId);
+        if (!CheckJavaString(txIdString, errorPointer)) {
+            return 0;
+        }
+        char *pEnd;
+        unsigned long long id = strtoull(txIdString.c_str(), &pEnd, 10);
+        auto result = reinterpret_cast<jlong>(wallet_get_pending_inbound_transaction_by_id(pWallet, id, errorPointer));
+        return result;
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingInboundTxByIdU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return reinterpret_cast<jlong>(wallet_get_pending_inbound_transaction_by_id(pWallet, static_cast<unsigned long long>(jTxId), errorPointer));
+    });
+}
+
+extern "C"
+jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniCancelPendingTx(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jTxId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        JavaStringUtf8 txIdString(jEnv, jTxId);
+        if (!CheckJavaString(txIdString, errorPointer)) {
+            return 0;
+        }
+        char *pEnd;
+        unsigned long long id = strtoull(txIdString.c_str(), &pEnd, 10);
+        auto result = static_cast<jboolean>(wallet_cancel_pending_transaction(pWallet, id, errorPointer));
+        return result;
+    });
+}
+
+extern "C"
+jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniCancelPendingTxU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jTxId,
+        jobject error) {
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return static_cast<jboolean>(wallet_cancel_pending_transaction(pWallet, static_cast<unsigned long long>(jTxId), errorPointer));
+    });
+}
+
+extern "C"
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniDestroy(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+    CloseKeyValueCache(pWallet);
+    wallet_destroy(pWallet);
+    ClearContactIndex();
+    ClearCachedBalance();
+    ClearTxJournal();
+    ClearTxIndex();
+    InvalidateFeeEstimates();
+    // no callback can come in anymore, deliver what is still queued before dropping the handler
+    StopWalletEventDispatcher();
+    jEnv->DeleteGlobalRef(callbackHandler);
+    callbackHandler = nullptr;
+    SetNullPointerField(jEnv, jThis);
+}
+
+/**
+ * Returns {kind, status, outbound, amount, fee, timestamp, confirmations} of a tx from the tx index,
+ * or null if there is no such tx.
+ */
+extern "C"
+jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetIndexedTx(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jTxId,
+        jobject error) {
+    return ExecuteWithError<jlongArray>(jEnv, error, [&](int *errorPointer) -> jlongArray {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        TxIndexRecord record;
+        if (!FindIndexedTx(pWallet, static_cast<uint64_t>(jTxId), &record, errorPointer)) {
+            return nullptr;
+        }
+        jlong values[] = {
+                record.kind,
+                record.status,
+                record.outbound ? 1 : 0,
+                static_cast<jlong>(record.amount),
+                static_cast<jlong>(record.fee),
+                static_cast<jlong>(record.timestamp),
+                static_cast<jlong>(record.confirmations)
+        };
+        jlongArray result = jEnv->NewLongArray(NELEM(values));
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        jEnv->SetLongArrayRegion(result, 0, NELEM(values), values);
+        return result;
+    });
+}
+
+/**
+ * Compares the tx index with the database, see CheckTxIndex.
+ */
+extern "C"
+jint JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniCheckTxIndex(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return static_cast<jint>(CheckTxIndex(pWallet, errorPointer));
+    });
+}
+
+/**
+ * Returns the tx state transitions journaled after version, see PackTxChangesSince for the layout.
+ */
+extern "C"
+jobject JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetChangesSince(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jVersion,
+        jobject error) {
+    return ExecuteWithError<jobject>(jEnv, error, [&](int *errorPointer) -> jobject {
+        if (!CheckUnsignedArgument(jVersion, errorPointer)) {
+            return nullptr;
+        }
+        std::vector<unsigned char> packed = PackTxChangesSince(static_cast<uint64_t>(jVersion));
+        jobject buffer = NewDirectByteBufferCopy(jEnv, packed.data(), packed.size());
+        if (buffer == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+        }
+        return buffer;
+    });
+}
+
+/**
+ * Returns {nanos since jniCreate, callbacks, thread attaches, thread detaches}. Before callback
+ * threads stayed attached every callback did its own attach, so callbacks doubles as the former
+ * attach count.
+ */
+extern "C"
+jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCallbackThreadStats(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    jlong stats[] = {
+            MonotonicNanos() - callbackStatsStartNanos.load(),
+            callbackCount.load(),
+            callbackThreadAttachCount.load(),
+            callbackThreadDetachCount.load()
+    };
+    jlongArray result = jEnv->NewLongArray(NELEM(stats));
+    if (result != nullptr) {
+        jEnv->SetLongArrayRegion(result, 0, NELEM(stats), stats);
+    }
+    return result;
+}
+
+/**
+ * Returns the event queue counters, see GetWalletEventQueueStats for their order.
+ */
+extern "C"
+jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetEventQueueStats(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    jlong stats[WalletEventQueueStatsCount];
+    GetWalletEventQueueStats(stats);
+    jlongArray result = jEnv->NewLongArray(WalletEventQueueStatsCount);
+    if (result != nullptr) {
+        jEnv->SetLongArrayRegion(result, 0, WalletEventQueueStatsCount, stats);
+    }
+    return result;
+}
+
+/**
+ * Returns the callback latency histograms packed as described at PackCallbackStats.
+ */
+extern "C"
+jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCallbackStats(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    std::vector<jlong> stats = PackCallbackStats();
+    auto size = static_cast<jsize>(stats.size());
+    jlongArray result = jEnv->NewLongArray(size);
+    if (result != nullptr) {
+        jEnv->SetLongArrayRegion(result, 0, size, stats.data());
+    }
+    return result;
+}
+
+/**
+ * Returns {size, hits, misses, invalidations} of the fee estimate memo.
+ */
+extern "C"
+jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetFeeEstimateCacheStats(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    jlong stats[FeeEstimateCacheStatsCount];
+    GetFeeEstimateCacheStats(stats);
+    jlongArray result = jEnv->NewLongArray(FeeEstimateCacheStatsCount);
+    if (result != nullptr) {
+        jEnv->SetLongArrayRegion(result, 0, FeeEstimateCacheStatsCount, stats);
+    }
+    return result;
+}
+
+extern "C"
+jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniEstimateTxFee(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jAmount,
+        jstring jGramFee,
+        jstring jKernelCount,
+        jstring jOutputCount,
+        jobject error) {
+    return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        JavaStringUtf8 amountString(jEnv, jAmount);
+        JavaStringUtf8 gramFeeString(jEnv, jGramFee);
+        JavaStringUtf8 kernelsString(jEnv, jKernelCount);
+        JavaStringUtf8 outputsString(jEnv, jOutputCount);
+        if (!CheckJavaString(amountString, errorPointer) || !CheckJavaString(gramFeeString, errorPointer) ||
+            !CheckJavaString(kernelsString, errorPointer) || !CheckJavaString(outputsString, errorPointer)) {
+            return static_cast<jbyteArray>(nullptr);
+        }
+        char *pAmountEnd;
+        char *pGramFeeEnd;
+        char *pKernelsEnd;
+        char *pOutputsEnd;
+
+        unsigned long long amount = strtoull(amountString.c_str(), &pAmountEnd, 10);
+        unsigned long long gramFee = strtoull(gramFeeString.c_str(), &pGramFeeEnd, 10);
+        unsigned long long kernels = strtoull(kernelsString.c_str(), &pKernelsEnd, 10);
+        unsigned long long outputs = strtoull(outputsString.c_str(), &pOutputsEnd, 10);
+
+        jbyteArray result = getBytesFromUnsignedLongLong(
+                jEnv, EstimateTxFee(pWallet, amount, gramFee, kernels, outputs, errorPointer));
+        return result;
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniEstimateTxFeeU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong amount,
+        jlong gramFee,
+        jlong kernelCount,
+        jlong outputCount,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        if (!CheckUnsignedArgument(amount, errorPointer) || !CheckUnsignedArgument(gramFee, errorPointer) ||
+            !CheckUnsignedArgument(kernelCount, errorPointer) || !CheckUnsignedArgument(outputCount, errorPointer)) {
+            return 0;
+        }
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(EstimateTxFee(pWallet, amount, gramFee, kernelCount, outputCount, errorPointer));
+    });
+}
+
+// the caller destroys the vector with destroy_tari_vector
+static TariVector *CommitmentsToTariVector(JNIEnv *jEnv, jobjectArray jCommitments, int *errorPointer) {
+    int size = jEnv->GetArrayLength(jCommitments);
+    auto *pTariVector = create_tari_vector(Text);
+    for (int i = 0; i < size && *errorPointer == 0; ++i) {
+        auto commitmentItem = (jstring) jEnv->GetObjectArrayElement(jCommitments, i);
+        JavaStringUtf8 commitmentRef(jEnv, commitmentItem);
+        if (CheckJavaString(commitmentRef, errorPointer)) {
+            tari_vector_push_string(pTariVector, commitmentRef.c_str(), errorPointer);
+        }
+        // one local ref and one UTF copy per element, release them before the next one
+        jEnv->DeleteLocalRef(commitmentItem);
+    }
+    return pTariVector;
+}
+
+const size_t PackedCommitmentSize = 32;
+
+/**
+ * Builds the commitments vector from 32 byte binary commitments laid out back to back, with no
+ * local reference or string per commitment. The caller destroys the vector with destroy_tari_vector.
+ */
+static TariVector *PackedCommitmentsToTariVector(JNIEnv *jEnv, jbyteArray jCommitments, int *errorPointer) {
+    jsize size = jEnv->GetArrayLength(jCommitments);
+    if (size % PackedCommitmentSize != 0) {
+        *errorPointer = InvalidArgumentErrorCode;
+        return nullptr;
+    }
+    std::vector<unsigned char> commitments(static_cast<size_t>(size));
+    jEnv->GetByteArrayRegion(jCommitments, 0, size, reinterpret_cast<jbyte *>(commitments.data()));
+    auto *pTariVector = create_tari_vector(Text);
+    char hex[2 * PackedCommitmentSize + 1];
+    for (size_t offset = 0; offset < commitments.size() && *errorPointer == 0; offset += PackedCommitmentSize) {
+        BytesToHex(commitments.data() + offset, PackedCommitmentSize, hex);
+        tari_vector_push_string(pTariVector, hex, errorPointer);
+    }
+    return pTariVector;
+}
+
+// parses a decimal u64 passed as a string by the byte array ABI, 0 if it can't be read
+static unsigned long long StringToUnsignedLongLong(JNIEnv *jEnv, jstring jValue, int *errorPointer) {
+    JavaStringUtf8 valueString(jEnv, jValue);
+    if (!CheckJavaString(valueString, errorPointer)) {
+        return 0;
+    }
+    char *pEnd;
+    unsigned long long value = strtoull(valueString.c_str(), &pEnd, 10);
+    return value;
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniJoinUtxos(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jCommitments,
+        jstring jFeePerGram,
         jobject error) {
-    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
-        char *pEnd;
-        unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = reinterpret_cast<jlong>(wallet_get_completed_transaction_by_id(pWallet, id, errorPointer));
-        jEnv->ReleaseStringUTFChars(jTxId, nativeString);
+        auto *pTariVector = CommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        unsigned long long feePerGram = StringToUnsignedLongLong(jEnv, jFeePerGram, errorPointer);
+        jlong result = *errorPointer == 0 ? wallet_coin_join(pWallet, pTariVector, feePerGram, errorPointer) : 0;
+        destroy_tari_vector(pTariVector);
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCancelledTxById(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniJoinUtxosU64(
         JNIEnv *jEnv,
         jobject jThis,
-        jstring jTxId,
+        jobjectArray jCommitments,
+        jlong feePerGram,
         jobject error) {
-    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        if (!CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return 0;
+        }
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
-        char *pEnd;
-        unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = reinterpret_cast<jlong>(wallet_get_cancelled_transaction_by_id(pWallet, id, errorPointer));
-        jEnv->ReleaseStringUTFChars(jTxId, nativeString);
+        auto *pTariVector = CommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        jlong result = *errorPointer == 0 ? wallet_coin_join(pWallet, pTariVector, feePerGram, errorPointer) : 0;
+        destroy_tari_vector(pTariVector);
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingOutboundTxs(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniJoinPackedUtxos(
         JNIEnv *jEnv,
         jobject jThis,
+        jbyteArray jCommitments,
+        jlong feePerGram,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPendingOutboundTransactions *>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        if (!CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return 0;
+        }
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        return wallet_get_pending_outbound_transactions(pWallet, errorPointer);
+        auto *pTariVector = PackedCommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        jlong result = *errorPointer == 0 ? wallet_coin_join(pWallet, pTariVector, feePerGram, errorPointer) : 0;
+        destroy_tari_vector(pTariVector);
+        return result;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingOutboundTxById(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSplitUtxos(
         JNIEnv *jEnv,
         jobject jThis,
-        jstring jTxId,
+        jobjectArray jCommitments,
+        jstring jSplitCount,
+        jstring jFeePerGram,
         jobject error) {
-    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
-        char *pEnd;
-        unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = reinterpret_cast<jlong>(   wallet_get_pending_outbound_transaction_by_id(pWallet, id, errorPointer));
-        jEnv->ReleaseStringUTFChars(jTxId, nativeString);
+        auto *pTariVector = CommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        auto splitCount = static_cast<uintptr_t>(StringToUnsignedLongLong(jEnv, jSplitCount, errorPointer));
+        unsigned long long feePerGram = StringToUnsignedLongLong(jEnv, jFeePerGram, errorPointer);
+        jlong result = *errorPointer == 0 ? wallet_coin_split(pWallet, pTariVector, splitCount, feePerGram, errorPointer) : 0;
+        destroy_tari_vector(pTariVector);
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingInboundTxs(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSplitUtxosU64(
         JNIEnv *jEnv,
         jobject jThis,
+        jobjectArray jCommitments,
+        jlong splitCount,
+        jlong feePerGram,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPendingInboundTransactions *>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        if (!CheckUnsignedArgument(splitCount, errorPointer, UINTPTR_MAX) || !CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return 0;
+        }
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        return wallet_get_pending_inbound_transactions(pWallet, errorPointer);
+        auto *pTariVector = CommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        jlong result = *errorPointer == 0
+                ? wallet_coin_split(pWallet, pTariVector, static_cast<uintptr_t>(splitCount), feePerGram, errorPointer)
+                : 0;
+        destroy_tari_vector(pTariVector);
+        return result;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingInboundTxById(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSplitPackedUtxos(
         JNIEnv *jEnv,
         jobject jThis,
-        jstring jTxId,
+        jbyteArray jCommitments,
+        jlong splitCount,
+        jlong feePerGram,
         jobject error) {
-    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        if (!CheckUnsignedArgument(splitCount, errorPointer, UINTPTR_MAX) || !CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return 0;
+        }
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
-        char *pEnd;
-        unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = reinterpret_cast<jlong>(wallet_get_pending_inbound_transaction_by_id(pWallet, id, errorPointer));
-        jEnv->ReleaseStringUTFChars(jTxId, nativeString);
+        auto *pTariVector = PackedCommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        jlong result = *errorPointer == 0
+                ? wallet_coin_split(pWallet, pTariVector, static_cast<uintptr_t>(splitCount), feePerGram, errorPointer)
+                : 0;
+        destroy_tari_vector(pTariVector);
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniCancelPendingTx(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewJoinUtxos(
         JNIEnv *jEnv,
         jobject jThis,
-        jstring jTxId,
+        jobjectArray jCommitments,
+        jstring jFeePerGram,
         jobject error) {
-    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) -> TariCoinPreview * {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
-        char *pEnd;
-        unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = static_cast<jboolean>(wallet_cancel_pending_transaction(pWallet, id, errorPointer));
-        jEnv->ReleaseStringUTFChars(jTxId, nativeString);
-        return result;
+        auto *pTariVector = CommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        unsigned long long feePerGram = StringToUnsignedLongLong(jEnv, jFeePerGram, errorPointer);
+        TariCoinPreview *pPreview = *errorPointer == 0 ? wallet_preview_coin_join(pWallet, pTariVector, feePerGram, errorPointer) : nullptr;
+        destroy_tari_vector(pTariVector);
+        return pPreview;
     });
 }
 
 extern "C"
-JNIEXPORT void JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniDestroy(
-        JNIEnv *jEnv,
-        jobject jThis) {
-    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-    jEnv->DeleteGlobalRef(callbackHandler);
-    callbackHandler = nullptr;
-    wallet_destroy(pWallet);
-    SetNullPointerField(jEnv, jThis);
-}
-
-extern "C"
-JNIEXPORT jbyteArray JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniEstimateTxFee(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewJoinUtxosU64(
         JNIEnv *jEnv,
         jobject jThis,
-        jstring jAmount,
-        jstring jGramFee,
-        jstring jKernelCount,
-        jstring jOutputCount,
+        jobjectArray jCommitments,
+        jlong feePerGram,
         jobject error) {
-    int errorCode = 0;
-    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-    const char *nativeAmount = jEnv->GetStringUTFChars(jAmount, JNI_FALSE);
-    const char *nativeGramFee = jEnv->GetStringUTFChars(jGramFee, JNI_FALSE);
-    const char *nativeKernels = jEnv->GetStringUTFChars(jKernelCount, JNI_FALSE);
-    const char *nativeOutputs = jEnv->GetStringUTFChars(jOutputCount, JNI_FALSE);
-    char *pAmountEnd;
-    char *pGramFeeEnd;
-    char *pKernelsEnd;
-    char *pOutputsEnd;
-
-    unsigned long long amount = strtoull(nativeAmount, &pAmountEnd, 10);
-    unsigned long long gramFee = strtoull(nativeGramFee, &pGramFeeEnd, 10);
-    unsigned long long kernels = strtoull(nativeKernels, &pKernelsEnd, 10);
-    unsigned long long outputs = strtoull(nativeOutputs, &pOutputsEnd, 10);
-
-    jbyteArray result = getBytesFromUnsignedLongLong(jEnv, wallet_get_fee_estimate(pWallet, amount, nullptr, gramFee, kernels, outputs, &errorCode));
-    setErrorCode(jEnv, error, errorCode);
-    jEnv->ReleaseStringUTFChars(jAmount, nativeAmount);
-    jEnv->ReleaseStringUTFChars(jGramFee, nativeGramFee);
-    jEnv->ReleaseStringUTFChars(jKernelCount, nativeKernels);
-    jEnv->ReleaseStringUTFChars(jOutputCount, nativeOutputs);
-    return result;
+    return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) -> TariCoinPreview * {
+        if (!CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return nullptr;
+        }
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        auto *pTariVector = CommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        TariCoinPreview *pPreview = *errorPointer == 0 ? wallet_preview_coin_join(pWallet, pTariVector, feePerGram, errorPointer) : nullptr;
+        destroy_tari_vector(pTariVector);
+        return pPreview;
+    });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniJoinUtxos(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewJoinPackedUtxos(
         JNIEnv *jEnv,
         jobject jThis,
-        jobjectArray jCommitments,
-        jstring jFeePerGram,
+        jbyteArray jCommitments,
+        jlong feePerGram,
         jobject error) {
-    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
-        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-
-        int size = jEnv->GetArrayLength(jCommitments);
-        auto *pTariVector = create_tari_vector(Text);
-        for (int i = 0; i < size; ++i) {
-            auto commitmentItem = (jstring) jEnv->GetObjectArrayElement(jCommitments, i);
-            const char *commitmentRef = jEnv->GetStringUTFChars(commitmentItem, JNI_FALSE);
-            tari_vector_push_string(pTariVector, commitmentRef, errorPointer);
+    return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) -> TariCoinPreview * {
+        if (!CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return nullptr;
         }
-
-        const char *nativeGramFee = jEnv->GetStringUTFChars(jFeePerGram, JNI_FALSE);
-        char *pGramFeeEnd;
-        unsigned long feePerGram = strtoull(nativeGramFee, &pGramFeeEnd, 10);
-        return wallet_coin_join(pWallet, pTariVector, feePerGram, errorPointer);
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        auto *pTariVector = PackedCommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        TariCoinPreview *pPreview = *errorPointer == 0 ? wallet_preview_coin_join(pWallet, pTariVector, feePerGram, errorPointer) : nullptr;
+        destroy_tari_vector(pTariVector);
+        return pPreview;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniSplitUtxos(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewSplitUtxos(
         JNIEnv *jEnv,
         jobject jThis,
         jobjectArray jCommitments,
         jstring jSplitCount,
         jstring jFeePerGram,
         jobject error) {
-    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) -> TariCoinPreview * {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-
-        int size = jEnv->GetArrayLength(jCommitments);
-        auto *pTariVector = create_tari_vector(Text);
-        for (int i = 0; i < size; ++i) {
-            auto commitmentItem = (jstring) jEnv->GetObjectArrayElement(jCommitments, i);
-            const char *commitmentRef = jEnv->GetStringUTFChars(commitmentItem, JNI_FALSE);
-            tari_vector_push_string(pTariVector, commitmentRef, errorPointer);
-        }
-
-        const char *nativeSplitCount = jEnv->GetStringUTFChars(jSplitCount, JNI_FALSE);
-        const char *nativeGramFee = jEnv->GetStringUTFChars(jFeePerGram, JNI_FALSE);
-        char *pSplitCount;
-        char *pGramFeeEnd;
-        unsigned int splitCount = strtoull(nativeSplitCount, &pSplitCount, 10);
-        unsigned long feePerGram = strtoull(nativeGramFee, &pGramFeeEnd, 10);
-        return wallet_coin_split(pWallet, pTariVector, splitCount, feePerGram, errorPointer);
+        auto *pTariVector = CommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        auto splitCount = static_cast<uintptr_t>(StringToUnsignedLongLong(jEnv, jSplitCount, errorPointer));
+        unsigned long long feePerGram = StringToUnsignedLongLong(jEnv, jFeePerGram, errorPointer);
+        TariCoinPreview *pPreview = *errorPointer == 0
+                ? wallet_preview_coin_split(pWallet, pTariVector, splitCount, feePerGram, errorPointer)
+                : nullptr;
+        destroy_tari_vector(pTariVector);
+        return pPreview;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewJoinUtxos(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewSplitUtxosU64(
         JNIEnv *jEnv,
         jobject jThis,
         jobjectArray jCommitments,
-        jstring jFeePerGram,
+        jlong splitCount,
+        jlong feePerGram,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) {
-        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-
-        int size = jEnv->GetArrayLength(jCommitments);
-        auto *pTariVector = create_tari_vector(Text);
-        for (int i = 0; i < size; ++i) {
-            auto commitmentItem = (jstring) jEnv->GetObjectArrayElement(jCommitments, i);
-            const char *commitmentRef = jEnv->GetStringUTFChars(commitmentItem, JNI_FALSE);
-            tari_vector_push_string(pTariVector, commitmentRef, errorPointer);
+    return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) -> TariCoinPreview * {
+        if (!CheckUnsignedArgument(splitCount, errorPointer, UINTPTR_MAX) || !CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return nullptr;
         }
-
-        const char *nativeGramFee = jEnv->GetStringUTFChars(jFeePerGram, JNI_FALSE);
-        char *pGramFeeEnd;
-        unsigned long feePerGram = strtoull(nativeGramFee, &pGramFeeEnd, 10);
-        return wallet_preview_coin_join(pWallet, pTariVector, feePerGram, errorPointer);
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        auto *pTariVector = CommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        TariCoinPreview *pPreview = *errorPointer == 0
+                ? wallet_preview_coin_split(pWallet, pTariVector, static_cast<uintptr_t>(splitCount), feePerGram, errorPointer)
+                : nullptr;
+        destroy_tari_vector(pTariVector);
+        return pPreview;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewSplitUtxos(
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewSplitPackedUtxos(
         JNIEnv *jEnv,
         jobject jThis,
-        jobjectArray jCommitments,
-        jstring jSplitCount,
-        jstring jFeePerGram,
+        jbyteArray jCommitments,
+        jlong splitCount,
+        jlong feePerGram,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) {
-        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-
-        int size = jEnv->GetArrayLength(jCommitments);
-        auto *pTariVector = create_tari_vector(Text);
-        for (int i = 0; i < size; ++i) {
-            auto commitmentItem = (jstring) jEnv->GetObjectArrayElement(jCommitments, i);
-            const char *commitmentRef = jEnv->GetStringUTFChars(commitmentItem, JNI_FALSE);
-            tari_vector_push_string(pTariVector, commitmentRef, errorPointer);
+    return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) -> TariCoinPreview * {
+        if (!CheckUnsignedArgument(splitCount, errorPointer, UINTPTR_MAX) || !CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return nullptr;
         }
-
-        const char *nativeSplitCount = jEnv->GetStringUTFChars(jSplitCount, JNI_FALSE);
-        const char *nativeGramFee = jEnv->GetStringUTFChars(jFeePerGram, JNI_FALSE);
-        char *pSplitCount;
-        char *pGramFeeEnd;
-        unsigned int splitCount = strtoull(nativeSplitCount, &pSplitCount, 10);
-        unsigned long feePerGram = strtoull(nativeGramFee, &pGramFeeEnd, 10);
-        return wallet_preview_coin_split(pWallet, pTariVector, splitCount, feePerGram, errorPointer);
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        auto *pTariVector = PackedCommitmentsToTariVector(jEnv, jCommitments, errorPointer);
+        TariCoinPreview *pPreview = *errorPointer == 0
+                ? wallet_preview_coin_split(pWallet, pTariVector, static_cast<uintptr_t>(splitCount), feePerGram, errorPointer)
+                : nullptr;
+        destroy_tari_vector(pTariVector);
+        return pPreview;
     });
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniAddBaseNodePeer(
         JNIEnv *jEnv,
         jobject jThis,
@@ -932,15 +1559,17 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniAddBaseNodePeer(
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         auto pPublicKey = GetPointerField<TariPublicKey *>(jEnv, jPublicKey);
-        char *pAddress = const_cast<char *>(jEnv->GetStringUTFChars(jAddress, JNI_FALSE));
-        auto result = static_cast<jboolean>(  wallet_set_base_node_peer(pWallet, pPublicKey, pAddress, errorPointer) != 0);
-        jEnv->ReleaseStringUTFChars(jAddress, pAddress);
+        JavaStringUtf8 address(jEnv, jAddress);
+        if (!CheckJavaString(address, errorPointer)) {
+            return static_cast<jboolean>(JNI_FALSE);
+        }
+        auto result = static_cast<jboolean>(  wallet_set_base_node_peer(pWallet, pPublicKey, const_cast<char *>(address.c_str()), errorPointer) != 0);
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniStartTxValidation(
         JNIEnv *jEnv,
         jobject jThis,
@@ -952,7 +1581,19 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniStartTxValidation(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniStartTxValidationU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(wallet_start_transaction_validation(pWallet, errorPointer));
+    });
+}
+
+extern "C"
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniRestartTxBroadcast(
         JNIEnv *jEnv,
         jobject jThis,
@@ -964,7 +1605,19 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniRestartTxBroadcast(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniRestartTxBroadcastU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(wallet_restart_transaction_broadcast(pWallet, errorPointer));
+    });
+}
+
+extern "C"
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniPowerModeNormal(
         JNIEnv *jEnv,
         jobject jThis,
@@ -976,7 +1629,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniPowerModeNormal(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniPowerModeLow(
         JNIEnv *jEnv,
         jobject jThis,
@@ -988,7 +1641,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniPowerModeLow(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetSeedWords(
         JNIEnv *jEnv,
         jobject jThis,
@@ -999,27 +1652,95 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetSeedWords(
     });
 }
 
+// the key value cache takes std::string, which can't be built from a null c_str()
+static bool CheckKeyValueString(const JavaStringUtf8 &string, int *errorPointer) {
+    if (!CheckJavaString(string, errorPointer)) {
+        return false;
+    }
+    if (string.c_str() == nullptr) {
+        *errorPointer = InvalidArgumentErrorCode;
+        return false;
+    }
+    return true;
+}
+
 extern "C"
-JNIEXPORT jboolean JNICALL
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniSetKeyValue(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jKey,
         jstring jValue,
         jobject error) {
-    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) -> jboolean {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *pKey = jEnv->GetStringUTFChars(jKey, JNI_FALSE);
-        const char *pValue = jEnv->GetStringUTFChars(jValue, JNI_FALSE);
-        auto result = static_cast<jboolean>(wallet_set_key_value(pWallet, pKey, pValue, errorPointer));
-        jEnv->ReleaseStringUTFChars(jKey, pKey);
-        jEnv->ReleaseStringUTFChars(jValue, pValue);
-        return result;
+        JavaStringUtf8 key(jEnv, jKey);
+        JavaStringUtf8 value(jEnv, jValue);
+        if (!CheckKeyValueString(key, errorPointer) || !CheckKeyValueString(value, errorPointer)) {
+            return JNI_FALSE;
+        }
+        return static_cast<jboolean>(SetKeyValue(pWallet, key.c_str(), value.c_str(), errorPointer));
+    });
+}
+
+// copies the elements of a String[] into strings, false with errorPointer set if one of them is
+// null or can't be read
+static bool GetJavaStrings(JNIEnv *jEnv, jobjectArray jStrings, std::vector<std::string> &strings, int *errorPointer) {
+    jsize count = jEnv->GetArrayLength(jStrings);
+    strings.reserve(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; ++i) {
+        auto jString = (jstring) jEnv->GetObjectArrayElement(jStrings, i);
+        if (jString == nullptr) {
+            *errorPointer = InvalidArgumentErrorCode;
+            return false;
+        }
+        JavaStringUtf8 string(jEnv, jString);
+        jEnv->DeleteLocalRef(jString);
+        if (!CheckKeyValueString(string, errorPointer)) {
+            return false;
+        }
+        strings.emplace_back(string.c_str());
+    }
+    return true;
+}
+
+/**
+ * Buffers keys[i] = values[i] in the key value cache, they reach the database with the next flush.
+ */
+extern "C"
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSetKeyValues(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jKeys,
+        jobjectArray jValues,
+        jobject error) {
+    ExecuteWithError(jEnv, error, [&](int *errorPointer) {
+        if (jEnv->GetArrayLength(jKeys) != jEnv->GetArrayLength(jValues)) {
+            *errorPointer = InvalidArgumentErrorCode;
+            return;
+        }
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        if (GetJavaStrings(jEnv, jKeys, keys, errorPointer) && GetJavaStrings(jEnv, jValues, values, errorPointer)) {
+            SetKeyValues(GetPointerField<TariWallet *>(jEnv, jThis), keys, values);
+        }
+    });
+}
+
+extern "C"
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniCommitKeyValues(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    ExecuteWithError(jEnv, error, [&](int *errorPointer) {
+        CommitKeyValues(GetPointerField<TariWallet *>(jEnv, jThis), errorPointer);
     });
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniStartTXOValidation(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1031,41 +1752,99 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniStartTXOValidation(
 }
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniStartTXOValidationU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(wallet_start_txo_validation(pWallet, errorPointer));
+    });
+}
+
+extern "C"
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetKeyValue(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jKey,
         jobject error) {
-    return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) -> jstring {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        JavaStringUtf8 key(jEnv, jKey);
+        if (!CheckKeyValueString(key, errorPointer)) {
+            return nullptr;
+        }
+        std::string value;
+        return GetKeyValue(pWallet, key.c_str(), &value, errorPointer) ? NewJavaString(jEnv, value) : nullptr;
+    });
+}
+
+/**
+ * Values of the keys, null for the ones that are not set. Served from the key value cache where it can.
+ */
+extern "C"
+jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetKeyValues(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jKeys,
+        jobject error) {
+    return ExecuteWithError<jobjectArray>(jEnv, error, [&](int *errorPointer) -> jobjectArray {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *pKey = jEnv->GetStringUTFChars(jKey, JNI_FALSE);
-        const char *pValue = wallet_get_value(pWallet, pKey, errorPointer);
-        jEnv->ReleaseStringUTFChars(jKey, pKey);
-        jstring result = jEnv->NewStringUTF(pValue);
-        string_destroy(const_cast<char *>(pValue));
+        std::vector<std::string> keys;
+        if (!GetJavaStrings(jEnv, jKeys, keys, errorPointer)) {
+            return nullptr;
+        }
+        auto count = static_cast<jsize>(keys.size());
+        jobjectArray result = jEnv->NewObjectArray(count, GetJniIds().stringClass, nullptr);
+        if (result == nullptr) {
+            jEnv->ExceptionClear();
+            *errorPointer = OutOfMemoryErrorCode;
+            return nullptr;
+        }
+        std::string value;
+        for (jsize i = 0; i < count; ++i) {
+            if (!GetKeyValue(pWallet, keys[i], &value, errorPointer)) {
+                if (*errorPointer != ValuesNotFoundErrorCode) {
+                    return nullptr;
+                }
+                *errorPointer = 0;
+                continue;
+            }
+            jstring jValue = NewJavaString(jEnv, value);
+            if (jValue == nullptr) {
+                jEnv->ExceptionClear();
+                *errorPointer = OutOfMemoryErrorCode;
+                return nullptr;
+            }
+            jEnv->SetObjectArrayElement(result, i, jValue);
+            jEnv->DeleteLocalRef(jValue);
+        }
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniRemoveKeyValue(
         JNIEnv *jEnv,
         jobject jThis,
         jstring jKey,
         jobject error) {
-    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) -> jboolean {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *pKey = jEnv->GetStringUTFChars(jKey, JNI_FALSE);
-        auto result = static_cast<jboolean>(wallet_clear_value(pWallet, pKey, errorPointer));
-        jEnv->ReleaseStringUTFChars(jKey, pKey);
-        return result;
+        JavaStringUtf8 key(jEnv, jKey);
+        if (!CheckKeyValueString(key, errorPointer)) {
+            return JNI_FALSE;
+        }
+        return static_cast<jboolean>(RemoveKeyValue(pWallet, key.c_str(), errorPointer));
     });
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetConfirmations(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1077,7 +1856,19 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetConfirmations(
 }
 
 extern "C"
-JNIEXPORT void JNICALL
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetConfirmationsU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        return getLongFromUnsignedLongLong(wallet_get_num_confirmations_required(pWallet, errorPointer));
+    });
+}
+
+extern "C"
+void JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniSetConfirmations(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1085,16 +1876,62 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSetConfirmations(
         jobject error) {
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *nativeString = jEnv->GetStringUTFChars(jNumber, JNI_FALSE);
+        JavaStringUtf8 numberString(jEnv, jNumber);
+        if (!CheckJavaString(numberString, errorPointer)) {
+            return;
+        }
         char *pEnd;
-        unsigned long long number = strtoull(nativeString, &pEnd, 10);
+        unsigned long long number = strtoull(numberString.c_str(), &pEnd, 10);
+        wallet_set_num_confirmations_required(pWallet, number, errorPointer);
+    });
+}
+
+extern "C"
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSetConfirmationsU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong number,
+        jobject error) {
+    ExecuteWithError(jEnv, error, [&](int *errorPointer) {
+        if (!CheckUnsignedArgument(number, errorPointer)) {
+            return;
+        }
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         wallet_set_num_confirmations_required(pWallet, number, errorPointer);
-        jEnv->ReleaseStringUTFChars(jNumber, nativeString);
     });
 }
 
+static unsigned long long SendTx(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jDestination,
+        unsigned long long amount,
+        unsigned long long feePerGram,
+        jstring jMessage,
+        jboolean jOneSided,
+        jstring jPaymentId,
+        int *errorPointer) {
+    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+    auto pDestination = GetPointerField<TariWalletAddress *>(jEnv, jDestination);
+    JavaStringUtf8 message(jEnv, jMessage);
+    JavaStringUtf8 paymentId(jEnv, jPaymentId);
+    if (!CheckJavaString(message, errorPointer) || !CheckJavaString(paymentId, errorPointer)) {
+        return 0;
+    }
+    unsigned long long txId = wallet_send_transaction(pWallet, pDestination, amount, nullptr, feePerGram, message.c_str(),
+                                                      jOneSided, paymentId.c_str(), errorPointer);
+    if (*errorPointer == 0) {
+        JournalSentTx(pWallet, txId);
+        IndexSentTx(pWallet, txId);
+        // the sent tx locked its inputs, don't wait for the balance update
+        InvalidateFeeEstimates();
+    }
+    return txId;
+}
+
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniSendTx(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1106,55 +1943,65 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSendTx(
         jstring jPaymentId,
         jobject error) {
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
-        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        auto pDestination = GetPointerField<TariWalletAddress *>(jEnv, jDestination);
-        const char *nativeAmount = jEnv->GetStringUTFChars(jAmount, JNI_FALSE);
-        const char *nativeFeePerGram = jEnv->GetStringUTFChars(jFeePerGram, JNI_FALSE);
-        const char *pMessage = jEnv->GetStringUTFChars(jMessage, JNI_FALSE);
-        const char *pPaymentId = jEnv->GetStringUTFChars(jPaymentId, JNI_FALSE);
+        JavaStringUtf8 amountString(jEnv, jAmount);
+        JavaStringUtf8 feePerGramString(jEnv, jFeePerGram);
+        if (!CheckJavaString(amountString, errorPointer) || !CheckJavaString(feePerGramString, errorPointer)) {
+            return static_cast<jbyteArray>(nullptr);
+        }
         char *pAmountEnd;
         char *pFeeEnd;
-        unsigned long long feePerGram = strtoull(nativeFeePerGram, &pFeeEnd, 10);
-        unsigned long long amount = strtoull(nativeAmount, &pAmountEnd, 10);
+        unsigned long long feePerGram = strtoull(feePerGramString.c_str(), &pFeeEnd, 10);
+        unsigned long long amount = strtoull(amountString.c_str(), &pAmountEnd, 10);
 
-        jbyteArray result = getBytesFromUnsignedLongLong(
-                jEnv,
-                wallet_send_transaction(pWallet, pDestination, amount, nullptr, feePerGram, pMessage,
-                                        jOneSided, pPaymentId, errorPointer));
-        jEnv->ReleaseStringUTFChars(jAmount, nativeAmount);
-        jEnv->ReleaseStringUTFChars(jFeePerGram, nativeFeePerGram);
-        jEnv->ReleaseStringUTFChars(jMessage, pMessage);
-        return result;
+        return getBytesFromUnsignedLongLong(
+                jEnv, SendTx(jEnv, jThis, jDestination, amount, feePerGram, jMessage, jOneSided, jPaymentId, errorPointer));
+    });
+}
+
+extern "C"
+jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSendTxU64(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jDestination,
+        jlong amount,
+        jlong feePerGram,
+        jstring jMessage,
+        jboolean jOneSided,
+        jstring jPaymentId,
+        jobject error) {
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        if (!CheckUnsignedArgument(amount, errorPointer) || !CheckUnsignedArgument(feePerGram, errorPointer)) {
+            return 0;
+        }
+        return getLongFromUnsignedLongLong(
+                SendTx(jEnv, jThis, jDestination, amount, feePerGram, jMessage, jOneSided, jPaymentId, errorPointer));
     });
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniStartRecovery(
         JNIEnv *jEnv,
         jobject jThis,
         jobject base_node_public_key,
-        jstring callback,
-        jstring callback_sig,
         jstring recovery_output_message,
         jobject error) {
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         auto pTariPublicKey = GetPointerField<TariPublicKey *>(jEnv, base_node_public_key);
-        recoveringProcessCompleteCallbackMethodId = getMethodId(jEnv, jThis, callback, callback_sig);
-        if (recoveringProcessCompleteCallbackMethodId == nullptr) {
-            SetNullPointerField(jEnv, jThis);
+        JavaStringUtf8 recoveryOutputMessage(jEnv, recovery_output_message);
+        if (!CheckJavaString(recoveryOutputMessage, errorPointer)) {
+            return false;
         }
 
-        const char *pRecoveryOutputMessage = jEnv->GetStringUTFChars(recovery_output_message, JNI_FALSE);
-
-        return wallet_start_recovery(pWallet, pTariPublicKey, recoveringProcessCompleteCallback, pRecoveryOutputMessage, errorPointer);
+        return wallet_start_recovery(pWallet, pTariPublicKey, recoveringProcessCompleteCallback, recoveryOutputMessage.c_str(), errorPointer);
     });
 }
 
 
 extern "C"
-JNIEXPORT jstring JNICALL
+jstring JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniSignMessage(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1162,11 +2009,13 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSignMessage(
         jobject error) {
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        const char *pMessage = jEnv->GetStringUTFChars(jMessage, JNI_FALSE);
-        char *pSignature = wallet_sign_message(pWallet, pMessage, errorPointer);
+        JavaStringUtf8 message(jEnv, jMessage);
+        if (!CheckJavaString(message, errorPointer)) {
+            return static_cast<jstring>(nullptr);
+        }
+        char *pSignature = wallet_sign_message(pWallet, message.c_str(), errorPointer);
 
-        jEnv->ReleaseStringUTFChars(jMessage, pMessage);
-        jstring result = jEnv->NewStringUTF(pSignature);
+        jstring result = NewJavaString(jEnv, pSignature);
         string_destroy(pSignature);
 
         return result;
@@ -1174,7 +2023,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSignMessage(
 }
 
 extern "C"
-JNIEXPORT jboolean JNICALL
+jboolean JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniVerifyMessageSignature(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1187,23 +2036,24 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniVerifyMessageSignature(
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         jlong lPublicKey = GetPointerField(jEnv, jpPublicKey);
         auto *pContactPublicKey = reinterpret_cast<TariPublicKey *>(lPublicKey);
-        const char *pHexSignatureNonce = jEnv->GetStringUTFChars(jHexSignatureNonce, JNI_FALSE);
-        const char *pMessage = jEnv->GetStringUTFChars(jMessage, JNI_FALSE);
+        JavaStringUtf8 hexSignatureNonce(jEnv, jHexSignatureNonce);
+        JavaStringUtf8 message(jEnv, jMessage);
+        if (!CheckJavaString(hexSignatureNonce, errorPointer) || !CheckJavaString(message, errorPointer)) {
+            return static_cast<jboolean>(JNI_FALSE);
+        }
         auto result = static_cast<jboolean>(
                 wallet_verify_message_signature(
-                        pWallet, pContactPublicKey, pHexSignatureNonce, pMessage, errorPointer
+                        pWallet, pContactPublicKey, hexSignatureNonce.c_str(), message.c_str(), errorPointer
                 ) != 0
         );
 
-        jEnv->ReleaseStringUTFChars(jHexSignatureNonce, pHexSignatureNonce);
-        jEnv->ReleaseStringUTFChars(jMessage, pMessage);
 
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniWalletGetFeePerGramStats(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1217,7 +2067,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniWalletGetFeePerGramStats(
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniWalletGetUnspentOutputs(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1230,7 +2080,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniWalletGetUnspentOutputs(
 }
 
 extern "C"
-JNIEXPORT jbyteArray JNICALL
+jbyteArray JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniImportExternalUtxoAsNonRewindable(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1245,27 +2095,29 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniImportExternalUtxoAsNonRewindable(
 
     auto pOutputs = GetPointerField<TariUnblindedOutput *>(jEnv, jOutput);
 
-    const char *pMessage = jEnv->GetStringUTFChars(jMessage, JNI_FALSE);
+    JavaStringUtf8 message(jEnv, jMessage);
 
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
+        if (!CheckJavaString(message, errorPointer)) {
+            return static_cast<jbyteArray>(nullptr);
+        }
         jbyteArray result = getBytesFromUnsignedLongLong(
                 jEnv,
                 wallet_import_external_utxo_as_non_rewindable(
                         pWallet,
                         pOutputs,
                         pSourceWalletAddress,
-                        pMessage,
+                        message.c_str(),
                         errorPointer
                 )
         );
 
-        jEnv->ReleaseStringUTFChars(jMessage, pMessage);
         return result;
     });
 }
 
 extern "C"
-JNIEXPORT jlong JNICALL
+jlong JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniGetBaseNodePeers(
         JNIEnv *jEnv,
         jobject jThis,
@@ -1275,4 +2127,135 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetBaseNodePeers(
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_seed_peers(pWallet, error);
     });
-}
\ No newline at end of file
+}
+
+static const JNINativeMethod ffiWalletMethods[] = {
+        NATIVE_METHOD(FFIWallet, jniCreate, "(" FFI_TYPE("FFICommsConfig") JAVA_STRING "III" JAVA_STRING JAVA_STRING FFI_TYPE("FFISeedWords") JAVA_STRING "ZZIII" FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIWallet, jniGetBalance, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetCachedBalance, "(" FFI_ERROR ")[J"),
+        NATIVE_METHOD(FFIWallet, jniGetUtxos, "(IIIJ" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetAllUtxos, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniLogMessage, "(" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIWallet, jniGetWalletAddress, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetContacts, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniAddUpdateContact, "(" FFI_TYPE("FFIContact") FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniRemoveContact, "(" FFI_TYPE("FFIContact") FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniFindContact, "(" JAVA_STRING FFI_TYPE("FFIContactIndexEntry") FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniRemoveContactByAddress, "(" JAVA_STRING FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniGetCompletedTxs, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetCancelledTxs, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetCompletedTxById, "(" JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetCompletedTxByIdU64, "(J" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetCancelledTxById, "(" JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetCancelledTxByIdU64, "(J" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetPendingOutboundTxs, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetPendingOutboundTxById, "(" JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetPendingOutboundTxByIdU64, "(J" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetPendingInboundTxs, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetPendingInboundTxById, "(" JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetPendingInboundTxByIdU64, "(J" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniCancelPendingTx, "(" JAVA_STRING FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniCancelPendingTxU64, "(J" FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniDestroy, "()V"),
+        NATIVE_METHOD(FFIWallet, jniGetIndexedTx, "(J" FFI_ERROR ")[J"),
+        NATIVE_METHOD(FFIWallet, jniCheckTxIndex, "(" FFI_ERROR ")I"),
+        NATIVE_METHOD(FFIWallet, jniGetChangesSince, "(J" FFI_ERROR ")" JAVA_BYTE_BUFFER),
+        NATIVE_METHOD(FFIWallet, jniGetCallbackThreadStats, "()[J"),
+        NATIVE_METHOD(FFIWallet, jniGetEventQueueStats, "()[J"),
+        NATIVE_METHOD(FFIWallet, jniGetCallbackStats, "()[J"),
+        NATIVE_METHOD(FFIWallet, jniGetFeeEstimateCacheStats, "()[J"),
+        NATIVE_METHOD(FFIWallet, jniEstimateTxFee, "(" JAVA_STRING JAVA_STRING JAVA_STRING JAVA_STRING FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIWallet, jniEstimateTxFeeU64, "(JJJJ" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniJoinUtxos, "([" JAVA_STRING JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniJoinUtxosU64, "([" JAVA_STRING "J" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniJoinPackedUtxos, "([BJ" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniSplitUtxos, "([" JAVA_STRING JAVA_STRING JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniSplitUtxosU64, "([" JAVA_STRING "JJ" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniSplitPackedUtxos, "([BJJ" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniPreviewJoinUtxos, "([" JAVA_STRING JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniPreviewJoinUtxosU64, "([" JAVA_STRING "J" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniPreviewJoinPackedUtxos, "([BJ" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniPreviewSplitUtxos, "([" JAVA_STRING JAVA_STRING JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniPreviewSplitUtxosU64, "([" JAVA_STRING "JJ" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniPreviewSplitPackedUtxos, "([BJJ" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniAddBaseNodePeer, "(" FFI_TYPE("FFIPublicKey") JAVA_STRING FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniStartTxValidation, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIWallet, jniStartTxValidationU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniRestartTxBroadcast, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIWallet, jniRestartTxBroadcastU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniPowerModeNormal, "(" FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIWallet, jniPowerModeLow, "(" FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIWallet, jniGetSeedWords, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniSetKeyValue, "(" JAVA_STRING JAVA_STRING FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniSetKeyValues, "([" JAVA_STRING "[" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIWallet, jniCommitKeyValues, "(" FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIWallet, jniStartTXOValidation, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIWallet, jniStartTXOValidationU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniGetKeyValue, "(" JAVA_STRING FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFIWallet, jniGetKeyValues, "([" JAVA_STRING FFI_ERROR ")[" JAVA_STRING),
+        NATIVE_METHOD(FFIWallet, jniRemoveKeyValue, "(" JAVA_STRING FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniGetConfirmations, "(" FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIWallet, jniGetConfirmationsU64, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniSetConfirmations, "(" JAVA_STRING FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIWallet, jniSetConfirmationsU64, "(J" FFI_ERROR ")V"),
+        NATIVE_METHOD(FFIWallet, jniSendTx, "(" FFI_TYPE("FFITariWalletAddress") JAVA_STRING JAVA_STRING JAVA_STRING "Z" JAVA_STRING FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIWallet, jniSendTxU64, "(" FFI_TYPE("FFITariWalletAddress") "JJ" JAVA_STRING "Z" JAVA_STRING FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniStartRecovery, "(" FFI_TYPE("FFIPublicKey") JAVA_STRING FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniSignMessage, "(" JAVA_STRING FFI_ERROR ")" JAVA_STRING),
+        NATIVE_METHOD(FFIWallet, jniVerifyMessageSignature, "(" FFI_TYPE("FFIPublicKey") JAVA_STRING JAVA_STRING FFI_ERROR ")Z"),
+        NATIVE_METHOD(FFIWallet, jniWalletGetFeePerGramStats, "(I" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniWalletGetUnspentOutputs, "(" FFI_ERROR ")J"),
+        NATIVE_METHOD(FFIWallet, jniImportExternalUtxoAsNonRewindable, "(" FFI_TYPE("FFITariUnblindedOutput") FFI_TYPE("FFITariWalletAddress") JAVA_STRING FFI_ERROR ")[B"),
+        NATIVE_METHOD(FFIWallet, jniGetBaseNodePeers, "(" FFI_ERROR ")J"),
+};
+
+#ifndef NDEBUG
+/**
+ * For tests: calls the wallet callback of the given type on this thread, as the library would. A
+ * balance update carries the wallet's current balance. Only built into debug libraries, its Kotlin
+ * side lives in the debug source set, so release builds can't fake wallet events.
+ */
+extern "C"
+void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWalletTestHooks_jniRunCallback(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jWallet,
+        jint type,
+        jlong value,
+        jobject error) {
+    ExecuteWithError(jEnv, error, [&](int *errorPointer) {
+        switch (type) {
+            case WalletScannedHeightEvent:
+                walletScannedHeightCallback(static_cast<uint64_t>(value));
+                break;
+            case ConnectivityStatusEvent:
+                connectivityStatusCallback(static_cast<uint64_t>(value));
+                break;
+            case BalanceUpdatedEvent: {
+                TariBalance *pBalance = wallet_get_balance(GetPointerField<TariWallet *>(jEnv, jWallet), errorPointer);
+                if (*errorPointer == 0) {
+                    balanceUpdatedCallback(pBalance);
+                }
+                break;
+            }
+            default:
+                *errorPointer = InvalidNumericArgumentErrorCode;
+        }
+    });
+}
+
+static const JNINativeMethod ffiWalletTestHooksMethods[] = {
+        NATIVE_METHOD(FFIWalletTestHooks, jniRunCallback, "(" FFI_TYPE("FFIWallet") "IJ" FFI_ERROR ")V"),
+};
+#endif
+
+jint RegisterWalletNatives(JNIEnv *jEnv) {
+    jint result = RegisterNativeMethods(jEnv, FFI_CLASS("FFIWallet"), ffiWalletMethods, NELEM(ffiWalletMethods));
+#ifndef NDEBUG
+    if (result == JNI_OK) {
+        result = RegisterNativeMethods(jEnv, FFI_CLASS("FFIWalletTestHooks"), ffiWalletTestHooksMethods, NELEM(ffiWalletTestHooksMethods));
+    }
+#endif
+    return result;
+}
@@ -0,0 +1,487 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <wallet.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include "jniCommon.cpp"
+#include "jniWalletEvents.h"
+#include "jniCallbackStats.h"
+
+/**
+ * Bounded queue of wallet events after Dmitry Vyukov's array queue: every cell carries a sequence
+ * number telling producers and the consumer whose turn it is, so a push or pop is a single CAS
+ * on the position counter and no lock is taken. The wallet library's threads are the producers
+ * and the dispatcher thread the consumer; with DropOldestWhenFull a producer may pop as well,
+ * which the algorithm allows.
+ */
+class WalletEventRing {
+public:
+    explicit WalletEventRing(size_t capacity) : mask(capacity - 1), cells(new Cell[capacity]) {
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePosition.store(0, std::memory_order_relaxed);
+        dequeuePosition.store(0, std::memory_order_relaxed);
+    }
+
+    ~WalletEventRing() {
+        delete[] cells;
+    }
+
+    bool TryPush(const WalletEvent &event) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.event = event;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryPop(WalletEvent *event) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    *event = cell.event;
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // approximate while producers are running, exact once they stopped
+    size_t Size() const {
+        size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+        size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    size_t Capacity() const {
+        return mask + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        WalletEvent event;
+    };
+
+    // padding keeps the producers' and the consumer's counters on separate cache lines
+    char padding0[64];
+    const size_t mask;
+    Cell *const cells;
+    char padding1[64];
+    std::atomic<size_t> enqueuePosition;
+    char padding2[64];
+    std::atomic<size_t> dequeuePosition;
+    char padding3[64];
+};
+
+// events handed to Kotlin per onEvents call, plus room for the coalesced ones
+const int WalletEventBatchSize = 64;
+const int CoalescedEventTypeCount = 4;
+// the dispatcher also wakes up on its own this often, in case a wake-up was missed
+const std::chrono::milliseconds WalletEventIdleWait(100);
+
+/**
+ * Newest not yet delivered event of a coalesced type. Only touched by the dispatcher thread.
+ */
+struct CoalescedEventSlot {
+    bool pending = false;
+    WalletEvent event = {};
+};
+
+struct WalletEventDispatcher {
+    // only freed once no producer or stats reader holds it, see UseRing
+    std::atomic<WalletEventRing *> ring;
+    std::atomic<int> ringUsers;
+    int overflowPolicy = BlockWhenFull;
+    long long coalescingWindowNanos = 0;
+    CoalescedEventSlot coalescedSlots[CoalescedEventTypeCount];
+    // when the pending coalesced events are due, 0 if none is pending
+    long long coalescedDeadlineNanos = 0;
+    JavaVM *vm = nullptr;
+    jobject handler = nullptr;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<bool> stopping;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<bool> dispatcherWaiting;
+
+    std::atomic<long long> enqueued;
+    std::atomic<long long> delivered;
+    std::atomic<long long> dropped;
+    std::atomic<long long> blockedWaits;
+    std::atomic<long long> batches;
+    std::atomic<long long> maxDepth;
+    std::atomic<long long> coalesced;
+
+    WalletEventDispatcher() : ring(nullptr), ringUsers(0), running(false), stopping(false), dispatcherWaiting(false), enqueued(0), delivered(0), dropped(0),
+                              blockedWaits(0), batches(0), maxDepth(0), coalesced(0) {}
+};
+
+static WalletEventDispatcher dispatcher;
+
+static size_t RoundUpToPowerOfTwo(int value) {
+    size_t result = 2;
+    while (result < static_cast<size_t>(value)) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * Producers and stats readers count themselves in before they load the ring and out when they are
+ * done with it. With both sides sequentially consistent, StopWalletEventDispatcher either sees a
+ * user that got in or that user sees the stop and leaves.
+ */
+static void UseRing() {
+    dispatcher.ringUsers.fetch_add(1);
+}
+
+static void ReleaseRing() {
+    dispatcher.ringUsers.fetch_sub(1);
+}
+
+static void WaitForRingUsers() {
+    while (dispatcher.ringUsers.load() != 0) {
+        std::this_thread::yield();
+    }
+}
+
+static void WakeDispatcher() {
+    // pairs with the fence in RunDispatcher: the push (a relaxed CAS) must not be ordered after
+    // this load, or both sides could miss each other and the event wait for the idle timeout
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (dispatcher.dispatcherWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(dispatcher.wakeMutex);
+        dispatcher.wakeCondition.notify_one();
+    }
+}
+
+static void DeliverBatch(JNIEnv *jEnv, WalletEvent *batch, int count) {
+    jobject buffer = jEnv->NewDirectByteBuffer(batch, static_cast<jlong>(count) * sizeof(WalletEvent));
+    if (buffer == nullptr) {
+        jEnv->ExceptionClear();
+        LOGE("Failed to wrap %d wallet events, they are lost.", count);
+        for (int i = 0; i < count; i++) {
+            FreeWalletEvent(batch[i]);
+        }
+        return;
+    }
+    jEnv->CallVoidMethod(dispatcher.handler, GetJniIds().onEventsMethodId, buffer);
+    if (jEnv->ExceptionCheck()) {
+        // a throwing listener must not take the dispatcher down with it
+        jEnv->ExceptionDescribe();
+        jEnv->ExceptionClear();
+    }
+    jEnv->DeleteLocalRef(buffer);
+    long long handled = MonotonicNanos();
+    for (int i = 0; i < count; i++) {
+        RecordDeliveryNanos(batch[i].type, handled - batch[i].enqueueNanos);
+    }
+    dispatcher.delivered += count;
+    dispatcher.batches++;
+}
+
+/**
+ * Slot of the status-like events of which only the newest value matters. Per-transaction events
+ * are never coalesced, each of them carries a state change Kotlin has to see.
+ */
+static int CoalescedSlotIndex(int32_t type) {
+    switch (type) {
+        case WalletScannedHeightEvent:
+            return 0;
+        case BalanceUpdatedEvent:
+            return 1;
+        case BaseNodeStatusEvent:
+            return 2;
+        case ConnectivityStatusEvent:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * Parks a coalesced event in its slot, replacing (and freeing) the one already waiting there.
+ * Returns false for the events that are delivered as they come.
+ */
+static bool CoalesceEvent(const WalletEvent &event) {
+    int index = dispatcher.coalescingWindowNanos > 0 ? CoalescedSlotIndex(event.type) : -1;
+    if (index < 0) {
+        return false;
+    }
+    CoalescedEventSlot &slot = dispatcher.coalescedSlots[index];
+    if (slot.pending) {
+        FreeWalletEvent(slot.event);
+        dispatcher.coalesced++;
+    }
+    slot.event = event;
+    slot.pending = true;
+    if (dispatcher.coalescedDeadlineNanos == 0) {
+        dispatcher.coalescedDeadlineNanos = MonotonicNanos() + dispatcher.coalescingWindowNanos;
+    }
+    return true;
+}
+
+static int TakeCoalescedEvents(WalletEvent *batch, int count) {
+    for (CoalescedEventSlot &slot : dispatcher.coalescedSlots) {
+        if (slot.pending) {
+            batch[count++] = slot.event;
+            slot.pending = false;
+        }
+    }
+    dispatcher.coalescedDeadlineNanos = 0;
+    return count;
+}
+
+static void RunDispatcher() {
+    JNIEnv *jEnv = nullptr;
+    JavaVMAttachArgs attachArgs = {JNI_VERSION_1_6, const_cast<char *>("WalletEvents"), nullptr};
+    if (dispatcher.vm->AttachCurrentThread(&jEnv, &attachArgs) != JNI_OK) {
+        LOGE("Wallet event dispatcher failed to attach.");
+        return;
+    }
+    WalletEvent batch[WalletEventBatchSize + CoalescedEventTypeCount];
+    // stays alive until this thread is joined
+    WalletEventRing *ring = dispatcher.ring.load();
+    const size_t maxPopsPerBatch = ring->Capacity();
+    for (;;) {
+        int count = 0;
+        size_t pops = 0;
+        // coalesced events do not take batch room, bound the pops so a burst of them cannot keep the loop here
+        while (count < WalletEventBatchSize && pops < maxPopsPerBatch && ring->TryPop(&batch[count])) {
+            pops++;
+            if (!CoalesceEvent(batch[count])) {
+                count++;
+            }
+        }
+        bool stopping = dispatcher.stopping.load();
+        if (dispatcher.coalescedDeadlineNanos != 0 && (MonotonicNanos() >= dispatcher.coalescedDeadlineNanos || stopping)) {
+            count = TakeCoalescedEvents(batch, count);
+        }
+        if (count > 0) {
+            DeliverBatch(jEnv, batch, count);
+            continue;
+        }
+        if (pops > 0) {
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(dispatcher.wakeMutex);
+        dispatcher.dispatcherWaiting.store(true, std::memory_order_relaxed);
+        // producers fence and check dispatcherWaiting after pushing, and this fence keeps the
+        // relaxed Size() below from being read before the flag is published. So an event pushed
+        // before the flag was set is seen here and one pushed after it comes with a notify
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ring->Size() == 0 && !dispatcher.stopping.load()) {
+            if (dispatcher.coalescedDeadlineNanos != 0) {
+                long long remaining = dispatcher.coalescedDeadlineNanos - MonotonicNanos();
+                dispatcher.wakeCondition.wait_for(lock, std::chrono::nanoseconds(remaining > 0 ? remaining : 0));
+            } else {
+                dispatcher.wakeCondition.wait_for(lock, WalletEventIdleWait);
+            }
+        }
+        dispatcher.dispatcherWaiting.store(false, std::memory_order_relaxed);
+    }
+    dispatcher.vm->DetachCurrentThread();
+}
+
+bool StartWalletEventDispatcher(JavaVM *vm, jobject handler, int capacity, int overflowPolicy, int coalescingWindowMillis) {
+    if (dispatcher.running.load()) {
+        return true;
+    }
+    auto *ring = new WalletEventRing(RoundUpToPowerOfTwo(capacity));
+    dispatcher.ring.store(ring);
+    dispatcher.overflowPolicy = overflowPolicy;
+    dispatcher.coalescingWindowNanos = coalescingWindowMillis > 0 ? coalescingWindowMillis * 1000000LL : 0;
+    dispatcher.coalescedDeadlineNanos = 0;
+    dispatcher.vm = vm;
+    dispatcher.handler = handler;
+    dispatcher.stopping.store(false);
+    dispatcher.maxDepth.store(0);
+    try {
+        dispatcher.thread = std::thread(RunDispatcher);
+    } catch (const std::system_error &e) {
+        LOGE("Failed to start the wallet event dispatcher: %s", e.what());
+        dispatcher.ring.store(nullptr);
+        delete ring;
+        return false;
+    }
+    dispatcher.running.store(true);
+    LOGI("Wallet event dispatcher started, capacity %zu, overflow policy %d, coalescing window %d ms.", ring->Capacity(),
+         overflowPolicy, coalescingWindowMillis);
+    return true;
+}
+
+void StopWalletEventDispatcher() {
+    if (!dispatcher.running.load()) {
+        return;
+    }
+    dispatcher.running.store(false);
+    // producers that got in before the stop finish their push, the dispatcher still drains the
+    // ring so blocked ones get room. Everything they queued is delivered before it exits
+    WaitForRingUsers();
+    dispatcher.stopping.store(true);
+    {
+        std::lock_guard<std::mutex> lock(dispatcher.wakeMutex);
+        dispatcher.wakeCondition.notify_one();
+    }
+    dispatcher.thread.join();
+    LOGI("Wallet event dispatcher stopped: %lld enqueued, %lld delivered in %lld batches, %lld coalesced, %lld dropped, max depth %lld.",
+         dispatcher.enqueued.load(), dispatcher.delivered.load(), dispatcher.batches.load(), dispatcher.coalesced.load(),
+         dispatcher.dropped.load(), dispatcher.maxDepth.load());
+    WalletEventRing *ring = dispatcher.ring.exchange(nullptr);
+    // stats readers that loaded the ring before it was cleared
+    WaitForRingUsers();
+    delete ring;
+    dispatcher.handler = nullptr;
+}
+
+bool PostWalletEvent(WalletEvent event) {
+    UseRing();
+    if (!dispatcher.running.load()) {
+        ReleaseRing();
+        return false;
+    }
+    event.enqueueNanos = MonotonicNanos();
+    WalletEventRing *ring = dispatcher.ring.load();
+    while (!ring->TryPush(event)) {
+        switch (dispatcher.overflowPolicy) {
+            case DropNewestWhenFull:
+                dispatcher.dropped++;
+                FreeWalletEvent(event);
+                ReleaseRing();
+                return true;
+            case DropOldestWhenFull: {
+                WalletEvent oldest = {};
+                if (ring->TryPop(&oldest)) {
+                    dispatcher.dropped++;
+                    FreeWalletEvent(oldest);
+                }
+                break;
+            }
+            default:
+                dispatcher.blockedWaits++;
+                WakeDispatcher();
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    dispatcher.enqueued++;
+    auto depth = static_cast<long long>(ring->Size());
+    long long maxDepth = dispatcher.maxDepth.load(std::memory_order_relaxed);
+    while (depth > maxDepth && !dispatcher.maxDepth.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed)) {
+    }
+    WakeDispatcher();
+    ReleaseRing();
+    return true;
+}
+
+void FreeWalletEvent(const WalletEvent &event) {
+    void *pointer = reinterpret_cast<void *>(event.pointer);
+    if (pointer == nullptr) {
+        return;
+    }
+    switch (event.type) {
+        case TxReceivedEvent:
+            pending_inbound_transaction_destroy(static_cast<TariPendingInboundTransaction *>(pointer));
+            break;
+        case TxReplyReceivedEvent:
+        case TxFinalizedEvent:
+        case TxBroadcastEvent:
+        case TxMinedEvent:
+        case TxMinedUnconfirmedEvent:
+        case TxFauxConfirmedEvent:
+        case TxFauxUnconfirmedEvent:
+        case TxCancelledEvent:
+            completed_transaction_destroy(static_cast<TariCompletedTransaction *>(pointer));
+            break;
+        case TxDirectSendResultEvent:
+            transaction_send_status_destroy(static_cast<TariTransactionSendStatus *>(pointer));
+            break;
+        case ContactsLivenessDataUpdatedEvent:
+            liveness_data_destroy(static_cast<TariContactsLivenessData *>(pointer));
+            break;
+        case BalanceUpdatedEvent:
+            balance_destroy(static_cast<TariBalance *>(pointer));
+            break;
+        default:
+            // TariBaseNodeState has no destroy function in the library, FFITariBaseNodeState.destroy is a no-op as well
+            break;
+    }
+}
+
+void GetWalletEventQueueStats(jlong *stats) {
+    UseRing();
+    WalletEventRing *ring = dispatcher.ring.load();
+    stats[0] = ring != nullptr ? static_cast<jlong>(ring->Capacity()) : 0;
+    stats[1] = ring != nullptr ? static_cast<jlong>(ring->Size()) : 0;
+    ReleaseRing();
+    stats[2] = dispatcher.maxDepth.load();
+    stats[3] = dispatcher.enqueued.load();
+    stats[4] = dispatcher.delivered.load();
+    stats[5] = dispatcher.dropped.load();
+    stats[6] = dispatcher.blockedWaits.load();
+    stats[7] = dispatcher.batches.load();
+    stats[8] = dispatcher.coalesced.load();
+}
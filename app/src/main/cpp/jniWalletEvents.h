@@ -0,0 +1,123 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <jni.h>
+#include <cstdint>
+
+/**
+ * Wallet callbacks, in the order of the values decoded by FFIWalletEvents.kt. Keep both in sync.
+ */
+enum WalletEventType : int32_t {
+    TxReceivedEvent = 1,
+    TxReplyReceivedEvent,
+    TxFinalizedEvent,
+    TxBroadcastEvent,
+    TxMinedEvent,
+    TxMinedUnconfirmedEvent,
+    TxFauxConfirmedEvent,
+    TxFauxUnconfirmedEvent,
+    TxDirectSendResultEvent,
+    TxCancelledEvent,
+    TxoValidationCompleteEvent,
+    TxValidationCompleteEvent,
+    ContactsLivenessDataUpdatedEvent,
+    BalanceUpdatedEvent,
+    ConnectivityStatusEvent,
+    WalletScannedHeightEvent,
+    BaseNodeStatusEvent,
+    WalletRecoveryEvent,
+};
+
+const int WalletEventTypeCount = WalletRecoveryEvent;
+
+/**
+ * One wallet callback, copied as is into the ByteBuffer handed to FFIWallet.onEvents.
+ * pointer is the library object passed to the callback (ownership moves to Kotlin), value1 and value2
+ * are its u64 arguments and intArg the recovery event. Unused fields are zero.
+ */
+struct WalletEvent {
+    int32_t type;
+    int32_t intArg;
+    int64_t pointer;
+    uint64_t value1;
+    uint64_t value2;
+    int64_t enqueueNanos;
+};
+
+static_assert(sizeof(WalletEvent) == 40, "FFIWalletEvents.kt decodes 40 byte records");
+
+/**
+ * What a callback thread does when the queue is full. BlockWhenFull keeps every event and makes
+ * the library wait for the dispatcher, the two others keep the library running and free the
+ * dropped event's library object.
+ */
+enum WalletEventOverflowPolicy : int32_t {
+    BlockWhenFull = 0,
+    DropNewestWhenFull = 1,
+    DropOldestWhenFull = 2,
+};
+
+/**
+ * Starts the dispatcher thread, which delivers queued events to handler.onEvents in batches.
+ * capacity is rounded up to a power of two; returns false if the thread could not be started.
+ * With a coalescing window, scanned height, balance, base node and connectivity events are held
+ * back for up to that long and only the newest of each type is delivered; 0 delivers all of them.
+ */
+bool StartWalletEventDispatcher(JavaVM *vm, jobject handler, int capacity, int overflowPolicy, int coalescingWindowMillis);
+
+/**
+ * Delivers what is left in the queue and stops the dispatcher. Posts already under way finish
+ * first, later ones return false. Call after wallet_destroy, so no callback is left waiting for
+ * a delivery that Kotlin no longer listens to.
+ */
+void StopWalletEventDispatcher();
+
+/**
+ * Queues an event for the dispatcher. Returns false if the dispatcher is not running, in which
+ * case the caller delivers the event itself.
+ */
+bool PostWalletEvent(WalletEvent event);
+
+/**
+ * Frees the library object carried by an event that will never reach Kotlin.
+ */
+void FreeWalletEvent(const WalletEvent &event);
+
+/**
+ * Number of values written by GetWalletEventQueueStats:
+ * {capacity, depth, max depth, enqueued, delivered, dropped, blocked waits, batches, coalesced}.
+ */
+const int WalletEventQueueStatsCount = 9;
+
+void GetWalletEventQueueStats(jlong *stats);
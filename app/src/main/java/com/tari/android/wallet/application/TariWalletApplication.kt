@@ -91,8 +91,13 @@ class TariWalletApplication : Application() {
     var isInForeground = false
         private set
 
+    // time spent in System.loadLibrary, JNI_OnLoad (native registration) included
+    private val nativeLibLoadNanos: Long
+
     init {
+        val loadStart = System.nanoTime()
         System.loadLibrary("native-lib")
+        nativeLibLoadNanos = System.nanoTime() - loadStart
     }
 
     val currentActivity: Activity?
@@ -120,6 +125,7 @@ class TariWalletApplication : Application() {
 
 
         ProcessLifecycleOwner.get().lifecycle.addObserver(AppObserver())
+        logger.i("Native library loaded in ${nativeLibLoadNanos / 1000} us")
         logger.i("Application inited")
     }
 
@@ -61,7 +61,11 @@ sealed class DeepLink {
                         tariAddress = param.value.firstOrNull { it.name == KEY_TARI_ADDRESS }?.value.orEmpty()
                     )
                 }
-                .filter { TariWalletAddress.validateBase58(it.tariAddress) },
+                .let { contacts ->
+                    // an imported address book can be long, so all addresses are checked in one native call
+                    val valid = TariWalletAddress.validateBase58(contacts.map { it.tariAddress })
+                    contacts.filterIndexed { index, _ -> valid[index] }
+                },
         )
 
         override fun getParams(): Map<String, String> = hashMapOf<String, String>().apply {
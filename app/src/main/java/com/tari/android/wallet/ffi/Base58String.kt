@@ -27,6 +27,7 @@ data class Base58String(val base58: Base58) {
     constructor(ffiByteVector: FFIByteVector) : this(ffiByteVector.byteArray().encodeToBase58String())
     constructor(byte: Byte) : this(byteArrayOf(byte).encodeToBase58String())
     constructor(bytes: List<Byte>) : this(FFIByteVector(bytes.toByteArray()))
+    constructor(bytes: ByteArray) : this(bytes.encodeToBase58String())
 }
 
 /**
@@ -0,0 +1,50 @@
+package com.tari.android.wallet.ffi
+
+/**
+ * Latency of one wallet callback type, from the native histograms (see jniCallbackStats.h). Times are in nanoseconds and percentiles
+ * are histogram bucket upper bounds, so they are at most 25% above the real value.
+ * [type] is a [WalletEventType] value, or [THREAD_ATTACH] for the time spent attaching callback threads to the VM.
+ * The callback figures are the time the wallet library's thread spent in the callback, the delivered ones the time from queueing the
+ * event to the end of the [FFIWallet.onEvents] call that handled it.
+ */
+data class CallbackLatencyStats(
+    val type: Int,
+    val count: Long,
+    val p50Nanos: Long,
+    val p99Nanos: Long,
+    val maxNanos: Long,
+    val deliveredCount: Long,
+    val deliveredP50Nanos: Long,
+    val deliveredP99Nanos: Long,
+    val deliveredMaxNanos: Long,
+) {
+    companion object {
+        const val THREAD_ATTACH = 0
+
+        private const val LAYOUT_VERSION = 1L
+        private const val HEADER_SIZE = 3
+
+        /**
+         * Decodes the buffer returned by FFIWallet.jniGetCallbackStats, skipping types that never fired.
+         */
+        fun decode(packed: LongArray): List<CallbackLatencyStats> {
+            if (packed.size < HEADER_SIZE || packed[0] != LAYOUT_VERSION) return emptyList()
+            val recordCount = packed[1].toInt()
+            val fieldsPerRecord = packed[2].toInt()
+            return (0 until recordCount).map { record ->
+                val offset = HEADER_SIZE + record * fieldsPerRecord
+                CallbackLatencyStats(
+                    type = packed[offset].toInt(),
+                    count = packed[offset + 1],
+                    p50Nanos = packed[offset + 2],
+                    p99Nanos = packed[offset + 3],
+                    maxNanos = packed[offset + 4],
+                    deliveredCount = packed[offset + 5],
+                    deliveredP50Nanos = packed[offset + 6],
+                    deliveredP99Nanos = packed[offset + 7],
+                    deliveredMaxNanos = packed[offset + 8],
+                )
+            }.filter { it.count > 0 || it.deliveredCount > 0 }
+        }
+    }
+}
@@ -0,0 +1,25 @@
+package com.tari.android.wallet.ffi
+
+/**
+ * Counters of the threads the wallet library calls back on, since the wallet was created.
+ * Each callback used to attach its thread to the VM and detach it again, so [callbacksPerSecond]
+ * is the former attach rate and [attachesPerSecond] the current one.
+ */
+data class CallbackThreadStats(
+    val elapsedNanos: Long,
+    val callbacks: Long,
+    val attaches: Long,
+    val detaches: Long,
+) {
+    val callbacksPerSecond: Double
+        get() = perSecond(callbacks)
+
+    val attachesPerSecond: Double
+        get() = perSecond(attaches)
+
+    private fun perSecond(count: Long): Double = if (elapsedNanos > 0) count * 1_000_000_000.0 / elapsedNanos else 0.0
+
+    override fun toString(): String =
+        "$callbacks callbacks, $attaches attaches, $detaches detaches in ${elapsedNanos / 1_000_000} ms " +
+                "(attaches/s: %.2f now, %.2f with per-callback attach)".format(attachesPerSecond, callbacksPerSecond)
+}
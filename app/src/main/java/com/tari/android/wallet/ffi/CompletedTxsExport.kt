@@ -0,0 +1,157 @@
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.CancelledTx
+import com.tari.android.wallet.model.CompletedTransactionKernel
+import com.tari.android.wallet.model.CompletedTx
+import com.tari.android.wallet.model.MicroTari
+import com.tari.android.wallet.model.TariContact
+import com.tari.android.wallet.model.TariWalletAddress
+import com.tari.android.wallet.model.Tx
+import com.tari.android.wallet.model.TxStatus
+import java.math.BigInteger
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Decoder for the columns written by FFICompletedTxs.jniExportAll, see CompletedTxsExport in jniCollections.cpp for the layout.
+ * The whole list crosses JNI once; only the distinct counterparty addresses go back to the library, one call each.
+ */
+class CompletedTxsExport(buffer: ByteBuffer) {
+
+    val size: Int
+    val ids: LongArray
+    val amounts: LongArray
+    val fees: LongArray
+    val timestamps: LongArray
+    val confirmations: LongArray
+    val statuses: IntArray
+    val flags: IntArray
+    val cancellationReasons: IntArray
+    val addressIndices: IntArray
+    private val stringRefs: IntArray
+    private val addressOffsets: IntArray
+    private val strings: CharArray
+    private val addressBytes: ByteArray
+
+    init {
+        val data = buffer.duplicate().order(ByteOrder.nativeOrder())
+        data.position(0)
+        val version = data.int
+        if (version != VERSION) throw FFIException(message = "Unexpected completed txs export version: $version")
+        size = data.int
+        val addressCount = data.int
+        val stringChars = data.int
+        val addressByteCount = data.int
+        data.position(HEADER_SIZE)
+
+        ids = data.readLongColumn(size)
+        amounts = data.readLongColumn(size)
+        fees = data.readLongColumn(size)
+        timestamps = data.readLongColumn(size)
+        confirmations = data.readLongColumn(size)
+        statuses = data.readIntColumn(size)
+        flags = data.readIntColumn(size)
+        cancellationReasons = data.readIntColumn(size)
+        addressIndices = data.readIntColumn(size)
+        stringRefs = data.readIntColumn(size * STRINGS_PER_TX * 2)
+        addressOffsets = data.readIntColumn(addressCount + 1)
+        strings = CharArray(stringChars).also { data.asCharBuffer().get(it) }
+        data.position(data.position() + align8(stringChars * 2))
+        addressBytes = ByteArray(addressByteCount).also { data.get(it) }
+    }
+
+    val addressCount: Int
+        get() = addressOffsets.size - 1
+
+    fun isOutbound(index: Int): Boolean = flags[index] and FLAG_OUTBOUND != 0
+
+    fun hasKernel(index: Int): Boolean = flags[index] and FLAG_KERNEL != 0
+
+    fun getMessage(index: Int): String = getString(index, MESSAGE).orEmpty()
+
+    fun getPaymentId(index: Int): String = getString(index, PAYMENT_ID).orEmpty()
+
+    fun getKernel(index: Int): CompletedTransactionKernel? = if (hasKernel(index)) {
+        CompletedTransactionKernel(getString(index, KERNEL_EXCESS)!!, getString(index, KERNEL_NONCE)!!, getString(index, KERNEL_SIGNATURE)!!)
+    } else null
+
+    /**
+     * Bytes of the counterparty address: the destination of an outbound tx, the source of an inbound one.
+     */
+    fun getAddressBytes(addressIndex: Int): ByteArray = addressBytes.copyOfRange(addressOffsets[addressIndex], addressOffsets[addressIndex + 1])
+
+    fun toCompletedTxs(): List<CompletedTx> {
+        val contacts = decodeContacts()
+        return List(size) { index ->
+            val status = TxStatus.map(FFITxStatus.map(statuses[index]))
+            CompletedTx(
+                id = ids[index].toUnsignedBigInteger(),
+                direction = getDirection(index),
+                amount = MicroTari(amounts[index].toUnsignedBigInteger()),
+                timestamp = timestamps[index].toUnsignedBigInteger(),
+                message = getMessage(index),
+                paymentId = getPaymentId(index),
+                status = status,
+                tariContact = contacts[addressIndices[index]],
+                fee = MicroTari(fees[index].toUnsignedBigInteger()),
+                confirmationCount = confirmations[index].toUnsignedBigInteger(),
+                txKernel = getKernel(index),
+            )
+        }
+    }
+
+    fun toCancelledTxs(): List<CancelledTx> {
+        val contacts = decodeContacts()
+        return List(size) { index ->
+            CancelledTx(
+                id = ids[index].toUnsignedBigInteger(),
+                direction = getDirection(index),
+                amount = MicroTari(amounts[index].toUnsignedBigInteger()),
+                timestamp = timestamps[index].toUnsignedBigInteger(),
+                message = getMessage(index),
+                paymentId = getPaymentId(index),
+                status = TxStatus.map(FFITxStatus.map(statuses[index])),
+                tariContact = contacts[addressIndices[index]],
+                fee = MicroTari(fees[index].toUnsignedBigInteger()),
+                cancellationReason = FFITxCancellationReason.map(cancellationReasons[index]),
+            )
+        }
+    }
+
+    private fun getDirection(index: Int): Tx.Direction = if (isOutbound(index)) Tx.Direction.OUTBOUND else Tx.Direction.INBOUND
+
+    private fun getString(index: Int, field: Int): String? {
+        val ref = (index * STRINGS_PER_TX + field) * 2
+        val length = stringRefs[ref + 1]
+        return if (length < 0) null else String(strings, stringRefs[ref], length)
+    }
+
+    private fun decodeContacts(): List<TariContact> = List(addressCount) { addressIndex ->
+        FFIByteVector(getAddressBytes(addressIndex)).runWithDestroy { bytes ->
+            FFITariWalletAddress(bytes).runWithDestroy { TariContact(TariWalletAddress(it)) }
+        }
+    }
+
+    private fun ByteBuffer.readLongColumn(count: Int): LongArray =
+        LongArray(count).also { asLongBuffer().get(it); position(position() + align8(count * 8)) }
+
+    private fun ByteBuffer.readIntColumn(count: Int): IntArray =
+        IntArray(count).also { asIntBuffer().get(it); position(position() + align8(count * 4)) }
+
+    companion object {
+        const val VERSION = 1
+        const val HEADER_SIZE = 32
+        const val STRINGS_PER_TX = 5
+        const val FLAG_OUTBOUND = 1
+        const val FLAG_KERNEL = 2
+
+        // order of the string refs of one tx
+        const val MESSAGE = 0
+        const val PAYMENT_ID = 1
+        const val KERNEL_EXCESS = 2
+        const val KERNEL_NONCE = 3
+        const val KERNEL_SIGNATURE = 4
+
+        private fun align8(size: Int) = (size + 7) and 7.inv()
+    }
+}
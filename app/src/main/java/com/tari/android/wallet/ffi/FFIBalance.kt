@@ -33,7 +33,6 @@
 package com.tari.android.wallet.ffi
 
 import com.tari.android.wallet.model.MicroTari
-import java.math.BigInteger
 
 /**
  * Wrapper for native byte vector type.
@@ -42,10 +41,14 @@ import java.math.BigInteger
  */
 class FFIBalance() : FFIBase() {
 
-    private external fun jniGetAvailable(libError: FFIError): ByteArray
-    private external fun jniGetIncoming(libError: FFIError): ByteArray
-    private external fun jniGetOutgoing(libError: FFIError): ByteArray
-    private external fun jniGetTimeLocked(libError: FFIError): ByteArray
+    private external fun jniGetAvailable(libError: FFIError?): ByteArray
+    private external fun jniGetAvailableU64(libError: FFIError?): Long
+    private external fun jniGetIncoming(libError: FFIError?): ByteArray
+    private external fun jniGetIncomingU64(libError: FFIError?): Long
+    private external fun jniGetOutgoing(libError: FFIError?): ByteArray
+    private external fun jniGetOutgoingU64(libError: FFIError?): Long
+    private external fun jniGetTimeLocked(libError: FFIError?): ByteArray
+    private external fun jniGetTimeLockedU64(libError: FFIError?): Long
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
@@ -53,13 +56,13 @@ class FFIBalance() : FFIBase() {
         this.pointer = pointer
     }
 
-    fun getAvailable(): MicroTari = runWithError { MicroTari(BigInteger(1, jniGetAvailable(it))) }
+    fun getAvailable(): MicroTari = MicroTari(runWithU64(::jniGetAvailable, ::jniGetAvailableU64))
 
-    fun getIncoming(): MicroTari = runWithError { MicroTari(BigInteger(1, jniGetIncoming(it))) }
+    fun getIncoming(): MicroTari = MicroTari(runWithU64(::jniGetIncoming, ::jniGetIncomingU64))
 
-    fun getOutgoing(): MicroTari = runWithError { MicroTari(BigInteger(1, jniGetOutgoing(it))) }
+    fun getOutgoing(): MicroTari = MicroTari(runWithU64(::jniGetOutgoing, ::jniGetOutgoingU64))
 
-    fun getTimeLocked(): MicroTari = runWithError { MicroTari(BigInteger(1, jniGetTimeLocked(it))) }
+    fun getTimeLocked(): MicroTari = MicroTari(runWithU64(::jniGetTimeLocked, ::jniGetTimeLockedU64))
 
     override fun destroy() = jniDestroy()
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Native base58 codec (see jniBase58.cpp), same alphabet and output as [Base58String] but working on
+ * 32 bit limbs instead of one digit at a time.
+ */
+object FFIBase58 {
+
+    private external fun jniEncode(bytes: ByteArray, isAddress: Boolean): String
+    private external fun jniDecodeAll(base58: Array<String>, areAddresses: Boolean, libError: FFIError?): Array<ByteArray?>
+    private external fun jniValidateAddresses(base58: Array<String>, libError: FFIError?): BooleanArray
+
+    fun encode(bytes: ByteArray): Base58 = jniEncode(bytes, false)
+
+    /**
+     * Tari address layout: network and features byte encoded on their own, followed by the rest of the bytes.
+     */
+    fun encodeAddress(bytes: ByteArray): Base58 = jniEncode(bytes, true)
+
+    /**
+     * Decodes every string, null for the ones that are not base58.
+     */
+    fun decodeAll(base58: Array<String>): Array<ByteArray?> = runWithError { jniDecodeAll(base58, false, it) }
+
+    /**
+     * Address bytes of every Tari address string, null for the ones that are not base58. The checksum is not checked,
+     * see [validateAddresses].
+     */
+    fun decodeAddresses(base58: Array<String>): Array<ByteArray?> = runWithError { jniDecodeAll(base58, true, it) }
+
+    /**
+     * Whether each string is a Tari address the library accepts, decoded and checked in a single call.
+     */
+    fun validateAddresses(base58: Array<String>): BooleanArray = runWithError { jniValidateAddresses(base58, it) }
+}
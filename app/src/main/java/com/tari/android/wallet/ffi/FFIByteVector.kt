@@ -32,6 +32,8 @@
  */
 package com.tari.android.wallet.ffi
 
+import java.nio.ByteBuffer
+
 /**
  * Wrapper for native byte vector type.
  *
@@ -39,10 +41,12 @@ package com.tari.android.wallet.ffi
  */
 class FFIByteVector() : FFIBase() {
 
-    private external fun jniGetLength(error: FFIError): Int
-    private external fun jniGetAt(index: Int, error: FFIError): Int
+    private external fun jniGetLength(error: FFIError?): Int
+    private external fun jniGetAt(index: Int, error: FFIError?): Int
     private external fun jniDestroy()
-    private external fun jniCreate(byteArray: ByteArray, error: FFIError)
+    private external fun jniGetBytes(error: FFIError?): ByteArray
+    private external fun jniCreate(byteArray: ByteArray, error: FFIError?)
+    private external fun jniCreateFromDirectBuffer(buffer: ByteBuffer, offset: Int, length: Int, error: FFIError?)
 
     constructor(pointer: FFIPointer) : this() {
         if (pointer.isNull()) error("Pointer must not be null")
@@ -53,20 +57,27 @@ class FFIByteVector() : FFIBase() {
         runWithError { jniCreate(bytes, it) }
     }
 
+    /**
+     * Bytes from the buffer's position to its limit. A direct buffer is read by the library in place, without a copy on the JVM side;
+     * the buffer's position is left unchanged.
+     */
+    constructor(buffer: ByteBuffer) : this() {
+        if (buffer.isDirect) {
+            runWithError { jniCreateFromDirectBuffer(buffer, buffer.position(), buffer.remaining(), it) }
+        } else {
+            val bytes = ByteArray(buffer.remaining())
+            buffer.duplicate().get(bytes)
+            runWithError { jniCreate(bytes, it) }
+        }
+    }
+
     fun getAt(index: Int): Int = runWithError { jniGetAt(index, it) }
 
     fun getLength(): Int = runWithError { jniGetLength(it) }
 
-    fun byteArray(): ByteArray {
-        val length = getLength()
-        val byteArray = ByteArray(length)
-        for (i in byteArray.indices) {
-            byteArray[i] = getAt(i).toByte()
-        }
-        return byteArray
-    }
+    fun byteArray(): ByteArray = runWithError { jniGetBytes(it) }
 
-    fun base58(): Base58 = Base58String(this).base58
+    fun base58(): Base58 = FFIBase58.encode(byteArray())
 
     fun hex(): String = HexString(this).hex
 
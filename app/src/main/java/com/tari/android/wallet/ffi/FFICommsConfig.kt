@@ -48,10 +48,10 @@ class FFICommsConfig() : FFIBase() {
         datastorePath: String,
         discoveryTimeoutSec: Long,
         jSafDurationSec: Long,
-        error: FFIError
+        error: FFIError?
     )
 
-    private external fun jniGetLastVersion(error: FFIError): String?
+    private external fun jniGetLastVersion(error: FFIError?): String?
 
     private external fun jniDestroy()
 
@@ -37,19 +37,24 @@ import java.math.BigInteger
 
 class FFICompletedTx() : FFITxBase() {
 
-    private external fun jniGetId(libError: FFIError): ByteArray
-    private external fun jniGetDestinationPublicKey(libError: FFIError): FFIPointer
-    private external fun jniGetTransactionKernel(libError: FFIError): FFIPointer
-    private external fun jniGetSourcePublicKey(libError: FFIError): FFIPointer
-    private external fun jniGetAmount(libError: FFIError): ByteArray
-    private external fun jniGetFee(libError: FFIError): ByteArray
-    private external fun jniGetTimestamp(libError: FFIError): ByteArray
-    private external fun jniGetMessage(libError: FFIError): String
-    private external fun jniGetPaymentId(libError: FFIError): String
-    private external fun jniGetStatus(libError: FFIError): Int
-    private external fun jniGetConfirmationCount(libError: FFIError): ByteArray
-    private external fun jniIsOutbound(libError: FFIError): Boolean
-    private external fun jniGetCancellationReason(libError: FFIError): Int
+    private external fun jniGetId(libError: FFIError?): ByteArray
+    private external fun jniGetIdU64(libError: FFIError?): Long
+    private external fun jniGetDestinationPublicKey(libError: FFIError?): FFIPointer
+    private external fun jniGetTransactionKernel(libError: FFIError?): FFIPointer
+    private external fun jniGetSourcePublicKey(libError: FFIError?): FFIPointer
+    private external fun jniGetAmount(libError: FFIError?): ByteArray
+    private external fun jniGetAmountU64(libError: FFIError?): Long
+    private external fun jniGetFee(libError: FFIError?): ByteArray
+    private external fun jniGetFeeU64(libError: FFIError?): Long
+    private external fun jniGetTimestamp(libError: FFIError?): ByteArray
+    private external fun jniGetTimestampU64(libError: FFIError?): Long
+    private external fun jniGetMessage(libError: FFIError?): String
+    private external fun jniGetPaymentId(libError: FFIError?): String
+    private external fun jniGetStatus(libError: FFIError?): Int
+    private external fun jniGetConfirmationCount(libError: FFIError?): ByteArray
+    private external fun jniGetConfirmationCountU64(libError: FFIError?): Long
+    private external fun jniIsOutbound(libError: FFIError?): Boolean
+    private external fun jniGetCancellationReason(libError: FFIError?): Int
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
@@ -59,17 +64,17 @@ class FFICompletedTx() : FFITxBase() {
 
     override fun destroy() = jniDestroy()
 
-    fun getId(): BigInteger = runWithError { BigInteger(1, jniGetId(it)) }
+    fun getId(): BigInteger = runWithU64(::jniGetId, ::jniGetIdU64)
 
     override fun getDestinationPublicKey(): FFITariWalletAddress = runWithError { FFITariWalletAddress(jniGetDestinationPublicKey(it)) }
 
     override fun getSourcePublicKey(): FFITariWalletAddress = runWithError { FFITariWalletAddress(jniGetSourcePublicKey(it)) }
 
-    fun getAmount(): BigInteger = runWithError { BigInteger(1, jniGetAmount(it)) }
+    fun getAmount(): BigInteger = runWithU64(::jniGetAmount, ::jniGetAmountU64)
 
-    fun getFee(): BigInteger = runWithError { BigInteger(1, jniGetFee(it)) }
+    fun getFee(): BigInteger = runWithU64(::jniGetFee, ::jniGetFeeU64)
 
-    fun getTimestamp(): BigInteger = runWithError { BigInteger(1, jniGetTimestamp(it)) }
+    fun getTimestamp(): BigInteger = runWithU64(::jniGetTimestamp, ::jniGetTimestampU64)
 
     fun getMessage(): String = runWithError { jniGetMessage(it) }
 
@@ -77,7 +82,7 @@ class FFICompletedTx() : FFITxBase() {
 
     fun getStatus(): FFITxStatus = runWithError { FFITxStatus.map(jniGetStatus(it)) }
 
-    fun getConfirmationCount(): BigInteger = runWithError { BigInteger(1, jniGetConfirmationCount(it)) }
+    fun getConfirmationCount(): BigInteger = runWithU64(::jniGetConfirmationCount, ::jniGetConfirmationCountU64)
 
     override fun isOutbound(): Boolean = runWithError { jniIsOutbound(it) }
 
@@ -39,9 +39,9 @@ package com.tari.android.wallet.ffi
  */
 class FFICompletedTxKernel() : FFIBase() {
 
-    private external fun jniGetExcess(libError: FFIError): String
-    private external fun jniGetExcessPublicNonce(libError: FFIError): String
-    private external fun jniGetExcessSignature(libError: FFIError): String
+    private external fun jniGetExcess(libError: FFIError?): String
+    private external fun jniGetExcessPublicNonce(libError: FFIError?): String
+    private external fun jniGetExcessSignature(libError: FFIError?): String
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
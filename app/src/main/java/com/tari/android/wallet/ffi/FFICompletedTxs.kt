@@ -32,6 +32,8 @@
  */
 package com.tari.android.wallet.ffi
 
+import java.nio.ByteBuffer
+
 /**
  * Tari completed transactions wrapper.
  *
@@ -39,8 +41,9 @@ package com.tari.android.wallet.ffi
  */
 class FFICompletedTxs() : FFIBase() {
 
-    private external fun jniGetLength(libError: FFIError): Int
-    private external fun jniGetAt(index: Int, libError: FFIError): FFIPointer
+    private external fun jniGetLength(libError: FFIError?): Int
+    private external fun jniGetAt(index: Int, libError: FFIError?): FFIPointer
+    private external fun jniExportAll(libError: FFIError?): ByteBuffer
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
@@ -52,5 +55,10 @@ class FFICompletedTxs() : FFIBase() {
 
     fun getAt(index: Int): FFICompletedTx = runWithError { FFICompletedTx(jniGetAt(index, it)) }
 
+    /**
+     * All txs of the list in one call, instead of a dozen calls per tx through [getAt].
+     */
+    fun exportAll(): CompletedTxsExport = runWithError { CompletedTxsExport(jniExportAll(it)) }
+
     override fun destroy() = jniDestroy()
 }
\ No newline at end of file
@@ -41,12 +41,12 @@ typealias FFIContactPtr = Long
  */
 class FFIContact() : FFIBase() {
 
-    private external fun jniGetAlias(libError: FFIError): String
+    private external fun jniGetAlias(libError: FFIError?): String
 
-    private external fun jniGetIsFavorite(libError: FFIError): Boolean
-    private external fun jniGetTariWalletAddress(libError: FFIError): FFIPointer
+    private external fun jniGetIsFavorite(libError: FFIError?): Boolean
+    private external fun jniGetTariWalletAddress(libError: FFIError?): FFIPointer
     private external fun jniDestroy()
-    private external fun jniCreate(alias: String, isFavorite: Boolean, publicKeyPtr: FFITariWalletAddress, libError: FFIError)
+    private external fun jniCreate(alias: String, isFavorite: Boolean, publicKeyPtr: FFITariWalletAddress, libError: FFIError?)
 
     constructor(pointer: FFIPointer) : this() {
         if (pointer.isNull()) error("Pointer must not be null")
@@ -0,0 +1,13 @@
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.util.EmojiId
+
+/**
+ * A contact as kept by the native contact index, filled in by FFIWallet.jniFindContact.
+ * Field names and types are looked up natively in jniCommon.cpp.
+ */
+class FFIContactIndexEntry {
+    var alias: String = ""
+    var isFavorite: Boolean = false
+    var emojiId: EmojiId = ""
+}
@@ -40,8 +40,8 @@ package com.tari.android.wallet.ffi
 
 class FFIContacts() : FFIBase() {
 
-    private external fun jniGetLength(libError: FFIError): Int
-    private external fun jniGetAt(index: Int, libError: FFIError): FFIContactPtr
+    private external fun jniGetLength(libError: FFIError?): Int
+    private external fun jniGetAt(index: Int, libError: FFIError?): FFIContactPtr
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
@@ -37,7 +37,7 @@ import java.io.Serializable
 
 class FFICovenant(bytes: FFIByteVector) : FFIBase(), Serializable {
 
-    private external fun jniCreateFromBytes(bytes: FFIByteVector, libError: FFIError)
+    private external fun jniCreateFromBytes(bytes: FFIByteVector, libError: FFIError?)
     private external fun jniDestroy()
 
     init {
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Native LRU cache of emoji ids (see jniEmojiIdCache.cpp). FFITariWalletAddress and FFIPublicKey go through it
+ * on their own; [getEmojiIds] converts many addresses in a single call.
+ */
+object FFIEmojiIdCache {
+
+    private external fun jniGetEmojiIds(addresses: Array<ByteArray?>, libError: FFIError?): Array<String?>
+    private external fun jniSetCapacity(capacity: Int)
+    private external fun jniGetStats(): LongArray
+
+    /**
+     * Emoji id of every address, given as its bytes; null for the ones the library rejects.
+     */
+    fun getEmojiIds(addresses: List<ByteArray>): Array<String?> = runWithError { jniGetEmojiIds(addresses.toTypedArray(), it) }
+
+    /**
+     * Maximum number of cached ids, 1024 by default. 0 turns the cache off.
+     */
+    fun setCapacity(capacity: Int) = jniSetCapacity(capacity)
+
+    fun getStats(): EmojiIdCacheStats = EmojiIdCacheStats(jniGetStats())
+}
+
+data class EmojiIdCacheStats(
+    val capacity: Long,
+    val size: Long,
+    val hits: Long,
+    val misses: Long,
+    val evictions: Long,
+) {
+    constructor(stats: LongArray) : this(stats[0], stats[1], stats[2], stats[3], stats[4])
+
+    val hitRate: Double
+        get() = if (hits + misses > 0) hits.toDouble() / (hits + misses) else 0.0
+
+    override fun toString(): String =
+        "$size/$capacity entries, $hits hits, $misses misses, $evictions evictions (hit rate %.1f%%)".format(hitRate * 100)
+}
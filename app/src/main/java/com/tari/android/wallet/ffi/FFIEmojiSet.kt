@@ -41,8 +41,8 @@ class FFIEmojiSet : FFIBase() {
 
     private external fun jniDestroy()
     private external fun jniCreate()
-    private external fun jniGetLength(libError: FFIError): Int
-    private external fun jniGetAt(index: Int, libError: FFIError): FFIPointer
+    private external fun jniGetLength(libError: FFIError?): Int
+    private external fun jniGetAt(index: Int, libError: FFIError?): FFIPointer
 
     init {
         jniCreate()
@@ -43,8 +43,20 @@ fun throwIf(error: FFIError) {
     }
 }
 
+/**
+ * When true (the default), runWithError passes no FFIError to the native call: the bridge returns
+ * the value directly and throws FFIException itself on a non-zero error code. Set to false to go
+ * back to allocating an FFIError per call and checking it afterwards. Callers passing their own
+ * FFIError always get the error code written to it and no exception from the native side.
+ */
+@Volatile
+var nativeErrorExceptions: Boolean = true
+
 @Throws(FFIException::class)
-fun <T> runWithError(action: (error: FFIError) -> T): T {
+fun <T> runWithError(action: (error: FFIError?) -> T): T {
+    if (nativeErrorExceptions) {
+        return action(null)
+    }
     val error = FFIError()
     val result = action(error)
     throwIf(error)
@@ -53,5 +65,10 @@ fun <T> runWithError(action: (error: FFIError) -> T): T {
 
 class FFIException(val error: FFIError? = null, override val message: String? = "Error code: $error") : RuntimeException() {
 
+    /**
+     * Called from the native side (see ThrowFFIException in jniCommon.cpp) when a call fails.
+     */
+    constructor(code: Int) : this(FFIError().also { it.code = code })
+
     override fun toString(): String = "FFIException(error=$error, message=$message)"
 }
@@ -4,10 +4,10 @@ import java.math.BigInteger
 
 class FFIFeePerGramStat(pointer: FFIPointer) : FFIBase() {
 
-    private external fun jniGetOrder(libError: FFIError): ByteArray
-    private external fun jniGetMin(libError: FFIError): ByteArray
-    private external fun jniGetMax(libError: FFIError): ByteArray
-    private external fun jniGetAverage(libError: FFIError): ByteArray
+    private external fun jniGetOrder(libError: FFIError?): ByteArray
+    private external fun jniGetMin(libError: FFIError?): ByteArray
+    private external fun jniGetMax(libError: FFIError?): ByteArray
+    private external fun jniGetAverage(libError: FFIError?): ByteArray
 
 
     init {
@@ -34,8 +34,8 @@ package com.tari.android.wallet.ffi
 
 class FFIFeePerGramStats(pointer: FFIPointer) : FFIBase() {
 
-    private external fun jniFeePerGramStatsGetLength(libError: FFIError): Int
-    private external fun jniGetAt(index: Int, libError: FFIError): FFIPointer
+    private external fun jniFeePerGramStatsGetLength(libError: FFIError?): Int
+    private external fun jniGetAt(index: Int, libError: FFIError?): FFIPointer
     private external fun jniDestroy()
 
     init {
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Native hex codec (see jniHex.cpp), converting many values per call.
+ */
+object FFIHex {
+
+    private external fun jniEncode(bytes: ByteArray, recordSize: Int, upperCase: Boolean, libError: FFIError?): Array<String>
+    private external fun jniDecode(hex: Array<String>, recordSize: Int, libError: FFIError?): ByteArray?
+
+    fun encode(bytes: ByteArray, upperCase: Boolean = false): String =
+        if (bytes.isEmpty()) String() else encodeAll(bytes, bytes.size, upperCase)[0]
+
+    /**
+     * Hex of every recordSize bytes of [bytes], whose size must be a multiple of recordSize.
+     */
+    fun encodeAll(bytes: ByteArray, recordSize: Int, upperCase: Boolean = false): Array<String> =
+        runWithError { jniEncode(bytes, recordSize, upperCase, it) }
+
+    /**
+     * Null if [hex] has an odd length or is not hex.
+     */
+    fun decode(hex: String): ByteArray? = if (hex.length % 2 != 0) null else decodeAll(arrayOf(hex), hex.length / 2)
+
+    /**
+     * Decodes every string, each exactly 2 * recordSize hex chars of either case, into one array of records.
+     * Null if any of them is not.
+     */
+    fun decodeAll(hex: Array<String>, recordSize: Int): ByteArray? = runWithError { jniDecode(hex, recordSize, it) }
+}
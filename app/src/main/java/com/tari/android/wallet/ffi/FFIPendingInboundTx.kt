@@ -42,12 +42,15 @@ import java.math.BigInteger
 
 class FFIPendingInboundTx() : FFITxBase() {
 
-    private external fun jniGetId(libError: FFIError): ByteArray
-    private external fun jniGetSourcePublicKey(libError: FFIError): FFIPointer
-    private external fun jniGetAmount(libError: FFIError): ByteArray
-    private external fun jniGetTimestamp(libError: FFIError): ByteArray
-    private external fun jniGetMessage(libError: FFIError): String
-    private external fun jniGetStatus(libError: FFIError): Int
+    private external fun jniGetId(libError: FFIError?): ByteArray
+    private external fun jniGetIdU64(libError: FFIError?): Long
+    private external fun jniGetSourcePublicKey(libError: FFIError?): FFIPointer
+    private external fun jniGetAmount(libError: FFIError?): ByteArray
+    private external fun jniGetAmountU64(libError: FFIError?): Long
+    private external fun jniGetTimestamp(libError: FFIError?): ByteArray
+    private external fun jniGetTimestampU64(libError: FFIError?): Long
+    private external fun jniGetMessage(libError: FFIError?): String
+    private external fun jniGetStatus(libError: FFIError?): Int
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
@@ -55,7 +58,7 @@ class FFIPendingInboundTx() : FFITxBase() {
         this.pointer = pointer
     }
 
-    fun getId(): BigInteger = runWithError { BigInteger(1, jniGetId(it)) }
+    fun getId(): BigInteger = runWithU64(::jniGetId, ::jniGetIdU64)
 
     override fun getSourcePublicKey(): FFITariWalletAddress = runWithError { FFITariWalletAddress(jniGetSourcePublicKey(it)) }
 
@@ -63,9 +66,9 @@ class FFIPendingInboundTx() : FFITxBase() {
 
     override fun isOutbound(): Boolean = false
 
-    fun getAmount(): BigInteger = runWithError { BigInteger(1, jniGetAmount(it)) }
+    fun getAmount(): BigInteger = runWithU64(::jniGetAmount, ::jniGetAmountU64)
 
-    fun getTimestamp(): BigInteger = runWithError { BigInteger(1, jniGetTimestamp(it)) }
+    fun getTimestamp(): BigInteger = runWithU64(::jniGetTimestamp, ::jniGetTimestampU64)
 
     fun getMessage(): String = runWithError { jniGetMessage(it) }
 
@@ -41,13 +41,17 @@ import java.math.BigInteger
  */
 class FFIPendingOutboundTx() : FFITxBase() {
 
-    private external fun jniGetId(libError: FFIError): ByteArray
-    private external fun jniGetDestinationPublicKey(libError: FFIError): FFIPointer
-    private external fun jniGetAmount(libError: FFIError): ByteArray
-    private external fun jniGetFee(libError: FFIError): ByteArray
-    private external fun jniGetTimestamp(libError: FFIError): ByteArray
-    private external fun jniGetMessage(libError: FFIError): String
-    private external fun jniGetStatus(libError: FFIError): Int
+    private external fun jniGetId(libError: FFIError?): ByteArray
+    private external fun jniGetIdU64(libError: FFIError?): Long
+    private external fun jniGetDestinationPublicKey(libError: FFIError?): FFIPointer
+    private external fun jniGetAmount(libError: FFIError?): ByteArray
+    private external fun jniGetAmountU64(libError: FFIError?): Long
+    private external fun jniGetFee(libError: FFIError?): ByteArray
+    private external fun jniGetFeeU64(libError: FFIError?): Long
+    private external fun jniGetTimestamp(libError: FFIError?): ByteArray
+    private external fun jniGetTimestampU64(libError: FFIError?): Long
+    private external fun jniGetMessage(libError: FFIError?): String
+    private external fun jniGetStatus(libError: FFIError?): Int
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
@@ -55,7 +59,7 @@ class FFIPendingOutboundTx() : FFITxBase() {
         this.pointer = pointer
     }
 
-    fun getId(): BigInteger = runWithError { BigInteger(1, jniGetId(it)) }
+    fun getId(): BigInteger = runWithU64(::jniGetId, ::jniGetIdU64)
 
     override fun getDestinationPublicKey(): FFITariWalletAddress = runWithError { FFITariWalletAddress(jniGetDestinationPublicKey(it)) }
 
@@ -63,11 +67,11 @@ class FFIPendingOutboundTx() : FFITxBase() {
 
     override fun isOutbound(): Boolean = true
 
-    fun getAmount(): BigInteger = runWithError { BigInteger(1, jniGetAmount(it)) }
+    fun getAmount(): BigInteger = runWithU64(::jniGetAmount, ::jniGetAmountU64)
 
-    fun getFee(): BigInteger = runWithError { BigInteger(1, jniGetFee(it)) }
+    fun getFee(): BigInteger = runWithU64(::jniGetFee, ::jniGetFeeU64)
 
-    fun getTimestamp(): BigInteger = runWithError { BigInteger(1, jniGetTimestamp(it)) }
+    fun getTimestamp(): BigInteger = runWithU64(::jniGetTimestamp, ::jniGetTimestampU64)
 
     fun getMessage(): String = runWithError { jniGetMessage(it) }
 
@@ -39,8 +39,8 @@ package com.tari.android.wallet.ffi
  */
 class FFIPendingOutboundTxs() : FFIBase() {
 
-    private external fun jniGetLength(libError: FFIError): Int
-    private external fun jniGetAt(index: Int, libError: FFIError): FFIPointer
+    private external fun jniGetLength(libError: FFIError?): Int
+    private external fun jniGetAt(index: Int, libError: FFIError?): FFIPointer
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
@@ -39,11 +39,11 @@ package com.tari.android.wallet.ffi
  */
 class FFIPublicKey() : FFIBase() {
 
-    private external fun jniGetBytes(libError: FFIError): FFIPointer
+    private external fun jniGetBytes(libError: FFIError?): FFIPointer
     private external fun jniDestroy()
-    private external fun jniCreate(byteVectorPtr: FFIByteVector, libError: FFIError)
-    private external fun jniFromHex(hexStr: String, libError: FFIError)
-    private external fun jniGetEmojiId(libError: FFIError): String
+    private external fun jniCreate(byteVectorPtr: FFIByteVector, libError: FFIError?)
+    private external fun jniFromHex(hexStr: String, libError: FFIError?)
+    private external fun jniGetEmojiId(libError: FFIError?): String
 
     constructor(pointer: FFIPointer) : this() {
         if (pointer.isNull()) error("Pointer must not be null")
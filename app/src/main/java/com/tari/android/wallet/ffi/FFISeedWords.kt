@@ -42,12 +42,12 @@ import com.tari.android.wallet.model.seedPhrase.SeedWordsWordPushResult
 class FFISeedWords() : FFIBase() {
 
     private external fun jniCreate()
-    private external fun jniPushWord(word: String, libError: FFIError): Int
-    private external fun jniGetLength(libError: FFIError): Int
-    private external fun jniGetAt(index: Int, libError: FFIError): String
+    private external fun jniPushWord(word: String, libError: FFIError?): Int
+    private external fun jniGetLength(libError: FFIError?): Int
+    private external fun jniGetAt(index: Int, libError: FFIError?): String
     private external fun jniDestroy()
 
-    external fun jniGetMnemonicWordListForLanguage(language: String, libError: FFIError)
+    external fun jniGetMnemonicWordListForLanguage(language: String, libError: FFIError?)
 
     init {
         jniCreate()
@@ -4,7 +4,7 @@ import java.math.BigInteger
 
 class FFITariBaseNodeState() : FFIBase() {
 
-    private external fun jniGetHeightOfLongestChain(libError: FFIError): ByteArray
+    private external fun jniGetHeightOfLongestChain(libError: FFIError?): ByteArray
 
     constructor(pointer: FFIPointer) : this() {
         this.pointer = pointer
@@ -41,15 +41,15 @@ package com.tari.android.wallet.ffi
 class FFITariTransportConfig() : FFIBase() {
 
     private external fun jniMemoryTransport()
-    private external fun jniGetMemoryAddress(libError: FFIError): String
-    private external fun jniTCPTransport(listenerAddress: String, libError: FFIError)
+    private external fun jniGetMemoryAddress(libError: FFIError?): String
+    private external fun jniTCPTransport(listenerAddress: String, libError: FFIError?)
     private external fun jniTorTransport(
         control_server_address: String,
         torCookie: FFIByteVector,
         torPort: Int,
         socksUsername: String,
         socksPassword: String,
-        libError: FFIError
+        libError: FFIError?
     )
     private external fun jniDestroy()
 
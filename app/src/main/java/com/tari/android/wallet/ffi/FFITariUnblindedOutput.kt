@@ -2,8 +2,8 @@ package com.tari.android.wallet.ffi
 
 class FFITariUnblindedOutput() : FFIBase() {
 
-    private external fun jniToJson(libError: FFIError): String
-    private external fun jniFromJson(json: String, libError: FFIError)
+    private external fun jniToJson(libError: FFIError?): String
+    private external fun jniFromJson(json: String, libError: FFIError?)
     private external fun jniDestroy()
 
     constructor(pointer: FFIPointer) : this() {
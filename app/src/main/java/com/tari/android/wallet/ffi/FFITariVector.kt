@@ -1,31 +1,40 @@
 package com.tari.android.wallet.ffi
 
+import com.tari.android.wallet.model.TariUtxo
+import java.nio.ByteBuffer
+
+/**
+ * Only destroy vectors the caller owns, such as the result of wallet_get_utxos; the outputs vector of a coin preview belongs to the preview.
+ */
 class FFITariVector(pointer: FFIPointer) : FFIBase() {
 
     var len: Long = -1
     var cap: Long = -1
     val tag: Int = -1
-    var itemsList = mutableListOf<FFITariUtxo>()
+    var utxos: List<TariUtxo> = emptyList()
     var longs = mutableListOf<Long>()
 
     private external fun jniLoadData()
     private external fun jniGetItemAt(index: Int): FFIPointer
+    private external fun jniExportUtxos(libError: FFIError?): ByteBuffer
+    private external fun jniDestroy()
 
     init {
         this.pointer = pointer
         jniLoadData()
-        val vectorTag = TariVectorTag.entries.firstOrNull { it.value == tag }
-        for (i in 0 until len) {
-            val newItemPointer = jniGetItemAt(i.toInt())
-            when (vectorTag) {
-                TariVectorTag.Utxo -> itemsList.add(FFITariUtxo(newItemPointer))
-                TariVectorTag.U64 -> longs.add(newItemPointer)
-                else -> Unit
-            }
+        when (TariVectorTag.entries.firstOrNull { it.value == tag }) {
+            TariVectorTag.Utxo -> utxos = exportUtxos().toTariUtxos()
+            TariVectorTag.U64 -> for (i in 0 until len) longs.add(jniGetItemAt(i.toInt()))
+            else -> Unit
         }
     }
 
-    override fun destroy() = Unit
+    /**
+     * All UTXOs of the vector in one call. Empty unless the vector holds UTXOs.
+     */
+    fun exportUtxos(): UtxosExport = runWithError { UtxosExport(jniExportUtxos(it)) }
+
+    override fun destroy() = jniDestroy()
 
     enum class TariVectorTag(val value: Int) {
         None(-1),
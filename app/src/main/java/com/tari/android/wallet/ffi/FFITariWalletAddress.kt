@@ -41,17 +41,18 @@ import com.tari.android.wallet.util.EmojiId
  */
 class FFITariWalletAddress() : FFIBase() {
 
-    private external fun jniGetBytes(libError: FFIError): FFIPointer
+    private external fun jniGetBytes(libError: FFIError?): FFIPointer
     private external fun jniDestroy()
-    private external fun jniCreate(byteVectorPtr: FFIByteVector, libError: FFIError)
-    private external fun jniFromBase58(base58: Base58, libError: FFIError)
-    private external fun jniFromEmojiId(emoji: EmojiId, libError: FFIError)
-    private external fun jniGetEmojiId(libError: FFIError): EmojiId
-    private external fun jniGetNetwork(libError: FFIError): Int
-    private external fun jniGetFeatures(libError: FFIError): Int
-    private external fun jniGetViewKey(libError: FFIError): FFIPointer
-    private external fun jniGetSpendKey(libError: FFIError): FFIPointer
-    private external fun jniGetChecksum(libError: FFIError): Int
+    private external fun jniCreate(byteVectorPtr: FFIByteVector, libError: FFIError?)
+    private external fun jniFromBase58(base58: Base58, libError: FFIError?)
+    private external fun jniFromEmojiId(emoji: EmojiId, libError: FFIError?)
+    private external fun jniGetEmojiId(libError: FFIError?): EmojiId
+    private external fun jniGetNetwork(libError: FFIError?): Int
+    private external fun jniGetFeatures(libError: FFIError?): Int
+    private external fun jniGetViewKey(libError: FFIError?): FFIPointer
+    private external fun jniGetSpendKey(libError: FFIError?): FFIPointer
+    private external fun jniGetChecksum(libError: FFIError?): Int
+    private external fun jniDecompose(parts: FFITariWalletAddressParts, libError: FFIError?)
 
     constructor(pointer: FFIPointer) : this() {
         if (pointer.isNull()) error("Pointer must not be null")
@@ -84,6 +85,11 @@ class FFITariWalletAddress() : FFIBase() {
 
     fun getChecksum(): Int = runWithError { jniGetChecksum(it) }
 
+    /**
+     * All the parts of the address in one call. The view and spend keys are read and freed natively.
+     */
+    fun decompose(): FFITariWalletAddressParts = FFITariWalletAddressParts().also { parts -> runWithError { jniDecompose(parts, it) } }
+
     fun notificationHex(): String = getSpendKey().getByteVector().hex()
 
     override fun toString(): String = getEmojiId()
@@ -0,0 +1,19 @@
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.util.EmojiId
+
+/**
+ * Everything TariWalletAddress is built from, filled in by FFITariWalletAddress.jniDecompose in a single call.
+ * Field names and types are looked up natively in jniCommon.cpp.
+ */
+class FFITariWalletAddressParts {
+    var network: Int = 0
+    var features: Int = 0
+    var checksum: Int = 0
+    var emojiId: EmojiId = ""
+    var viewKeyEmojis: EmojiId? = null
+    var spendKeyEmojis: EmojiId = ""
+    var spendKeyIsZero: Boolean = false
+    var bytes: ByteArray = ByteArray(0)
+    var base58: Base58 = ""
+}
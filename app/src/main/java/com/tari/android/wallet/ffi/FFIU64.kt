@@ -0,0 +1,33 @@
+package com.tari.android.wallet.ffi
+
+import java.math.BigInteger
+
+/**
+ * u64 values (amounts, tx ids, fees, timestamps, heights, request ids, ...) cross the JNI boundary as a jlong holding
+ * the same 64 bits, so values above Long.MAX_VALUE arrive negative and have to be read back as unsigned.
+ *
+ * When true, getters and wallet callbacks fall back to the former transport: an 8-byte big-endian array per value.
+ * Callbacks pick the setting up when the wallet is created.
+ */
+@Volatile
+var u64AsByteArrays: Boolean = false
+
+private val TWO_TO_THE_64: BigInteger = BigInteger.ONE.shiftLeft(64)
+
+fun Long.toUnsignedBigInteger(): BigInteger = if (this >= 0) BigInteger.valueOf(this) else BigInteger.valueOf(this).add(TWO_TO_THE_64)
+
+fun ByteArray.toUnsignedBigInteger(): BigInteger = BigInteger(1, this)
+
+/**
+ * The jlong passed for a u64 argument such as an amount or a fee. Values outside 0..Long.MAX_VALUE become -1, which
+ * the native side rejects with WalletError.InvalidNumericArgumentError instead of silently truncating them.
+ * Tx ids use the whole u64 range and are passed with toLong() instead.
+ */
+fun BigInteger.toU64Argument(): Long = if (signum() >= 0 && bitLength() < Long.SIZE_BITS) toLong() else -1L
+
+/**
+ * Reads a u64 through whichever native variant [u64AsByteArrays] selects.
+ */
+fun runWithU64(bytes: (FFIError?) -> ByteArray, value: (FFIError?) -> Long): BigInteger = runWithError {
+    if (u64AsByteArrays) bytes(it).toUnsignedBigInteger() else value(it).toUnsignedBigInteger()
+}
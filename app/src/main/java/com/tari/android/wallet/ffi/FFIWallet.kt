@@ -39,10 +39,12 @@ import com.tari.android.wallet.data.sharedPrefs.security.SecurityPrefRepository
 import com.tari.android.wallet.model.BalanceInfo
 import com.tari.android.wallet.model.CancelledTx
 import com.tari.android.wallet.model.CompletedTx
+import com.tari.android.wallet.model.MicroTari
 import com.tari.android.wallet.model.PendingInboundTx
 import com.tari.android.wallet.model.PendingOutboundTx
 import com.tari.android.wallet.model.PublicKey
 import com.tari.android.wallet.model.TariCoinPreview
+import com.tari.android.wallet.model.TariContact
 import com.tari.android.wallet.model.TariUnblindedOutput
 import com.tari.android.wallet.model.TariVector
 import com.tari.android.wallet.model.TariWalletAddress
@@ -54,6 +56,7 @@ import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.launch
 import java.math.BigInteger
+import java.nio.ByteBuffer
 import java.util.concurrent.atomic.AtomicReference
 
 /**
@@ -97,72 +100,57 @@ class FFIWallet(
         seedWords: FFISeedWords?,
         dnsPeer: String,
         isDnsSecureOn: Boolean,
-        callbackReceivedTx: String,
-        callbackReceivedTxSig: String,
-        callbackReceivedTxReply: String,
-        callbackReceivedTxReplySig: String,
-        callbackReceivedFinalizedTx: String,
-        callbackReceivedFinalizedTxSig: String,
-        callbackTxBroadcast: String,
-        callbackTxBroadcastSig: String,
-        callbackTxMined: String,
-        callbackTxMinedSig: String,
-        callbackTxFauxConfirmed: String,
-        callbackTxFauxConfirmedSig: String,
-        callbackTxFauxUnconfirmed: String,
-        callbackTxFauxUnconfirmedSig: String,
-        callbackTxMinedUnconfirmed: String,
-        callbackTxMinedUnconfirmedSig: String,
-        callbackDirectSendResult: String,
-        callbackDirectSendResultSig: String,
-        callbackTxCancellation: String,
-        callbackTxCancellationSig: String,
-        callbackTXOValidationComplete: String,
-        callbackTXOValidationCompleteSig: String,
-        callbackContactsLivenessDataUpdated: String,
-        callbackContactsLivenessDataUpdatedSig: String,
-        callbackBalanceUpdated: String,
-        callbackBalanceUpdatedSig: String,
-        callbackTransactionValidationComplete: String,
-        callbackTransactionValidationCompleteSig: String,
-        callbackConnectivityStatus: String,
-        callbackConnectivityStatusSig: String,
-        callbackWalletScannedHeight: String,
-        callbackWalletScannedHeightSig: String,
-        callbackBaseNodeStatusStatus: String,
-        callbackBaseNodeStatusSig: String,
-        libError: FFIError
+        u64AsByteArrays: Boolean,
+        eventQueueCapacity: Int,
+        eventQueueOverflowPolicy: Int,
+        eventCoalescingWindowMillis: Int,
+        libError: FFIError?
     )
 
-    private external fun jniGetBalance(libError: FFIError): FFIPointer
+    private external fun jniGetBalance(libError: FFIError?): FFIPointer
+    private external fun jniGetCachedBalance(libError: FFIError?): LongArray
 
-    private external fun jniLogMessage(message: String, libError: FFIError)
+    private external fun jniLogMessage(message: String, libError: FFIError?)
 
-    private external fun jniGetWalletAddress(libError: FFIError): FFIPointer
+    private external fun jniGetWalletAddress(libError: FFIError?): FFIPointer
 
-    private external fun jniGetContacts(libError: FFIError): FFIPointer
+    private external fun jniGetContacts(libError: FFIError?): FFIPointer
 
-    private external fun jniAddUpdateContact(contactPtr: FFIContact, libError: FFIError): Boolean
+    private external fun jniAddUpdateContact(contactPtr: FFIContact, libError: FFIError?): Boolean
 
-    private external fun jniRemoveContact(contactPtr: FFIContact, libError: FFIError): Boolean
+    private external fun jniRemoveContact(contactPtr: FFIContact, libError: FFIError?): Boolean
 
-    private external fun jniGetCompletedTxs(libError: FFIError): FFIPointer
+    private external fun jniFindContact(base58: Base58, entry: FFIContactIndexEntry, libError: FFIError?): Boolean
 
-    private external fun jniGetCancelledTxs(libError: FFIError): FFIPointer
+    private external fun jniRemoveContactByAddress(base58: Base58, libError: FFIError?): Boolean
 
-    private external fun jniGetCompletedTxById(id: String, libError: FFIError): FFIPointer
+    private external fun jniGetCompletedTxs(libError: FFIError?): FFIPointer
 
-    private external fun jniGetCancelledTxById(id: String, libError: FFIError): FFIPointer
+    private external fun jniGetCancelledTxs(libError: FFIError?): FFIPointer
 
-    private external fun jniGetPendingOutboundTxs(libError: FFIError): FFIPointer
+    private external fun jniGetCompletedTxById(id: String, libError: FFIError?): FFIPointer
 
-    private external fun jniGetPendingOutboundTxById(id: String, libError: FFIError): FFIPointer
+    private external fun jniGetCompletedTxByIdU64(id: Long, libError: FFIError?): FFIPointer
 
-    private external fun jniGetPendingInboundTxs(libError: FFIError): FFIPointer
+    private external fun jniGetCancelledTxById(id: String, libError: FFIError?): FFIPointer
 
-    private external fun jniGetPendingInboundTxById(id: String, libError: FFIError): FFIPointer
+    private external fun jniGetCancelledTxByIdU64(id: Long, libError: FFIError?): FFIPointer
 
-    private external fun jniCancelPendingTx(id: String, libError: FFIError): Boolean
+    private external fun jniGetPendingOutboundTxs(libError: FFIError?): FFIPointer
+
+    private external fun jniGetPendingOutboundTxById(id: String, libError: FFIError?): FFIPointer
+
+    private external fun jniGetPendingOutboundTxByIdU64(id: Long, libError: FFIError?): FFIPointer
+
+    private external fun jniGetPendingInboundTxs(libError: FFIError?): FFIPointer
+
+    private external fun jniGetPendingInboundTxById(id: String, libError: FFIError?): FFIPointer
+
+    private external fun jniGetPendingInboundTxByIdU64(id: Long, libError: FFIError?): FFIPointer
+
+    private external fun jniCancelPendingTx(id: String, libError: FFIError?): Boolean
+
+    private external fun jniCancelPendingTxU64(id: Long, libError: FFIError?): Boolean
 
     private external fun jniSendTx(
         publicKeyPtr: FFITariWalletAddress,
@@ -171,74 +159,129 @@ class FFIWallet(
         message: String,
         oneSided: Boolean,
         paymentId: String,
-        libError: FFIError
+        libError: FFIError?
     ): ByteArray
 
-    private external fun jniSignMessage(message: String, libError: FFIError): String
+    private external fun jniSendTxU64(
+        publicKeyPtr: FFITariWalletAddress,
+        amount: Long,
+        feePerGram: Long,
+        message: String,
+        oneSided: Boolean,
+        paymentId: String,
+        libError: FFIError?
+    ): Long
+
+    private external fun jniSignMessage(message: String, libError: FFIError?): String
+
+    private external fun jniVerifyMessageSignature(publicKeyPtr: FFIPublicKey, message: String, signature: String, libError: FFIError?): Boolean
+
+    private external fun jniGetBaseNodePeers(libError: FFIError?): FFIPointer
+
+    private external fun jniAddBaseNodePeer(publicKey: FFIPublicKey, address: String, libError: FFIError?): Boolean
 
-    private external fun jniVerifyMessageSignature(publicKeyPtr: FFIPublicKey, message: String, signature: String, libError: FFIError): Boolean
+    private external fun jniStartTXOValidation(libError: FFIError?): ByteArray
 
-    private external fun jniGetBaseNodePeers(libError: FFIError): FFIPointer
+    private external fun jniStartTXOValidationU64(libError: FFIError?): Long
 
-    private external fun jniAddBaseNodePeer(publicKey: FFIPublicKey, address: String, libError: FFIError): Boolean
+    private external fun jniStartTxValidation(libError: FFIError?): ByteArray
 
-    private external fun jniStartTXOValidation(libError: FFIError): ByteArray
+    private external fun jniStartTxValidationU64(libError: FFIError?): Long
 
-    private external fun jniStartTxValidation(libError: FFIError): ByteArray
+    private external fun jniRestartTxBroadcast(libError: FFIError?): ByteArray
 
-    private external fun jniRestartTxBroadcast(libError: FFIError): ByteArray
+    private external fun jniRestartTxBroadcastU64(libError: FFIError?): Long
 
-    private external fun jniPowerModeNormal(libError: FFIError)
+    private external fun jniPowerModeNormal(libError: FFIError?)
 
-    private external fun jniPowerModeLow(libError: FFIError)
+    private external fun jniPowerModeLow(libError: FFIError?)
 
-    private external fun jniGetSeedWords(libError: FFIError): FFIPointer
+    private external fun jniGetSeedWords(libError: FFIError?): FFIPointer
 
-    private external fun jniSetKeyValue(key: String, value: String, libError: FFIError): Boolean
+    private external fun jniSetKeyValue(key: String, value: String, libError: FFIError?): Boolean
 
-    private external fun jniGetKeyValue(key: String, libError: FFIError): String
+    private external fun jniGetKeyValue(key: String, libError: FFIError?): String
 
-    private external fun jniRemoveKeyValue(key: String, libError: FFIError): Boolean
+    private external fun jniRemoveKeyValue(key: String, libError: FFIError?): Boolean
 
-    private external fun jniGetConfirmations(libError: FFIError): ByteArray
+    private external fun jniGetKeyValues(keys: Array<String>, libError: FFIError?): Array<String?>
 
-    private external fun jniSetConfirmations(number: String, libError: FFIError)
+    private external fun jniSetKeyValues(keys: Array<String>, values: Array<String>, libError: FFIError?)
 
-    private external fun jniEstimateTxFee(amount: String, gramFee: String, kernelCount: String, outputCount: String, libError: FFIError): ByteArray
+    private external fun jniCommitKeyValues(libError: FFIError?)
+
+    private external fun jniGetConfirmations(libError: FFIError?): ByteArray
+
+    private external fun jniGetConfirmationsU64(libError: FFIError?): Long
+
+    private external fun jniSetConfirmations(number: String, libError: FFIError?)
+
+    private external fun jniSetConfirmationsU64(number: Long, libError: FFIError?)
+
+    private external fun jniEstimateTxFee(amount: String, gramFee: String, kernelCount: String, outputCount: String, libError: FFIError?): ByteArray
+
+    private external fun jniEstimateTxFeeU64(amount: Long, gramFee: Long, kernelCount: Long, outputCount: Long, libError: FFIError?): Long
 
     private external fun jniStartRecovery(
         base_node_public_key: FFIPublicKey,
-        callback: String,
-        callback_sig: String,
         recoveryOutputMessage: String,
-        libError: FFIError
+        libError: FFIError?
     ): Boolean
 
-    private external fun jniWalletGetFeePerGramStats(count: Int, libError: FFIError): FFIPointer
+    private external fun jniWalletGetFeePerGramStats(count: Int, libError: FFIError?): FFIPointer
+
+    private external fun jniGetUtxos(page: Int, pageSize: Int, sorting: Int, dustThreshold: Long, libError: FFIError?): FFIPointer
+
+    private external fun jniGetAllUtxos(libError: FFIError?): FFIPointer
+
+    private external fun jniJoinUtxos(commitments: Array<String>, feePerGram: String, libError: FFIError?): FFIPointer
+
+    private external fun jniJoinUtxosU64(commitments: Array<String>, feePerGram: Long, libError: FFIError?): FFIPointer
+
+    private external fun jniSplitUtxos(commitments: Array<String>, splitCount: String, feePerGram: String, libError: FFIError?): FFIPointer
+
+    private external fun jniSplitUtxosU64(commitments: Array<String>, splitCount: Long, feePerGram: Long, libError: FFIError?): FFIPointer
+
+    private external fun jniPreviewJoinUtxos(commitments: Array<String>, feePerGram: String, libError: FFIError?): FFIPointer
+
+    private external fun jniPreviewJoinUtxosU64(commitments: Array<String>, feePerGram: Long, libError: FFIError?): FFIPointer
 
-    private external fun jniGetUtxos(page: Int, pageSize: Int, sorting: Int, dustThreshold: Long, libError: FFIError): FFIPointer
+    private external fun jniPreviewSplitUtxos(commitments: Array<String>, splitCount: String, feePerGram: String, libError: FFIError?): FFIPointer
 
-    private external fun jniGetAllUtxos(libError: FFIError): FFIPointer
+    private external fun jniPreviewSplitUtxosU64(commitments: Array<String>, splitCount: Long, feePerGram: Long, libError: FFIError?): FFIPointer
 
-    private external fun jniJoinUtxos(commitments: Array<String>, feePerGram: String, libError: FFIError): FFIPointer
+    private external fun jniJoinPackedUtxos(commitments: ByteArray, feePerGram: Long, libError: FFIError?): FFIPointer
 
-    private external fun jniSplitUtxos(commitments: Array<String>, splitCount: String, feePerGram: String, libError: FFIError): FFIPointer
+    private external fun jniSplitPackedUtxos(commitments: ByteArray, splitCount: Long, feePerGram: Long, libError: FFIError?): FFIPointer
 
-    private external fun jniPreviewJoinUtxos(commitments: Array<String>, feePerGram: String, libError: FFIError): FFIPointer
+    private external fun jniPreviewJoinPackedUtxos(commitments: ByteArray, feePerGram: Long, libError: FFIError?): FFIPointer
 
-    private external fun jniPreviewSplitUtxos(commitments: Array<String>, splitCount: String, feePerGram: String, libError: FFIError): FFIPointer
+    private external fun jniPreviewSplitPackedUtxos(commitments: ByteArray, splitCount: Long, feePerGram: Long, libError: FFIError?): FFIPointer
 
-    private external fun jniWalletGetUnspentOutputs(libError: FFIError): FFIPointer
+    private external fun jniWalletGetUnspentOutputs(libError: FFIError?): FFIPointer
 
     private external fun jniImportExternalUtxoAsNonRewindable(
         output: FFITariUnblindedOutput,
         sourceAddress: FFITariWalletAddress,
         message: String,
-        libError: FFIError
+        libError: FFIError?
     ): ByteArray
 
     private external fun jniDestroy()
 
+    private external fun jniGetChangesSince(version: Long, libError: FFIError?): ByteBuffer
+
+    private external fun jniGetIndexedTx(txId: Long, libError: FFIError?): LongArray?
+
+    private external fun jniCheckTxIndex(libError: FFIError?): Int
+
+    private external fun jniGetCallbackThreadStats(): LongArray
+
+    private external fun jniGetEventQueueStats(): LongArray
+
+    private external fun jniGetCallbackStats(): LongArray
+
+    private external fun jniGetFeeEstimateCacheStats(): LongArray
 
     var listener: FFIWalletListener? = null
 
@@ -272,23 +315,10 @@ class FFIWallet(
                 seedWords = seedPhraseRepository.getPhrase()?.ffiSeedWords,
                 dnsPeer = networkRepository.currentNetwork.dnsPeer,
                 isDnsSecureOn = isDnsSecureOn,
-                this::onTxReceived.name, "(J)V",
-                this::onTxReplyReceived.name, "(J)V",
-                this::onTxFinalized.name, "(J)V",
-                this::onTxBroadcast.name, "(J)V",
-                this::onTxMined.name, "(J)V",
-                this::onTxMinedUnconfirmed.name, "(J[B)V",
-                this::onTxFauxConfirmed.name, "(J)V",
-                this::onTxFauxUnconfirmed.name, "(J[B)V",
-                this::onDirectSendResult.name, "([BJ)V",
-                this::onTxCancelled.name, "(J[B)V",
-                this::onTXOValidationComplete.name, "([B[B)V",
-                this::onContactLivenessDataUpdated.name, "(J)V",
-                this::onBalanceUpdated.name, "(J)V",
-                this::onTxValidationComplete.name, "([B[B)V",
-                this::onConnectivityStatus.name, "([B)V",
-                this::onWalletScannedHeight.name, "([B)V",
-                this::onBaseNodeStatus.name, "(J)V",
+                u64AsByteArrays = u64AsByteArrays,
+                eventQueueCapacity = walletEventQueueCapacity,
+                eventQueueOverflowPolicy = walletEventQueueOverflowPolicy.value,
+                eventCoalescingWindowMillis = walletEventCoalescingWindowMillis,
                 libError = error,
             )
         } catch (e: Throwable) {
@@ -304,10 +334,23 @@ class FFIWallet(
         BalanceInfo(it.getAvailable(), it.getIncoming(), it.getOutgoing(), it.getTimeLocked())
     }
 
+    /**
+     * The balance as of the last balance update callback, kept natively, so no database read. Until the first update arrives it
+     * is read from the database like [getBalance].
+     */
+    fun getCachedBalance(): BalanceInfo = runWithError { jniGetCachedBalance(it) }.let { values ->
+        BalanceInfo(
+            availableBalance = MicroTari(values[0].toUnsignedBigInteger()),
+            pendingIncomingBalance = MicroTari(values[1].toUnsignedBigInteger()),
+            pendingOutgoingBalance = MicroTari(values[2].toUnsignedBigInteger()),
+            timeLockedBalance = MicroTari(values[3].toUnsignedBigInteger()),
+        )
+    }
+
     fun getUtxos(page: Int, pageSize: Int, sorting: Int): TariVector =
-        TariVector(FFITariVector(runWithError { jniGetUtxos(page, pageSize, sorting, 0, it) }))
+        FFITariVector(runWithError { jniGetUtxos(page, pageSize, sorting, 0, it) }).runWithDestroy { TariVector(it) }
 
-    fun getAllUtxos(): TariVector = TariVector(FFITariVector(runWithError { jniGetAllUtxos(it) }))
+    fun getAllUtxos(): TariVector = FFITariVector(runWithError { jniGetAllUtxos(it) }).runWithDestroy { TariVector(it) }
 
     fun getWalletAddress(): FFITariWalletAddress = runWithError { FFITariWalletAddress(jniGetWalletAddress(it)) }
 
@@ -317,25 +360,105 @@ class FFIWallet(
 
     fun removeContact(contact: FFIContact): Boolean = runWithError { jniRemoveContact(contact, it) }
 
+    /**
+     * Looks the contact up in the native contact index (a hash map keyed by address bytes) instead of walking the contact list.
+     */
+    fun findContact(address: TariWalletAddress): TariContact? {
+        val entry = FFIContactIndexEntry()
+        val found = runWithError { jniFindContact(address.fullBase58, entry, it) }
+        return if (found) TariContact(address, entry.alias, entry.isFavorite) else null
+    }
+
+    fun removeContact(address: TariWalletAddress): Boolean = runWithError { jniRemoveContactByAddress(address.fullBase58, it) }
+
     fun getCompletedTxs(): FFICompletedTxs = runWithError { FFICompletedTxs(jniGetCompletedTxs(it)) }
 
     fun getCancelledTxs(): FFICompletedTxs = runWithError { FFICompletedTxs(jniGetCancelledTxs(it)) }
 
-    fun getCompletedTxById(id: BigInteger): FFICompletedTx = runWithError { FFICompletedTx(jniGetCompletedTxById(id.toString(), it)) }
+    fun getCompletedTxById(id: BigInteger): FFICompletedTx = runWithError {
+        FFICompletedTx(if (u64AsByteArrays) jniGetCompletedTxById(id.toString(), it) else jniGetCompletedTxByIdU64(id.toLong(), it))
+    }
 
-    fun getCancelledTxById(id: BigInteger): FFICompletedTx = runWithError { FFICompletedTx(jniGetCancelledTxById(id.toString(), it)) }
+    fun getCancelledTxById(id: BigInteger): FFICompletedTx = runWithError {
+        FFICompletedTx(if (u64AsByteArrays) jniGetCancelledTxById(id.toString(), it) else jniGetCancelledTxByIdU64(id.toLong(), it))
+    }
 
     fun getPendingOutboundTxs(): FFIPendingOutboundTxs = runWithError { FFIPendingOutboundTxs(jniGetPendingOutboundTxs(it)) }
 
     fun getPendingOutboundTxById(id: BigInteger): FFIPendingOutboundTx =
-        runWithError { FFIPendingOutboundTx(jniGetPendingOutboundTxById(id.toString(), it)) }
+        runWithError {
+            FFIPendingOutboundTx(if (u64AsByteArrays) jniGetPendingOutboundTxById(id.toString(), it) else jniGetPendingOutboundTxByIdU64(id.toLong(), it))
+        }
 
     fun getPendingInboundTxs(): FFIPendingInboundTxs = runWithError { FFIPendingInboundTxs(jniGetPendingInboundTxs(it)) }
 
     fun getPendingInboundTxById(id: BigInteger): FFIPendingInboundTx =
-        runWithError { FFIPendingInboundTx(jniGetPendingInboundTxById(id.toString(), it)) }
+        runWithError {
+            FFIPendingInboundTx(if (u64AsByteArrays) jniGetPendingInboundTxById(id.toString(), it) else jniGetPendingInboundTxByIdU64(id.toLong(), it))
+        }
+
+    /**
+     * Tx state transitions seen by the callbacks after [version], 0 for all the journal still holds. Pass the returned
+     * [TxChanges.latestVersion] on the next call; if [TxChanges.truncated] is set the full tx lists have to be re-read.
+     */
+    fun getChangesSince(version: Long): TxChanges = runWithError { TxChanges(jniGetChangesSince(version, it)) }
+
+    /**
+     * Status, amounts, direction and confirmations of a tx from the native tx index, which is kept current by the tx callbacks,
+     * so no database read once it is built. Null if the wallet has no such tx.
+     */
+    fun getIndexedTx(id: BigInteger): IndexedTx? = runWithError { jniGetIndexedTx(id.toLong(), it) }?.let { IndexedTx(id, it) }
+
+    /**
+     * Compares the tx index with the database and returns the number of txs that differ, 0 if they agree. For tests, run it while
+     * no tx is changing.
+     */
+    fun checkTxIndex(): Int = runWithError { jniCheckTxIndex(it) }
 
-    fun cancelPendingTx(id: BigInteger): Boolean = runWithError { jniCancelPendingTx(id.toString(), it) }
+    fun cancelPendingTx(id: BigInteger): Boolean = runWithError {
+        if (u64AsByteArrays) jniCancelPendingTx(id.toString(), it) else jniCancelPendingTxU64(id.toLong(), it)
+    }
+
+    /**
+     * The on* callbacks below are invoked from native code. Their names and JNI signatures are resolved once in
+     * JNI_OnLoad (see LoadJniIds in jniCommon.cpp), so keep both in sync when changing them.
+     * Callbacks carrying u64 values have a ByteArray and a Long overload, the native side calls the Long one
+     * unless [u64AsByteArrays] was set when the wallet was created.
+     * Unless the event queue is disabled (see [walletEventQueueCapacity]) they are reached through [onEvents] instead.
+     */
+    fun onEvents(buffer: ByteBuffer) {
+        for (event in buffer.readWalletEvents()) {
+            try {
+                onEvent(event)
+            } catch (e: Throwable) {
+                logger.e(e, "Wallet event ${event.type} failed")
+            }
+        }
+    }
+
+    private fun onEvent(event: WalletEvent) {
+        when (event.type) {
+            WalletEventType.TX_RECEIVED -> onTxReceived(event.pointer)
+            WalletEventType.TX_REPLY_RECEIVED -> onTxReplyReceived(event.pointer)
+            WalletEventType.TX_FINALIZED -> onTxFinalized(event.pointer)
+            WalletEventType.TX_BROADCAST -> onTxBroadcast(event.pointer)
+            WalletEventType.TX_MINED -> onTxMined(event.pointer)
+            WalletEventType.TX_MINED_UNCONFIRMED -> onTxMinedUnconfirmed(event.pointer, event.value1)
+            WalletEventType.TX_FAUX_CONFIRMED -> onTxFauxConfirmed(event.pointer)
+            WalletEventType.TX_FAUX_UNCONFIRMED -> onTxFauxUnconfirmed(event.pointer, event.value1)
+            WalletEventType.TX_DIRECT_SEND_RESULT -> onDirectSendResult(event.value1, event.pointer)
+            WalletEventType.TX_CANCELLED -> onTxCancelled(event.pointer, event.value1)
+            WalletEventType.TXO_VALIDATION_COMPLETE -> onTXOValidationComplete(event.value1, event.value2)
+            WalletEventType.TX_VALIDATION_COMPLETE -> onTxValidationComplete(event.value1, event.value2)
+            WalletEventType.CONTACTS_LIVENESS_DATA_UPDATED -> onContactLivenessDataUpdated(event.pointer)
+            WalletEventType.BALANCE_UPDATED -> onBalanceUpdated(event.pointer)
+            WalletEventType.CONNECTIVITY_STATUS -> onConnectivityStatus(event.value1)
+            WalletEventType.WALLET_SCANNED_HEIGHT -> onWalletScannedHeight(event.value1)
+            WalletEventType.BASE_NODE_STATUS -> onBaseNodeStatus(event.pointer)
+            WalletEventType.WALLET_RECOVERY -> onWalletRecovery(event.intArg, event.value1, event.value2)
+            else -> logger.e("Unknown wallet event ${event.type}")
+        }
+    }
 
     fun onTxReceived(pendingInboundTxPtr: FFIPointer) {
         val tx = FFIPendingInboundTx(pendingInboundTxPtr)
@@ -383,8 +506,11 @@ class FFIWallet(
         localScope.launch { listener?.onTxMined(completed) }
     }
 
-    fun onTxMinedUnconfirmed(completedTxPtr: FFIPointer, confirmationCountBytes: ByteArray) {
-        val confirmationCount = BigInteger(1, confirmationCountBytes).toInt()
+    fun onTxMinedUnconfirmed(completedTxPtr: FFIPointer, confirmationCountBytes: ByteArray) =
+        onTxMinedUnconfirmed(completedTxPtr, confirmationCountBytes.toUnsignedBigInteger().toLong())
+
+    fun onTxMinedUnconfirmed(completedTxPtr: FFIPointer, confirmationCountU64: Long) {
+        val confirmationCount = confirmationCountU64.toInt()
         val completed = CompletedTx(completedTxPtr)
         logger.i("Tx mined & unconfirmed ${completed.id} $confirmationCount")
         localScope.launch { listener?.onTxMinedUnconfirmed(completed, confirmationCount) }
@@ -402,21 +528,29 @@ class FFIWallet(
         localScope.launch { listener?.onBaseNodeStateChanged(baseNodeState) }
     }
 
-    fun onTxFauxUnconfirmed(completedTxPtr: FFIPointer, confirmationCountBytes: ByteArray) {
-        val confirmationCount = BigInteger(1, confirmationCountBytes).toInt()
+    fun onTxFauxUnconfirmed(completedTxPtr: FFIPointer, confirmationCountBytes: ByteArray) =
+        onTxFauxUnconfirmed(completedTxPtr, confirmationCountBytes.toUnsignedBigInteger().toLong())
+
+    fun onTxFauxUnconfirmed(completedTxPtr: FFIPointer, confirmationCountU64: Long) {
+        val confirmationCount = confirmationCountU64.toInt()
         val completed = CompletedTx(completedTxPtr)
         logger.i("Tx faux unconfirmed ${completed.id}")
         localScope.launch { listener?.onTxMinedUnconfirmed(completed, confirmationCount) }
     }
 
-    fun onDirectSendResult(bytes: ByteArray, pointer: FFIPointer) {
-        val txId = BigInteger(1, bytes)
+    fun onDirectSendResult(bytes: ByteArray, pointer: FFIPointer) = onDirectSendResult(bytes.toUnsignedBigInteger().toLong(), pointer)
+
+    fun onDirectSendResult(txIdU64: Long, pointer: FFIPointer) {
+        val txId = txIdU64.toUnsignedBigInteger()
         logger.i("Tx direct send result $txId")
         localScope.launch { listener?.onDirectSendResult(txId, FFITransactionSendStatus(pointer).getStatus()) }
     }
 
-    fun onTxCancelled(completedTx: FFIPointer, rejectionReason: ByteArray) {
-        val rejectionReasonInt = BigInteger(1, rejectionReason).toInt()
+    fun onTxCancelled(completedTx: FFIPointer, rejectionReason: ByteArray) =
+        onTxCancelled(completedTx, rejectionReason.toUnsignedBigInteger().toLong())
+
+    fun onTxCancelled(completedTx: FFIPointer, rejectionReasonU64: Long) {
+        val rejectionReasonInt = rejectionReasonU64.toInt()
         val tx = FFICompletedTx(completedTx)
         logger.i("Tx cancelled ${tx.getId()}")
 
@@ -425,14 +559,16 @@ class FFIWallet(
         }
     }
 
-    fun onConnectivityStatus(bytes: ByteArray) {
-        val connectivityStatus = BigInteger(1, bytes)
+    fun onConnectivityStatus(bytes: ByteArray) = onConnectivityStatus(bytes.toUnsignedBigInteger().toLong())
+
+    fun onConnectivityStatus(connectivityStatus: Long) {
         localScope.launch { listener?.onConnectivityStatus(connectivityStatus.toInt()) }
         logger.i("ConnectivityStatus is [$connectivityStatus]")
     }
 
-    fun onWalletScannedHeight(bytes: ByteArray) {
-        val height = BigInteger(1, bytes)
+    fun onWalletScannedHeight(bytes: ByteArray) = onWalletScannedHeight(bytes.toUnsignedBigInteger().toLong())
+
+    fun onWalletScannedHeight(height: Long) {
         localScope.launch { listener?.onWalletScannedHeight(height.toInt()) }
         logger.i("Wallet scanned height is [$height]")
     }
@@ -443,17 +579,23 @@ class FFIWallet(
         localScope.launch { listener?.onBalanceUpdated(balance) }
     }
 
-    fun onTXOValidationComplete(bytes: ByteArray, statusBytes: ByteArray) {
-        val requestId = BigInteger(1, bytes)
-        val statusInteger = BigInteger(1, statusBytes).toInt()
+    fun onTXOValidationComplete(bytes: ByteArray, statusBytes: ByteArray) =
+        onTXOValidationComplete(bytes.toUnsignedBigInteger().toLong(), statusBytes.toUnsignedBigInteger().toLong())
+
+    fun onTXOValidationComplete(requestIdU64: Long, statusU64: Long) {
+        val requestId = requestIdU64.toUnsignedBigInteger()
+        val statusInteger = statusU64.toInt()
         val status = TransactionValidationStatus.entries.firstOrNull { it.value == statusInteger } ?: return
         logger.i("TXO validation [$requestId] complete. Result: $status")
         localScope.launch { listener?.onTXOValidationComplete(requestId, status) }
     }
 
-    fun onTxValidationComplete(requestIdBytes: ByteArray, statusBytes: ByteArray) {
-        val requestId = BigInteger(1, requestIdBytes)
-        val statusInteger = BigInteger(1, statusBytes).toInt()
+    fun onTxValidationComplete(requestIdBytes: ByteArray, statusBytes: ByteArray) =
+        onTxValidationComplete(requestIdBytes.toUnsignedBigInteger().toLong(), statusBytes.toUnsignedBigInteger().toLong())
+
+    fun onTxValidationComplete(requestIdU64: Long, statusU64: Long) {
+        val requestId = requestIdU64.toUnsignedBigInteger()
+        val statusInteger = statusU64.toInt()
         val status = TransactionValidationStatus.entries.firstOrNull { it.value == statusInteger } ?: return
         logger.i("Tx validation [$requestId] complete. Result: $status")
         localScope.launch { listener?.onTxValidationComplete(requestId, status) }
@@ -464,9 +606,13 @@ class FFIWallet(
         logger.i("OnContactLivenessDataUpdated")
     }
 
-    fun estimateTxFee(amount: BigInteger, gramFee: BigInteger, kernelCount: BigInteger, outputCount: BigInteger): BigInteger = runWithError {
-        BigInteger(1, jniEstimateTxFee(amount.toString(), gramFee.toString(), kernelCount.toString(), outputCount.toString(), it))
-    }
+    /**
+     * Estimates are memoised natively until the spendable outputs change, see [getFeeEstimateCacheStats].
+     */
+    fun estimateTxFee(amount: BigInteger, gramFee: BigInteger, kernelCount: BigInteger, outputCount: BigInteger): BigInteger = runWithU64(
+        { jniEstimateTxFee(amount.toString(), gramFee.toString(), kernelCount.toString(), outputCount.toString(), it) },
+        { jniEstimateTxFeeU64(amount.toU64Argument(), gramFee.toU64Argument(), kernelCount.toU64Argument(), outputCount.toU64Argument(), it) },
+    )
 
     fun sendTx(
         destination: FFITariWalletAddress,
@@ -482,34 +628,81 @@ class FFIWallet(
         if (destination == getWalletAddress()) {
             throw FFIException(message = "Tx source and destination are the same.")
         }
-        val bytes = runWithError { jniSendTx(destination, amount.toString(), feePerGram.toString(), message, isOneSided, paymentId, it) }
-        return BigInteger(1, bytes)
+        return runWithU64(
+            { jniSendTx(destination, amount.toString(), feePerGram.toString(), message, isOneSided, paymentId, it) },
+            { jniSendTxU64(destination, amount.toU64Argument(), feePerGram.toU64Argument(), message, isOneSided, paymentId, it) },
+        )
     }
 
+    /**
+     * Commitments go to the library as packed 32 byte records (decoded by [FFIHex.decodeAll]) unless
+     * [u64AsByteArrays] is set or one of them is not plain hex, in which case they are passed as strings.
+     */
     fun joinUtxos(commitments: Array<String>, feePerGram: BigInteger, error: FFIError) {
-        jniJoinUtxos(commitments, feePerGram.toString(), error)
+        val packed = if (u64AsByteArrays) null else FFIHex.decodeAll(commitments, UtxosExport.COMMITMENT_SIZE)
+        when {
+            packed != null -> joinUtxos(packed, feePerGram, error)
+            u64AsByteArrays -> jniJoinUtxos(commitments, feePerGram.toString(), error)
+            else -> jniJoinUtxosU64(commitments, feePerGram.toU64Argument(), error)
+        }
+    }
+
+    fun joinUtxos(commitments: ByteArray, feePerGram: BigInteger, error: FFIError) {
+        jniJoinPackedUtxos(commitments, feePerGram.toU64Argument(), error)
     }
 
     fun splitUtxos(commitments: Array<String>, count: Int, feePerGram: BigInteger, error: FFIError) {
-        jniSplitUtxos(commitments, count.toString(), feePerGram.toString(), error)
+        val packed = if (u64AsByteArrays) null else FFIHex.decodeAll(commitments, UtxosExport.COMMITMENT_SIZE)
+        when {
+            packed != null -> splitUtxos(packed, count, feePerGram, error)
+            u64AsByteArrays -> jniSplitUtxos(commitments, count.toString(), feePerGram.toString(), error)
+            else -> jniSplitUtxosU64(commitments, count.toLong(), feePerGram.toU64Argument(), error)
+        }
     }
 
-    fun joinPreviewUtxos(commitments: Array<String>, feePerGram: BigInteger, error: FFIError): TariCoinPreview =
-        TariCoinPreview(FFITariCoinPreview(jniPreviewJoinUtxos(commitments, feePerGram.toString(), error)))
+    fun splitUtxos(commitments: ByteArray, count: Int, feePerGram: BigInteger, error: FFIError) {
+        jniSplitPackedUtxos(commitments, count.toLong(), feePerGram.toU64Argument(), error)
+    }
 
-    fun splitPreviewUtxos(commitments: Array<String>, count: Int, feePerGram: BigInteger, error: FFIError): TariCoinPreview =
-        TariCoinPreview(FFITariCoinPreview(jniPreviewSplitUtxos(commitments, count.toString(), feePerGram.toString(), error)))
+    fun joinPreviewUtxos(commitments: Array<String>, feePerGram: BigInteger, error: FFIError): TariCoinPreview {
+        val packed = if (u64AsByteArrays) null else FFIHex.decodeAll(commitments, UtxosExport.COMMITMENT_SIZE)
+        return when {
+            packed != null -> joinPreviewUtxos(packed, feePerGram, error)
+            u64AsByteArrays -> TariCoinPreview(FFITariCoinPreview(jniPreviewJoinUtxos(commitments, feePerGram.toString(), error)))
+            else -> TariCoinPreview(FFITariCoinPreview(jniPreviewJoinUtxosU64(commitments, feePerGram.toU64Argument(), error)))
+        }
+    }
+
+    fun joinPreviewUtxos(commitments: ByteArray, feePerGram: BigInteger, error: FFIError): TariCoinPreview =
+        TariCoinPreview(FFITariCoinPreview(jniPreviewJoinPackedUtxos(commitments, feePerGram.toU64Argument(), error)))
+
+    fun splitPreviewUtxos(commitments: Array<String>, count: Int, feePerGram: BigInteger, error: FFIError): TariCoinPreview {
+        val packed = if (u64AsByteArrays) null else FFIHex.decodeAll(commitments, UtxosExport.COMMITMENT_SIZE)
+        return when {
+            packed != null -> splitPreviewUtxos(packed, count, feePerGram, error)
+            u64AsByteArrays -> TariCoinPreview(
+                FFITariCoinPreview(jniPreviewSplitUtxos(commitments, count.toString(), feePerGram.toString(), error))
+            )
+
+            else -> TariCoinPreview(
+                FFITariCoinPreview(jniPreviewSplitUtxosU64(commitments, count.toLong(), feePerGram.toU64Argument(), error))
+            )
+        }
+    }
+
+    fun splitPreviewUtxos(commitments: ByteArray, count: Int, feePerGram: BigInteger, error: FFIError): TariCoinPreview =
+        TariCoinPreview(FFITariCoinPreview(jniPreviewSplitPackedUtxos(commitments, count.toLong(), feePerGram.toU64Argument(), error)))
 
     fun signMessage(message: String): String = runWithError { jniSignMessage(message, it) }
 
     fun verifyMessageSignature(contactPublicKey: FFIPublicKey, message: String, signature: String): Boolean =
         runWithError { jniVerifyMessageSignature(contactPublicKey, message, signature, it) }
 
-    fun startTXOValidation(): BigInteger = runWithError { BigInteger(1, jniStartTXOValidation(it)) }
+    fun startTXOValidation(): BigInteger = runWithU64(::jniStartTXOValidation, ::jniStartTXOValidationU64)
 
-    fun startTxValidation(): BigInteger = runWithError { BigInteger(1, jniStartTxValidation(it)) }
+    fun startTxValidation(): BigInteger = runWithU64(::jniStartTxValidation, ::jniStartTxValidationU64)
 
-    fun restartTxBroadcast(): BigInteger = runWithError { BigInteger(1, jniRestartTxBroadcast(it)) }
+    fun restartTxBroadcast(): BigInteger = runWithU64(::jniRestartTxBroadcast, ::jniRestartTxBroadcastU64)
 
     fun setPowerModeNormal() = runWithError { jniPowerModeNormal(it) }
 
@@ -532,14 +725,37 @@ class FFIWallet(
 
     fun removeKeyValue(key: String): Boolean = runWithError { jniRemoveKeyValue(key, it) }
 
+    /**
+     * Values of the keys in one call, null for the keys that are not set. Values read or written before are served from
+     * memory.
+     */
+    fun getKeyValues(keys: List<String>): Map<String, String?> =
+        keys.zip(runWithError { jniGetKeyValues(keys.toTypedArray(), it) }).toMap()
+
+    /**
+     * Buffers the values natively; reads see them at once, the database gets them a couple of seconds later, on
+     * [commitKeyValues] or when the wallet is destroyed, whichever comes first.
+     */
+    fun setKeyValues(values: Map<String, String>) = runWithError {
+        jniSetKeyValues(values.keys.toTypedArray(), values.values.toTypedArray(), it)
+    }
+
+    /**
+     * Writes the values buffered by [setKeyValues] to the database now. Also fails if a background write failed since
+     * the last commit; values that could not be written stay buffered and are retried.
+     */
+    fun commitKeyValues() = runWithError { jniCommitKeyValues(it) }
+
     fun logMessage(message: String) = runWithError { jniLogMessage(message, it) }
 
-    fun getRequiredConfirmationCount(): BigInteger = runWithError { BigInteger(1, jniGetConfirmations(it)) }
+    fun getRequiredConfirmationCount(): BigInteger = runWithU64(::jniGetConfirmations, ::jniGetConfirmationsU64)
 
-    fun setRequiredConfirmationCount(number: BigInteger) = runWithError { jniSetConfirmations(number.toString(), it) }
+    fun setRequiredConfirmationCount(number: BigInteger) = runWithError {
+        if (u64AsByteArrays) jniSetConfirmations(number.toString(), it) else jniSetConfirmationsU64(number.toU64Argument(), it)
+    }
 
     fun startRecovery(baseNodePublicKey: FFIPublicKey, recoveryOutputMessage: String): Boolean =
-        runWithError { jniStartRecovery(baseNodePublicKey, this::onWalletRecovery.name, "(I[B[B)V", recoveryOutputMessage, it) }
+        runWithError { jniStartRecovery(baseNodePublicKey, recoveryOutputMessage, it) }
 
     fun getFeePerGramStats(): FFIFeePerGramStats = runWithError { FFIFeePerGramStats(jniWalletGetFeePerGramStats(3, it)) }
 
@@ -559,13 +775,34 @@ class FFIWallet(
         }
     }
 
-    fun onWalletRecovery(event: Int, firstArg: ByteArray, secondArg: ByteArray) {
-        val result = WalletRestorationResult.create(event, firstArg, secondArg)
+    fun onWalletRecovery(event: Int, firstArg: ByteArray, secondArg: ByteArray) = onWalletRecovery(
+        event,
+        firstArg.toUnsignedBigInteger().toLong(),
+        secondArg.toUnsignedBigInteger().toLong()
+    )
+
+    fun onWalletRecovery(event: Int, firstArgU64: Long, secondArgU64: Long) {
+        val result = WalletRestorationResult.create(event, firstArgU64, secondArgU64)
         logger.i("Wallet restored with $result")
         localScope.launch { listener?.onWalletRestoration(result) }
     }
 
+    fun getCallbackThreadStats(): CallbackThreadStats = jniGetCallbackThreadStats().let {
+        CallbackThreadStats(elapsedNanos = it[0], callbacks = it[1], attaches = it[2], detaches = it[3])
+    }
+
+    fun getEventQueueStats(): WalletEventQueueStats = WalletEventQueueStats(jniGetEventQueueStats())
+
+    fun getCallbackStats(): List<CallbackLatencyStats> = CallbackLatencyStats.decode(jniGetCallbackStats())
+
+    fun getFeeEstimateCacheStats(): FeeEstimateCacheStats = FeeEstimateCacheStats(jniGetFeeEstimateCacheStats())
+
     override fun destroy() {
+        logger.i("Callback threads: ${getCallbackThreadStats()}")
+        logger.i("Event queue: ${getEventQueueStats()}")
+        getCallbackStats().forEach { logger.i("Callback latency: $it") }
+        logger.i("Emoji id cache: ${FFIEmojiIdCache.getStats()}")
+        logger.i("Fee estimate cache: ${getFeeEstimateCacheStats()}")
         listener = null
         jniDestroy()
     }
@@ -0,0 +1,97 @@
+package com.tari.android.wallet.ffi
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Capacity of the native queue wallet callbacks go through (rounded up to a power of two), read when the wallet is created.
+ * 0 disables the queue: callbacks then call into FFIWallet synchronously on the wallet library's threads.
+ */
+@Volatile
+var walletEventQueueCapacity = 1024
+
+@Volatile
+var walletEventQueueOverflowPolicy = WalletEventOverflowPolicy.BLOCK
+
+/**
+ * Scanned height, balance, base node state and connectivity events are held back natively for up to this long and only the newest
+ * of each type reaches Kotlin, so a recovery or sync does not flood the listeners. Per-transaction events are never held back.
+ * 0 delivers every event; without the event queue nothing is coalesced.
+ */
+@Volatile
+var walletEventCoalescingWindowMillis = 250
+
+/**
+ * What a wallet library thread does when the event queue is full. Values match WalletEventOverflowPolicy in jniWalletEvents.h.
+ */
+enum class WalletEventOverflowPolicy(val value: Int) {
+    BLOCK(0), // wait for the dispatcher, no event is lost
+    DROP_NEWEST(1),
+    DROP_OLDEST(2),
+}
+
+/**
+ * Wallet event types. Values match WalletEventType in jniWalletEvents.h.
+ */
+object WalletEventType {
+    const val TX_RECEIVED = 1
+    const val TX_REPLY_RECEIVED = 2
+    const val TX_FINALIZED = 3
+    const val TX_BROADCAST = 4
+    const val TX_MINED = 5
+    const val TX_MINED_UNCONFIRMED = 6
+    const val TX_FAUX_CONFIRMED = 7
+    const val TX_FAUX_UNCONFIRMED = 8
+    const val TX_DIRECT_SEND_RESULT = 9
+    const val TX_CANCELLED = 10
+    const val TXO_VALIDATION_COMPLETE = 11
+    const val TX_VALIDATION_COMPLETE = 12
+    const val CONTACTS_LIVENESS_DATA_UPDATED = 13
+    const val BALANCE_UPDATED = 14
+    const val CONNECTIVITY_STATUS = 15
+    const val WALLET_SCANNED_HEIGHT = 16
+    const val BASE_NODE_STATUS = 17
+    const val WALLET_RECOVERY = 18
+}
+
+/**
+ * One wallet callback as queued natively. [pointer] is the library object the callback was given, [value1] and [value2] its u64
+ * arguments (as unsigned longs) and [intArg] the recovery event.
+ */
+data class WalletEvent(
+    val type: Int,
+    val intArg: Int,
+    val pointer: FFIPointer,
+    val value1: Long,
+    val value2: Long,
+    val enqueueNanos: Long,
+)
+
+// sizeof(WalletEvent) in jniWalletEvents.h
+const val WALLET_EVENT_RECORD_SIZE = 40
+
+/**
+ * Decodes the records of a batch handed to FFIWallet.onEvents. The buffer wraps native memory that is only valid during the call.
+ */
+fun ByteBuffer.readWalletEvents(): List<WalletEvent> {
+    order(ByteOrder.nativeOrder())
+    val events = ArrayList<WalletEvent>(remaining() / WALLET_EVENT_RECORD_SIZE)
+    while (remaining() >= WALLET_EVENT_RECORD_SIZE) {
+        events.add(WalletEvent(type = int, intArg = int, pointer = long, value1 = long, value2 = long, enqueueNanos = long))
+    }
+    return events
+}
+
+data class WalletEventQueueStats(
+    val capacity: Long,
+    val depth: Long,
+    val maxDepth: Long,
+    val enqueued: Long,
+    val delivered: Long,
+    val dropped: Long,
+    val blockedWaits: Long,
+    val batches: Long,
+    val coalesced: Long,
+) {
+    constructor(stats: LongArray) : this(stats[0], stats[1], stats[2], stats[3], stats[4], stats[5], stats[6], stats[7], stats[8])
+}
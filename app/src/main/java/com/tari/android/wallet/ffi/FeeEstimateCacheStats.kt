@@ -0,0 +1,20 @@
+package com.tari.android.wallet.ffi
+
+/**
+ * Counters of the native fee estimate memo (see jniFeeEstimateCache.h) since the process started. An invalidation
+ * drops all [size] entries, it happens whenever the spendable outputs may have changed.
+ */
+data class FeeEstimateCacheStats(
+    val size: Long,
+    val hits: Long,
+    val misses: Long,
+    val invalidations: Long,
+) {
+    constructor(stats: LongArray) : this(stats[0], stats[1], stats[2], stats[3])
+
+    val hitRate: Double
+        get() = if (hits + misses > 0) hits.toDouble() / (hits + misses) else 0.0
+
+    override fun toString(): String =
+        "$size entries, $hits hits, $misses misses, $invalidations invalidations (hit rate %.1f%%)".format(hitRate * 100)
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.MicroTari
+import com.tari.android.wallet.model.Tx
+import java.math.BigInteger
+
+/**
+ * Compact record of a tx from the native tx index, see jniTxIndex.h. [kind] is the list the tx is in, [status] the library's tx
+ * status (see [FFITxStatus]).
+ */
+data class IndexedTx(
+    val id: BigInteger,
+    val kind: Int,
+    val status: Int,
+    val direction: Tx.Direction,
+    val amount: MicroTari,
+    val fee: MicroTari,
+    val timestamp: BigInteger,
+    val confirmationCount: BigInteger,
+) {
+    /**
+     * From the values returned by FFIWallet.jniGetIndexedTx: {kind, status, outbound, amount, fee, timestamp, confirmations}.
+     */
+    constructor(id: BigInteger, values: LongArray) : this(
+        id = id,
+        kind = values[0].toInt(),
+        status = values[1].toInt(),
+        direction = if (values[2] != 0L) Tx.Direction.OUTBOUND else Tx.Direction.INBOUND,
+        amount = MicroTari(values[3].toUnsignedBigInteger()),
+        fee = MicroTari(values[4].toUnsignedBigInteger()),
+        timestamp = values[5].toUnsignedBigInteger(),
+        confirmationCount = values[6].toUnsignedBigInteger(),
+    )
+
+    val isPending: Boolean
+        get() = kind == KIND_PENDING_INBOUND || kind == KIND_PENDING_OUTBOUND
+
+    val isCancelled: Boolean
+        get() = kind == KIND_CANCELLED
+
+    companion object {
+        // TxIndexKind in jniTxIndex.h
+        const val KIND_COMPLETED = 0
+        const val KIND_CANCELLED = 1
+        const val KIND_PENDING_INBOUND = 2
+        const val KIND_PENDING_OUTBOUND = 3
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import java.math.BigInteger
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * One tx state transition from the native change journal. [eventType] is the [WalletEventType] of the callback, or
+ * [SENT_EVENT] for a tx this wallet sent, [status] the library's tx status after it (see [FFITxStatus]) and [value] the
+ * callback's u64 argument: the confirmation count for the unconfirmed events, the rejection reason for a cancellation,
+ * 0 otherwise.
+ */
+data class TxChange(
+    val version: Long,
+    val txId: BigInteger,
+    val eventType: Int,
+    val status: Int,
+    val value: Long,
+) {
+    companion object {
+        // TxSentJournalEvent in jniTxJournal.h, no callback reports a sent tx
+        const val SENT_EVENT = 0
+    }
+}
+
+/**
+ * Decoder for FFIWallet.jniGetChangesSince, see PackTxChangesSince in jniTxJournal.h for the layout.
+ */
+class TxChanges(buffer: ByteBuffer) {
+
+    val latestVersion: Long
+    val truncated: Boolean
+    val changes: List<TxChange>
+
+    init {
+        val data = buffer.duplicate().order(ByteOrder.nativeOrder())
+        data.position(0)
+        val version = data.int
+        if (version != VERSION) throw FFIException(message = "Unexpected tx changes version: $version")
+        val count = data.int
+        truncated = data.int != 0
+        data.int // reserved
+        latestVersion = data.long
+        changes = List(count) {
+            val changeVersion = data.long
+            val txId = data.long.toUnsignedBigInteger()
+            val value = data.long
+            TxChange(version = changeVersion, txId = txId, eventType = data.int, status = data.int, value = value)
+        }
+    }
+
+    companion object {
+        const val VERSION = 1
+        const val HEADER_SIZE = 24
+        const val RECORD_SIZE = 32
+    }
+}
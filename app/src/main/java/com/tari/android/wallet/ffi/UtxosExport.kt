@@ -0,0 +1,70 @@
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.MicroTari
+import com.tari.android.wallet.model.TariUtxo
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Decoder for the columns written by FFITariVector.jniExportUtxos, see jniTariVector.cpp for the layout.
+ * Commitments come as 32 raw bytes each rather than as hex strings.
+ */
+class UtxosExport(buffer: ByteBuffer) {
+
+    val size: Int
+    val values: LongArray
+    val minedHeights: LongArray
+    val minedTimestamps: LongArray
+    val lockHeights: LongArray
+    val statuses: ByteArray
+    private val commitments: ByteArray
+
+    init {
+        val data = buffer.duplicate().order(ByteOrder.nativeOrder())
+        data.position(0)
+        val version = data.int
+        if (version != VERSION) throw FFIException(message = "Unexpected UTXO export version: $version")
+        size = data.int
+        values = data.readLongColumn(size)
+        minedHeights = data.readLongColumn(size)
+        minedTimestamps = data.readLongColumn(size)
+        lockHeights = data.readLongColumn(size)
+        commitments = ByteArray(size * COMMITMENT_SIZE).also { data.get(it) }
+        statuses = ByteArray(size).also { data.get(it) }
+    }
+
+    fun getCommitment(index: Int): ByteArray = commitments.copyOfRange(index * COMMITMENT_SIZE, (index + 1) * COMMITMENT_SIZE)
+
+    /**
+     * Lowercase hex of the commitment, the form the library used to hand out.
+     */
+    fun getCommitmentHex(index: Int): String {
+        val chars = CharArray(COMMITMENT_SIZE * 2)
+        for (i in 0 until COMMITMENT_SIZE) {
+            val byte = commitments[index * COMMITMENT_SIZE + i].toInt() and 0xFF
+            chars[2 * i] = HEX_DIGITS[byte ushr 4]
+            chars[2 * i + 1] = HEX_DIGITS[byte and 0x0F]
+        }
+        return String(chars)
+    }
+
+    fun toTariUtxos(): List<TariUtxo> = List(size) { index ->
+        TariUtxo(
+            commitment = getCommitmentHex(index),
+            value = MicroTari(values[index].toUnsignedBigInteger()),
+            minedHeight = minedHeights[index],
+            timestamp = minedTimestamps[index],
+            lockHeight = lockHeights[index],
+            status = TariUtxo.UtxoStatus.fromValue(statuses[index].toInt()),
+        )
+    }
+
+    private fun ByteBuffer.readLongColumn(count: Int): LongArray = LongArray(count).also { asLongBuffer().get(it); position(position() + count * 8) }
+
+    companion object {
+        const val VERSION = 1
+        const val HEADER_SIZE = 8
+        const val COMMITMENT_SIZE = 32
+        private const val HEX_DIGITS = "0123456789abcdef"
+    }
+}
@@ -47,7 +47,7 @@ data class TariVector(
     constructor(ffiTariVector: FFITariVector) : this(
         len = ffiTariVector.len,
         cap = ffiTariVector.cap,
-        itemsList = ffiTariVector.itemsList.map { TariUtxo(it) },
+        itemsList = ffiTariVector.utxos,
         longs = ffiTariVector.longs,
     )
 }
\ No newline at end of file
@@ -36,8 +36,10 @@ import android.os.Parcelable
 import com.tari.android.wallet.extension.flag
 import com.tari.android.wallet.ffi.Base58
 import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFIBase58
 import com.tari.android.wallet.ffi.FFIException
 import com.tari.android.wallet.ffi.FFITariWalletAddress
+import com.tari.android.wallet.ffi.FFITariWalletAddressParts
 import com.tari.android.wallet.ffi.runWithDestroy
 import com.tari.android.wallet.util.EmojiId
 import com.tari.android.wallet.util.tariEmoji
@@ -65,17 +67,19 @@ data class TariWalletAddress(
     val unknownAddress: Boolean, // true for one-sided payment or phone contact
 ) : Parcelable {
 
-    constructor(ffiWalletAddress: FFITariWalletAddress) : this(
-        network = Network.get(ffiWalletAddress.getNetwork()),
-        features = Feature.get(ffiWalletAddress.getFeatures()),
-        networkEmoji = ffiWalletAddress.getNetwork().tariEmoji(),
-        featuresEmoji = ffiWalletAddress.getFeatures().tariEmoji(),
-        viewKeyEmojis = ffiWalletAddress.getViewKey()?.getEmojiId(),
-        spendKeyEmojis = ffiWalletAddress.getSpendKey().getEmojiId(),
-        checksumEmoji = ffiWalletAddress.getChecksum().tariEmoji(),
-        fullBase58 = ffiWalletAddress.fullBase58(),
-        fullEmojiId = ffiWalletAddress.getEmojiId(),
-        unknownAddress = ffiWalletAddress.getSpendKey().getByteVector().byteArray().all { it == 0.toByte() },
+    constructor(ffiWalletAddress: FFITariWalletAddress) : this(ffiWalletAddress.decompose())
+
+    private constructor(parts: FFITariWalletAddressParts) : this(
+        network = Network.get(parts.network),
+        features = Feature.get(parts.features),
+        networkEmoji = parts.network.tariEmoji(),
+        featuresEmoji = parts.features.tariEmoji(),
+        viewKeyEmojis = parts.viewKeyEmojis,
+        spendKeyEmojis = parts.spendKeyEmojis,
+        checksumEmoji = parts.checksum.tariEmoji(),
+        fullBase58 = parts.base58,
+        fullEmojiId = parts.emojiId,
+        unknownAddress = parts.spendKeyIsZero,
     )
 
     val uniqueIdentifier: String
@@ -112,7 +116,9 @@ data class TariWalletAddress(
 
         fun makeTariAddressOrNull(input: String): TariWalletAddress? = runCatching { makeTariAddress(input) }.getOrNull()
 
-        fun validateBase58(base58: Base58): Boolean = fromBase58OrNull(base58) != null
+        fun validateBase58(base58: Base58): Boolean = FFIBase58.validateAddresses(arrayOf(base58))[0]
+
+        fun validateBase58(base58: List<Base58>): BooleanArray = FFIBase58.validateAddresses(base58.toTypedArray())
 
         fun validateEmojiId(emojiId: EmojiId): Boolean = fromEmojiIdOrNull(emojiId) != null
     }
@@ -143,8 +149,4 @@ data class TariWalletAddress(
     }
 }
 
-fun FFITariWalletAddress.fullBase58(): Base58 = listOf(
-    Base58String(this.getNetwork().toByte()).base58,
-    Base58String(this.getFeatures().toByte()).base58,
-    Base58String(this.getByteVector().byteArray().drop(2)).base58,
-).joinToString(separator = "")
\ No newline at end of file
+fun FFITariWalletAddress.fullBase58(): Base58 = FFIBase58.encodeAddress(getByteVector().runWithDestroy { it.byteArray() })
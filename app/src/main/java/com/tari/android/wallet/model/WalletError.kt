@@ -39,6 +39,10 @@ data class WalletError(
         val ValuesNotFound = WalletError(424)
         val SeedWordsInvalidDataError = WalletError(429)
         val SeedWordsVersionMismatchError = WalletError(430)
+        val InvalidNumericArgumentError = WalletError(9001) // raised by the JNI bridge, see jniCommon.cpp
+        val OutOfMemoryError = WalletError(9002) // raised by the JNI bridge when a result buffer can't be allocated
+        val UnexpectedLibraryDataError = WalletError(9003) // raised by the JNI bridge for library output it can't convert
+        val InvalidArgumentError = WalletError(9004) // raised by the JNI bridge for arguments it can't pass on, e.g. a range outside its buffer
         val UnknownError = WalletError(-1)
         val NoError = WalletError(0)
     }
@@ -30,16 +30,17 @@ sealed class WalletRestorationResult {
     class RecoveryFailed : WalletRestorationResult()
 
     companion object {
-        fun create(event: Int, firstArg: ByteArray, secondArgs: ByteArray) : WalletRestorationResult {
-            val first = bytesToLong(firstArg)
-            val second = bytesToLong(secondArgs)
+        fun create(event: Int, firstArg: ByteArray, secondArgs: ByteArray): WalletRestorationResult =
+            create(event, bytesToLong(firstArg), bytesToLong(secondArgs))
+
+        fun create(event: Int, first: Long, second: Long) : WalletRestorationResult {
             Logger.t("WalletRestorationResult $event $first $second")
             return when(event) {
                 0 -> ConnectingToBaseNode()
                 1 -> ConnectedToBaseNode()
                 2 -> ConnectionToBaseNodeFailed(first, second)
                 3 -> Progress(first, second)
-                4 -> Completed(first, secondArgs)
+                4 -> Completed(first, ByteBuffer.allocate(java.lang.Long.BYTES).putLong(second).array())
                 5 -> ScanningRoundFailed(first, second)
                 6 -> RecoveryFailed()
                 else -> TODO()
@@ -233,23 +233,7 @@ class FFIWalletListenerImpl(
         }
     }
 
-    private fun getUserByWalletAddress(address: TariWalletAddress): TariContact {
-        val contactsFFI = wallet.getContacts()
-        for (i in 0 until contactsFFI.getLength()) {
-            val contactFFI = contactsFFI.getAt(i)
-            val walletAddressFFI = contactFFI.getWalletAddress()
-            val tariContact = if (TariWalletAddress(walletAddressFFI) == address) TariContact(contactFFI) else null
-            walletAddressFFI.destroy()
-            contactFFI.destroy()
-            if (tariContact != null) {
-                contactsFFI.destroy()
-                return tariContact
-            }
-        }
-        // destroy native collection
-        contactsFFI.destroy()
-        return TariContact(address)
-    }
+    private fun getUserByWalletAddress(address: TariWalletAddress): TariContact = wallet.findContact(address) ?: TariContact(address)
 
     fun postTxNotification(tx: Tx) {
         txReceivedNotificationDelayedAction?.dispose()
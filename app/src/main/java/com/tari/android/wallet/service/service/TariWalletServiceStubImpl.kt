@@ -70,7 +70,7 @@ class TariWalletServiceStubImpl(
 
     override fun getWalletAddressBase58(error: WalletError): String? = runMapping(error) { wallet.getWalletAddress().fullBase58() }
 
-    override fun getBalanceInfo(error: WalletError): BalanceInfo? = runMapping(error) { wallet.getBalance() }
+    override fun getBalanceInfo(error: WalletError): BalanceInfo? = runMapping(error) { wallet.getCachedBalance() }
 
     override fun estimateTxFee(amount: MicroTari, error: WalletError, feePerGram: MicroTari?): MicroTari? = runMapping(error) {
         val defaultKernelCount = BigInteger("1")
@@ -89,7 +89,7 @@ class TariWalletServiceStubImpl(
      * Client-facing function.
      */
     override fun getCompletedTxs(error: WalletError): List<CompletedTx>? = runMapping(error) {
-        wallet.getCompletedTxs().runWithDestroy { txs -> (0 until txs.getLength()).map { CompletedTx(txs.getAt(it)) } }
+        wallet.getCompletedTxs().runWithDestroy { txs -> txs.exportAll().toCompletedTxs() }
     }
 
     /**
@@ -97,7 +97,7 @@ class TariWalletServiceStubImpl(
      * Client-facing function.
      */
     override fun getCancelledTxs(error: WalletError): List<CancelledTx>? = runMapping(error) {
-        wallet.getCancelledTxs().runWithDestroy { txs -> (0 until txs.getLength()).map { CancelledTx(txs.getAt(it)) } }
+        wallet.getCancelledTxs().runWithDestroy { txs -> txs.exportAll().toCancelledTxs() }
     }
 
     /**
@@ -196,23 +196,9 @@ class TariWalletServiceStubImpl(
     }
 
     override fun removeContact(walletAddress: TariWalletAddress, error: WalletError): Boolean = runMapping(error) {
-        val contactsFFI = wallet.getContacts()
-        for (i in 0 until contactsFFI.getLength()) {
-            val contactFFI = contactsFFI.getAt(i)
-            val ffiTariWalletAddress = contactFFI.getWalletAddress()
-            if (TariWalletAddress(ffiTariWalletAddress) == walletAddress) {
-                return@runMapping wallet.removeContact(contactFFI).also {
-                    ffiTariWalletAddress.destroy()
-                    contactFFI.destroy()
-                    contactsFFI.destroy()
-                    _cachedTariContacts = null
-                }
-            }
-            ffiTariWalletAddress.destroy()
-            contactFFI.destroy()
+        wallet.removeContact(walletAddress).also { removed ->
+            if (removed) _cachedTariContacts = null
         }
-        contactsFFI.destroy()
-        false
     } ?: false
 
     override fun updateContact(walletAddress: TariWalletAddress, alias: String, isFavorite: Boolean, error: WalletError): Boolean =
@@ -0,0 +1,27 @@
+package com.tari.android.wallet.ffi
+
+import junit.framework.TestCase
+import org.junit.Assert
+
+class CallbackLatencyStatsTest : TestCase() {
+
+    fun testDecodeSkipsTypesThatNeverFired() {
+        val packed = longArrayOf(
+            1, 3, 9,
+            0, 2, 40_000, 90_000, 90_000, 0, 0, 0, 0,
+            1, 0, 0, 0, 0, 0, 0, 0, 0,
+            2, 5, 1_000, 2_000, 2_500, 5, 300_000, 700_000, 700_000,
+        )
+
+        val stats = CallbackLatencyStats.decode(packed)
+
+        Assert.assertEquals(2, stats.size)
+        Assert.assertEquals(CallbackLatencyStats(CallbackLatencyStats.THREAD_ATTACH, 2, 40_000, 90_000, 90_000, 0, 0, 0, 0), stats[0])
+        Assert.assertEquals(CallbackLatencyStats(WalletEventType.TX_REPLY_RECEIVED, 5, 1_000, 2_000, 2_500, 5, 300_000, 700_000, 700_000), stats[1])
+    }
+
+    fun testUnknownLayoutIsIgnored() {
+        Assert.assertTrue(CallbackLatencyStats.decode(longArrayOf(2, 1, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0)).isEmpty())
+        Assert.assertTrue(CallbackLatencyStats.decode(longArrayOf()).isEmpty())
+    }
+}
@@ -0,0 +1,70 @@
+package com.tari.android.wallet.ffi
+
+import junit.framework.TestCase
+import org.junit.Assert
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+class CompletedTxsExportTest : TestCase() {
+
+    private fun ByteBuffer.align() = apply { position((position() + 7) and 7.inv()) }
+
+    // two txs with the same counterparty, written the way jniExportAll packs them
+    private fun export(): ByteBuffer {
+        val strings = "hi" + "pid" + "ab" + "cd" + "ef" + "" + "p2"
+        val address = byteArrayOf(1, 2, 3)
+        val buffer = ByteBuffer.allocateDirect(512).order(ByteOrder.nativeOrder())
+        buffer.putInt(CompletedTxsExport.VERSION).putInt(2).putInt(1).putInt(strings.length).putInt(address.size)
+        buffer.position(CompletedTxsExport.HEADER_SIZE)
+        listOf(longArrayOf(7, -1), longArrayOf(100, 200), longArrayOf(5, 6), longArrayOf(1_700_000_000, 1_700_000_001), longArrayOf(3, 0))
+            .forEach { column -> column.forEach { buffer.putLong(it) } }
+        listOf(intArrayOf(6, 4), intArrayOf(3, 0), intArrayOf(-1, 1), intArrayOf(0, 0))
+            .forEach { column -> column.forEach { buffer.putInt(it) }; buffer.align() }
+        intArrayOf(0, 2, 2, 3, 5, 2, 7, 2, 9, 2, 11, 0, 11, 2, 0, -1, 0, -1, 0, -1).forEach { buffer.putInt(it) }
+        intArrayOf(0, address.size).forEach { buffer.putInt(it) }
+        buffer.align()
+        strings.forEach { buffer.putChar(it) }
+        buffer.align()
+        buffer.put(address)
+        buffer.flip()
+        return buffer
+    }
+
+    fun testColumnsAreDecoded() {
+        val txs = CompletedTxsExport(export())
+
+        Assert.assertEquals(2, txs.size)
+        Assert.assertArrayEquals(longArrayOf(7, -1), txs.ids)
+        Assert.assertArrayEquals(longArrayOf(100, 200), txs.amounts)
+        Assert.assertArrayEquals(longArrayOf(3, 0), txs.confirmations)
+        Assert.assertArrayEquals(intArrayOf(6, 4), txs.statuses)
+        Assert.assertArrayEquals(intArrayOf(-1, 1), txs.cancellationReasons)
+        Assert.assertTrue(txs.isOutbound(0))
+        Assert.assertFalse(txs.isOutbound(1))
+    }
+
+    fun testStringsAndKernel() {
+        val txs = CompletedTxsExport(export())
+
+        Assert.assertEquals("hi", txs.getMessage(0))
+        Assert.assertEquals("pid", txs.getPaymentId(0))
+        Assert.assertEquals("ab", txs.getKernel(0)?.excess)
+        Assert.assertEquals("ef", txs.getKernel(0)?.signature)
+        Assert.assertEquals("", txs.getMessage(1))
+        Assert.assertEquals("p2", txs.getPaymentId(1))
+        Assert.assertNull(txs.getKernel(1))
+    }
+
+    fun testCounterpartyAddressIsShared() {
+        val txs = CompletedTxsExport(export())
+
+        Assert.assertEquals(1, txs.addressCount)
+        Assert.assertArrayEquals(intArrayOf(0, 0), txs.addressIndices)
+        Assert.assertArrayEquals(byteArrayOf(1, 2, 3), txs.getAddressBytes(0))
+    }
+
+    fun testUnknownVersionIsRejected() {
+        val buffer = ByteBuffer.allocateDirect(CompletedTxsExport.HEADER_SIZE).order(ByteOrder.nativeOrder()).putInt(0, 99)
+        Assert.assertThrows(FFIException::class.java) { CompletedTxsExport(buffer) }
+    }
+}
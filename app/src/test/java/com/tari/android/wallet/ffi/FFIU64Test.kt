@@ -0,0 +1,32 @@
+package com.tari.android.wallet.ffi
+
+import junit.framework.TestCase
+import org.junit.Assert
+import java.math.BigInteger
+import java.nio.ByteBuffer
+
+class FFIU64Test : TestCase() {
+
+    fun testLongToUnsignedBigInteger() {
+        Assert.assertEquals(BigInteger.ZERO, 0L.toUnsignedBigInteger())
+        Assert.assertEquals(BigInteger.valueOf(42), 42L.toUnsignedBigInteger())
+        Assert.assertEquals(BigInteger.valueOf(Long.MAX_VALUE), Long.MAX_VALUE.toUnsignedBigInteger())
+        Assert.assertEquals(BigInteger("9223372036854775808"), Long.MIN_VALUE.toUnsignedBigInteger())
+        Assert.assertEquals(BigInteger("18446744073709551615"), (-1L).toUnsignedBigInteger())
+    }
+
+    fun testLongAndByteArrayTransportsAgree() {
+        listOf(0L, 1L, 255L, 1_000_000L, Long.MAX_VALUE, Long.MIN_VALUE, -2L, -1L).forEach { value ->
+            val bytes = ByteBuffer.allocate(java.lang.Long.BYTES).putLong(value).array()
+            Assert.assertEquals(bytes.toUnsignedBigInteger(), value.toUnsignedBigInteger())
+        }
+    }
+
+    fun testOutOfRangeArgumentsBecomeNegative() {
+        Assert.assertEquals(0L, BigInteger.ZERO.toU64Argument())
+        Assert.assertEquals(Long.MAX_VALUE, BigInteger.valueOf(Long.MAX_VALUE).toU64Argument())
+        Assert.assertEquals(-1L, BigInteger.valueOf(-5).toU64Argument())
+        Assert.assertEquals(-1L, BigInteger("9223372036854775808").toU64Argument())
+        Assert.assertEquals(-1L, BigInteger("18446744073709551615").toU64Argument())
+    }
+}
@@ -0,0 +1,33 @@
+package com.tari.android.wallet.ffi
+
+import junit.framework.TestCase
+import org.junit.Assert
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+class FFIWalletEventsTest : TestCase() {
+
+    private fun ByteBuffer.putEvent(type: Int, intArg: Int, pointer: Long, value1: Long, value2: Long, enqueueNanos: Long) =
+        putInt(type).putInt(intArg).putLong(pointer).putLong(value1).putLong(value2).putLong(enqueueNanos)
+
+    fun testRecordsAreDecodedInOrder() {
+        val buffer = ByteBuffer.allocateDirect(2 * WALLET_EVENT_RECORD_SIZE).order(ByteOrder.nativeOrder())
+        buffer.putEvent(WalletEventType.TX_MINED_UNCONFIRMED, 0, 0x1234L, 3L, 0L, 99L)
+        buffer.putEvent(WalletEventType.WALLET_RECOVERY, 2, 0L, -1L, 7L, 100L)
+        buffer.flip()
+
+        val events = buffer.readWalletEvents()
+
+        Assert.assertEquals(
+            listOf(
+                WalletEvent(WalletEventType.TX_MINED_UNCONFIRMED, 0, 0x1234L, 3L, 0L, 99L),
+                WalletEvent(WalletEventType.WALLET_RECOVERY, 2, 0L, -1L, 7L, 100L),
+            ),
+            events,
+        )
+    }
+
+    fun testEmptyBatch() {
+        Assert.assertTrue(ByteBuffer.allocateDirect(0).readWalletEvents().isEmpty())
+    }
+}
@@ -0,0 +1,32 @@
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.MicroTari
+import com.tari.android.wallet.model.Tx
+import junit.framework.TestCase
+import org.junit.Assert
+import java.math.BigInteger
+
+class IndexedTxTest : TestCase() {
+
+    fun testValuesAreDecoded() {
+        val tx = IndexedTx(BigInteger.TEN, longArrayOf(IndexedTx.KIND_PENDING_OUTBOUND.toLong(), 4, 1, 1_000_000, 25, 1_700_000_000, 0))
+
+        Assert.assertEquals(BigInteger.TEN, tx.id)
+        Assert.assertEquals(4, tx.status)
+        Assert.assertEquals(Tx.Direction.OUTBOUND, tx.direction)
+        Assert.assertEquals(MicroTari(BigInteger.valueOf(1_000_000)), tx.amount)
+        Assert.assertEquals(MicroTari(BigInteger.valueOf(25)), tx.fee)
+        Assert.assertEquals(BigInteger.valueOf(1_700_000_000), tx.timestamp)
+        Assert.assertTrue(tx.isPending)
+        Assert.assertFalse(tx.isCancelled)
+    }
+
+    fun testU64ValuesAreUnsigned() {
+        val tx = IndexedTx(BigInteger.ONE, longArrayOf(IndexedTx.KIND_CANCELLED.toLong(), 7, 0, -1, 0, 0, -1))
+
+        Assert.assertEquals(Tx.Direction.INBOUND, tx.direction)
+        Assert.assertEquals(BigInteger("18446744073709551615"), tx.amount.value)
+        Assert.assertEquals(BigInteger("18446744073709551615"), tx.confirmationCount)
+        Assert.assertTrue(tx.isCancelled)
+    }
+}
@@ -0,0 +1,43 @@
+package com.tari.android.wallet.ffi
+
+import junit.framework.TestCase
+import org.junit.Assert
+import java.math.BigInteger
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+class TxChangesTest : TestCase() {
+
+    // a mined-unconfirmed and a cancellation, written the way PackTxChangesSince packs them
+    private fun changes(truncated: Boolean): ByteBuffer {
+        val buffer = ByteBuffer.allocateDirect(TxChanges.HEADER_SIZE + 2 * TxChanges.RECORD_SIZE).order(ByteOrder.nativeOrder())
+        buffer.putInt(TxChanges.VERSION).putInt(2).putInt(if (truncated) 1 else 0).putInt(0).putLong(12)
+        buffer.putLong(11).putLong(-1).putLong(3).putInt(WalletEventType.TX_MINED_UNCONFIRMED).putInt(6)
+        buffer.putLong(12).putLong(42).putLong(1).putInt(WalletEventType.TX_CANCELLED).putInt(4)
+        buffer.flip()
+        return buffer
+    }
+
+    fun testChangesAreDecodedInOrder() {
+        val changes = TxChanges(changes(truncated = false))
+
+        Assert.assertEquals(12L, changes.latestVersion)
+        Assert.assertFalse(changes.truncated)
+        Assert.assertEquals(
+            listOf(
+                TxChange(version = 11, txId = BigInteger("18446744073709551615"), eventType = WalletEventType.TX_MINED_UNCONFIRMED, status = 6, value = 3),
+                TxChange(version = 12, txId = BigInteger.valueOf(42), eventType = WalletEventType.TX_CANCELLED, status = 4, value = 1),
+            ),
+            changes.changes,
+        )
+    }
+
+    fun testTruncatedFlag() {
+        Assert.assertTrue(TxChanges(changes(truncated = true)).truncated)
+    }
+
+    fun testUnknownVersionIsRejected() {
+        val buffer = ByteBuffer.allocateDirect(TxChanges.HEADER_SIZE).order(ByteOrder.nativeOrder()).putInt(0, 99)
+        Assert.assertThrows(FFIException::class.java) { TxChanges(buffer) }
+    }
+}
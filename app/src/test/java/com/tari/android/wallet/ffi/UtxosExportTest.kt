@@ -0,0 +1,50 @@
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.TariUtxo
+import junit.framework.TestCase
+import org.junit.Assert
+import java.math.BigInteger
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+class UtxosExportTest : TestCase() {
+
+    // two UTXOs written the way jniExportUtxos packs them
+    private fun export(): ByteBuffer {
+        val buffer = ByteBuffer.allocateDirect(UtxosExport.HEADER_SIZE + 2 * (4 * 8 + UtxosExport.COMMITMENT_SIZE + 1))
+            .order(ByteOrder.nativeOrder())
+        buffer.putInt(UtxosExport.VERSION).putInt(2)
+        longArrayOf(1000, -1, 10, 20, 1_700_000_000, 1_700_000_100, 0, 30).forEach { buffer.putLong(it) }
+        buffer.put(ByteArray(UtxosExport.COMMITMENT_SIZE) { it.toByte() })
+        buffer.put(ByteArray(UtxosExport.COMMITMENT_SIZE) { 0xAB.toByte() })
+        buffer.put(0).put(6)
+        buffer.flip()
+        return buffer
+    }
+
+    fun testColumnsAreDecoded() {
+        val utxos = UtxosExport(export())
+
+        Assert.assertEquals(2, utxos.size)
+        Assert.assertArrayEquals(longArrayOf(1000, -1), utxos.values)
+        Assert.assertArrayEquals(longArrayOf(10, 20), utxos.minedHeights)
+        Assert.assertArrayEquals(longArrayOf(0, 30), utxos.lockHeights)
+        Assert.assertArrayEquals(byteArrayOf(0, 6), utxos.statuses)
+        Assert.assertArrayEquals(ByteArray(UtxosExport.COMMITMENT_SIZE) { it.toByte() }, utxos.getCommitment(0))
+    }
+
+    fun testCommitmentHexIsLowercase() {
+        val utxos = UtxosExport(export())
+
+        Assert.assertEquals("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", utxos.getCommitmentHex(0))
+        Assert.assertEquals("ab".repeat(UtxosExport.COMMITMENT_SIZE), utxos.getCommitmentHex(1))
+    }
+
+    fun testModelsAreBuilt() {
+        val utxos = UtxosExport(export()).toTariUtxos()
+
+        Assert.assertEquals(TariUtxo.UtxoStatus.UnspentMinedUnconfirmed, utxos[1].status)
+        Assert.assertEquals(BigInteger.ONE.shiftLeft(64).subtract(BigInteger.ONE), utxos[1].value.value)
+        Assert.assertEquals(1_700_000_100L, utxos[1].timestamp)
+    }
+}